@@ -15,9 +15,14 @@
 namespace Defaults {
   // Preferred ESP-NOW channel when no user selection is stored.
   static constexpr uint8_t DEFAULT_CHANNEL = 1;
+  // Paired timers persisted by DeviceManager (one config log key each)
+  static constexpr uint8_t MAX_PAIRED_DEVICES = 128;
 
   // Display rotation: 0,1,2,3 => 0/90/180/270 degrees
   static constexpr uint8_t OLED_ROTATION = 0;
+  // OLED I2C clock. SSD1306 is rated for 400 kHz; most modules also run 1 MHz (Fast-mode Plus)
+  // with short wires, which cuts full-frame flushes from ~25 ms to ~10 ms.
+  static constexpr uint32_t OLED_I2C_HZ = 400000;
 
   // Hardware Pins (ESP32-C3 Seeed XIAO)
   static constexpr int RELAY_PIN = 2;      // (May be unused on remote, kept for parity)
@@ -71,6 +76,43 @@ namespace Defaults {
   // ESP-NOW command retry policy (0 retries => infinite until ACK/NAK)
   static constexpr unsigned long COMM_RETRY_INTERVAL_MS = 200;
   static constexpr uint8_t COMM_MAX_RETRIES = 0;
+  // Config write-back: flush after this long without a new change, and never later than
+  // MAX_DELAY after the first unflushed one (the window a power cut can lose)
+  static constexpr uint32_t CONFIG_FLUSH_QUIET_MS = 1000;
+  static constexpr uint32_t CONFIG_FLUSH_MAX_DELAY_MS = 5000;
+  // Fleet phase group: clock beacon cadence (keeps crystal drift well under 10 ms)
+  // and the per-timer delay used by the "Stagger Timers" menu action.
+  static constexpr unsigned long PHASE_CLOCK_BEACON_MS = 15000;
+  static constexpr uint32_t PHASE_STAGGER_MS = 500;
+  // Cue lists: minimum lead time so several retries fit before the execution time,
+  // and the retry interval used while a cue is in flight.
+  static constexpr uint32_t CUE_MIN_LEAD_MS = 300;
+  static constexpr unsigned long CUE_RETRY_INTERVAL_MS = 50;
+  // Group broadcast: reply slot width and extra wait (covers unslotted random replies)
+  // before stragglers are retried by unicast.
+  static constexpr uint8_t GROUP_SLOT_MS = 8;
+  static constexpr unsigned long GROUP_REPLY_MARGIN_MS = 150;
+  // Status sweep: reply slot per timer (timer loop ticks every 10 ms) and trailing margin.
+  // Sweep time = count * STATUS_SWEEP_SLOT_MS + STATUS_SWEEP_MARGIN_MS.
+  static constexpr uint8_t STATUS_SWEEP_SLOT_MS = 12;
+  static constexpr unsigned long STATUS_SWEEP_MARGIN_MS = 30;
+  static constexpr unsigned long STATUS_SWEEP_INTERVAL_MS = 1000; // RSSI / dashboard refresh cadence
+  // Desired-state reconciler: quiet time after the last edit before sending, wait for the
+  // reported STATUS before re-sending, and re-sends before the intent is dropped.
+  static constexpr unsigned long RECONCILE_SETTLE_MS = 250;
+  static constexpr unsigned long RECONCILE_RETRY_MS = 1500;
+  static constexpr uint8_t RECONCILE_MAX_ATTEMPTS = 3;
+  // Link attempts per CONFIGURE; they end before RECONCILE_RETRY_MS so the timeout frees the
+  // reconciler in time for its next send
+  static constexpr uint8_t CONFIGURE_MAX_ATTEMPTS = 5;
+  static_assert(CONFIGURE_MAX_ATTEMPTS > 0 && CONFIGURE_MAX_ATTEMPTS * COMM_RETRY_INTERVAL_MS < RECONCILE_RETRY_MS,
+                "a CONFIGURE must time out before the reconciler re-sends");
+
+  // Frame scheduling: draw only when something changed, at most 60 Hz while animating,
+  // and refresh a static screen at 2 Hz to catch changes no revision covers
+  static constexpr unsigned long UI_FRAME_MIN_MS = 16;
+  static constexpr unsigned long UI_TICK_MS = 100;        // tenths-of-a-second counters
+  static constexpr unsigned long UI_IDLE_FRAME_MS = 500;
 
   // UI layout (remote)
   // Timer rows and digits
@@ -79,6 +121,8 @@ namespace Defaults {
   static constexpr int UI_TIMER_ROW_Y_ON  = 24;  // ON row Y
   static constexpr int UI_TIMER_ROW_Y_TIME= 48;  // TIME row Y
   static constexpr int UI_DIGIT_WIDTH     = 11;  // pixel width per digit in text size 2
+  // Timer row digits: 0 = Adafruit GFX text, 1 = page blitter (same pixels), 2 = seven-segment
+  static constexpr uint8_t UI_TIMER_DIGIT_STYLE = 1;
   static constexpr int UI_LABEL_GAP_X     = 10;  // gap after digits before label
   // State indicator position (the bottom '*')
   static constexpr int UI_STATE_CHAR_Y    = 48;  // keep at bottom-left; may overlap TIME label minimally
@@ -101,6 +145,11 @@ namespace Defaults {
   static constexpr bool CHARGER_CHG_ACTIVE_HIGH = true;  // true  => HIGH means charging (set per hardware)
   static constexpr bool CHARGER_PWR_ACTIVE_HIGH = true;  // true  => HIGH means powered
 
+  // Battery sampling: one ADC conversion per interval into BatteryMonitor's filter. The shown
+  // percent is recomputed only after the filtered reading moves by the hysteresis (in ADC counts).
+  static constexpr unsigned long BATTERY_SAMPLE_MS = 250;
+  static constexpr uint16_t BATTERY_HYSTERESIS_ADC = 8;
+
 
   // Version tag (may be overridden later per project release scheme)
   inline const char* VERSION() { return "FogMachineTimer v1.0"; }
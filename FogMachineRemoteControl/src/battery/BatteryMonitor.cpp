@@ -1,35 +1,66 @@
 // BatteryMonitor.cpp
 // Reads battery voltage via ADC and calculates percentage using calibration.
 #include "BatteryMonitor.h"
+#include "Defaults.h"
+#include <algorithm>
+#include <cstring>
 
 BatteryMonitor::BatteryMonitor(uint8_t adcPin, CalibrationManager& calibMgr)
     : pin(adcPin), calibration(calibMgr) {}
 
 void BatteryMonitor::begin() {
     pinMode(pin, INPUT);
+    // Seed the filter so the first frame already has a reading
+    sample();
+    lastSampleMs = millis();
+}
+
+void BatteryMonitor::update() {
+    unsigned long now = millis();
+    if (now - lastSampleMs < Defaults::BATTERY_SAMPLE_MS) return;
+    lastSampleMs = now;
+    sample();
 }
 
 uint16_t BatteryMonitor::readRawAdc() const {
     return analogRead(pin);
 }
 
-uint16_t BatteryMonitor::sampleAveraged() const {
-    // Oversample to reduce instantaneous noise
-    uint32_t acc = 0;
-    for (uint8_t i = 0; i < OVERSAMPLE; ++i) {
-        acc += analogRead(pin);
+void BatteryMonitor::Filter::push(uint16_t s) {
+    if (count == 0) {
+        recent[0] = recent[1] = recent[2] = s;
+        scaled = (uint32_t)s << EWMA_SHIFT;
+        count = 1;
+        return;
     }
-    return (uint16_t)(acc / OVERSAMPLE);
+    recent[0] = recent[1];
+    recent[1] = recent[2];
+    recent[2] = s;
+    uint16_t a = recent[0], b = recent[1], c = recent[2];
+    uint16_t median = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    scaled = scaled - (scaled >> EWMA_SHIFT) + median;
 }
 
-uint8_t BatteryMonitor::getPercent() const {
-    uint16_t raw = sampleAveraged();
-    return calibration.calculatePercent(raw);
+void BatteryMonitor::sample() {
+    rawFilter.push(analogRead(pin));
+    mvFilter.push(analogReadMilliVolts(pin));
+    uint16_t adc = rawFilter.value();
+    // Calibration points are raw ADC counts, so the percent comes from the raw filter
+    uint16_t calib[3];
+    calibration.getCalibrationPoints(calib[0], calib[1], calib[2]);
+    bool calibChanged = memcmp(calib, percentCalib, sizeof(calib)) != 0;
+    bool moved = abs((int)adc - (int)percentAdc) >= Defaults::BATTERY_HYSTERESIS_ADC;
+    if (revision != 0 && !calibChanged && !moved) return;
+    percentAdc = adc;
+    memcpy(percentCalib, calib, sizeof(calib));
+    uint8_t p = calibration.calculatePercent(adc);
+    if (revision == 0 || p != percent) {
+        percent = p;
+        ++revision;
+    }
 }
 
-float BatteryMonitor::getVoltage() {
-    uint16_t raw = sampleAveraged();
-    const float vref = 3.3f;
-    const float divider = 2.0f; // If using 1:1 divider to measure up to ~2x Vref
-    return raw * (vref / 4095.0f) * divider;
+float BatteryMonitor::getVoltage() const {
+    const float divider = 2.0f; // 1:1 divider halves the battery voltage
+    return mvFilter.value() * divider / 1000.0f;
 }
@@ -1,5 +1,7 @@
 // BatteryMonitor.h
 // Reads battery voltage via ADC and calculates percentage using calibration.
+// update() takes one sample every Defaults::BATTERY_SAMPLE_MS into a median-of-3 + EWMA
+// filter; the getters return the cached result, so drawing never waits on the ADC.
 #pragma once
 #include <Arduino.h>
 #include "calibration/CalibrationManager.h"
@@ -8,13 +10,32 @@ class BatteryMonitor {
 public:
     BatteryMonitor(uint8_t adcPin, CalibrationManager& calibMgr);
     void begin();
+    // Call every loop pass; samples only when the interval has passed
+    void update();
+    // Single unfiltered conversion, for the live value on the calibration screen
     uint16_t readRawAdc() const;
-    uint8_t getPercent() const;
-    float getVoltage();
+    uint8_t getPercent() const { return percent; }
+    float getVoltage() const;
+    // Bumped whenever getPercent() changes
+    uint32_t getRevision() const { return revision; }
 private:
+    // Median of the last three samples (drops single spikes), then an EWMA of 1/2^EWMA_SHIFT
+    struct Filter {
+        static constexpr uint8_t EWMA_SHIFT = 3;
+        uint16_t recent[3] = {};
+        uint8_t count = 0;
+        uint32_t scaled = 0; // value << EWMA_SHIFT
+        void push(uint16_t sample);
+        uint16_t value() const { return (uint16_t)(scaled >> EWMA_SHIFT); }
+    };
     uint8_t pin;
     CalibrationManager& calibration;
-    // Oversampling count (simple average of multiple ADC reads)
-    static constexpr uint8_t OVERSAMPLE = 16;
-    uint16_t sampleAveraged() const;
+    Filter rawFilter;
+    Filter mvFilter;    // eFuse-calibrated divider tap voltage
+    unsigned long lastSampleMs = 0;
+    uint8_t percent = 0;
+    uint32_t revision = 0;
+    uint16_t percentAdc = 0;   // filtered ADC the current percent came from
+    uint16_t percentCalib[3] = {};
+    void sample();
 };
@@ -1,7 +1,7 @@
 // CalibrationManager.cpp
 // Handles battery calibration logic and persistence.
 #include "CalibrationManager.h"
-#include <EEPROM.h>
+#include "core/ConfigKeys.h"
 
 CalibrationManager::CalibrationManager() {
     // Defaults tuned for a simple divider targeting ~0-100% mapping on 12-bit ADC
@@ -11,27 +11,26 @@ CalibrationManager::CalibrationManager() {
     calibAdc[2] = 3200;  // ~100%
 }
 
-void CalibrationManager::begin() {
-    loadFromEEPROM();
+void CalibrationManager::begin(ConfigLog::Store& configStore) {
+    store = &configStore;
+    loadFromStore();
 }
 
-void CalibrationManager::loadFromEEPROM() {
+void CalibrationManager::loadFromStore() {
     uint16_t buf[3] = {0,0,0};
-    EEPROM.get(64, buf);
-    // If EEPROM is fresh/zeros, keep defaults.
-    if (buf[0] != 0 || buf[1] != 0 || buf[2] != 0) {
+    // Never calibrated: keep defaults. Its own key, so it can no longer clobber device records.
+    if (store->get(ConfigKey::Calibration, buf) && (buf[0] != 0 || buf[1] != 0 || buf[2] != 0)) {
         calibAdc[0] = buf[0]; calibAdc[1] = buf[1]; calibAdc[2] = buf[2];
     }
 }
 
-void CalibrationManager::saveToEEPROM() {
-    EEPROM.put(64, calibAdc);
-    EEPROM.commit();
+void CalibrationManager::saveToStore() {
+    store->put(ConfigKey::Calibration, calibAdc);
 }
 
 void CalibrationManager::setCalibrationPoints(uint16_t adc0, uint16_t adc50, uint16_t adc100) {
     calibAdc[0] = adc0; calibAdc[1] = adc50; calibAdc[2] = adc100;
-    saveToEEPROM();
+    saveToStore();
 }
 
 void CalibrationManager::getCalibrationPoints(uint16_t& adc0, uint16_t& adc50, uint16_t& adc100) const {
@@ -52,5 +51,5 @@ void CalibrationManager::resetToDefaults() {
     calibAdc[0] = 1900;
     calibAdc[1] = 2600;
     calibAdc[2] = 3200;
-    saveToEEPROM();
+    saveToStore();
 }
@@ -2,17 +2,19 @@
 // Handles battery calibration logic and persistence.
 #pragma once
 #include <Arduino.h>
+#include "ConfigLog.h"
 
 class CalibrationManager {
 public:
     CalibrationManager();
-    void begin();
-    void loadFromEEPROM();
-    void saveToEEPROM();
+    void begin(ConfigLog::Store& configStore);
+    void loadFromStore();
+    void saveToStore();
     void setCalibrationPoints(uint16_t adc0, uint16_t adc50, uint16_t adc100);
     void getCalibrationPoints(uint16_t& adc0, uint16_t& adc50, uint16_t& adc100) const;
     uint8_t calculatePercent(uint16_t adcValue) const;
     void resetToDefaults();
 private:
     uint16_t calibAdc[3]; // 0%, 50%, 100%
+    ConfigLog::Store* store = nullptr;
 };
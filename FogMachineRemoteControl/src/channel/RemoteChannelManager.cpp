@@ -1,9 +1,9 @@
 #include "channel/RemoteChannelManager.h"
-#include <EEPROM.h>
 #include <WiFi.h>
 #include <esp_wifi.h>
 #include <algorithm>
 #include "Defaults.h"
+#include "core/ConfigKeys.h"
 
 #ifndef WIFI_SCAN_RUNNING
 #define WIFI_SCAN_RUNNING (-1)
@@ -14,7 +14,8 @@ namespace {
     constexpr uint8_t kMaxChannel = 13;
 }
 
-void RemoteChannelManager::begin(void (*factoryResetCallback)(), size_t /*eepromSize*/) {
+void RemoteChannelManager::begin(ConfigLog::Store& configStore, void (*factoryResetCallback)()) {
+    store_ = &configStore;
     factoryResetCb_ = factoryResetCallback;
     loadFromStorage();
     if (!storageValid_ || !isChannelSupported(storedChannel_)) {
@@ -122,27 +123,12 @@ void RemoteChannelManager::clearSurvey() {
 }
 
 void RemoteChannelManager::writeStorage() {
-    EEPROM.put(ADDR_MAGIC, MAGIC);
-    EEPROM.put(ADDR_VER, VERSION);
-    EEPROM.put(ADDR_VALUE, storedChannel_);
-    EEPROM.commit();
+    store_->put(ConfigKey::Channel, storedChannel_);
 }
 
 void RemoteChannelManager::loadFromStorage() {
-    storageValid_ = false;
     storedChannel_ = Defaults::DEFAULT_CHANNEL;
-    uint8_t magic = 0;
-    EEPROM.get(ADDR_MAGIC, magic);
-    if (magic != MAGIC) {
-        return;
-    }
-    uint8_t version = 0;
-    EEPROM.get(ADDR_VER, version);
-    if (version != VERSION) {
-        return;
-    }
-    EEPROM.get(ADDR_VALUE, storedChannel_);
-    storageValid_ = true;
+    storageValid_ = store_->get(ConfigKey::Channel, storedChannel_);
 }
 
 void RemoteChannelManager::runFactoryReset() {
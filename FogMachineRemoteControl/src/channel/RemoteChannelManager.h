@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include <vector>
+#include "ConfigLog.h"
 
 // RemoteChannelManager coordinates persisted channel preference, active channel application,
 // and Wi-Fi spectrum surveys used to rank candidate channels for ESP-NOW.
@@ -15,8 +16,8 @@ public:
     enum class SurveyState : uint8_t { Idle, Running, Complete, Failed };
 
     // Begin by validating persisted storage. The provided reset callback is invoked when
-    // stored values fall outside supported ranges so the caller can wipe EEPROM first.
-    void begin(void (*factoryResetCallback)(), size_t eepromSize = 512);
+    // stored values fall outside supported ranges so the caller can wipe the config first.
+    void begin(ConfigLog::Store& configStore, void (*factoryResetCallback)());
 
     uint8_t getStoredChannel() const { return storedChannel_; }
     uint8_t getActiveChannel() const { return activeChannel_; }
@@ -41,14 +42,7 @@ private:
     void loadFromStorage();
     void runFactoryReset();
 
-    // EEPROM layout (placed below DeviceManager block, above RemoteConfig block)
-    static constexpr uint8_t MAGIC = 0xC7;
-    static constexpr uint8_t VERSION = 1;
-    static constexpr int ADDR_BASE   = 360;
-    static constexpr int ADDR_MAGIC  = ADDR_BASE + 0;
-    static constexpr int ADDR_VER    = ADDR_BASE + 1;
-    static constexpr int ADDR_VALUE  = ADDR_BASE + 2;
-
+    ConfigLog::Store* store_ = nullptr;
     uint8_t storedChannel_ = 1;
     uint8_t activeChannel_ = 1;
     bool storageValid_ = false;
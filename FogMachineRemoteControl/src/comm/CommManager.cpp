@@ -1,6 +1,7 @@
 // CommManager.cpp
 // Handles ESP-NOW communication and protocol command processing.
 #include "CommManager.h"
+#include "EspNowRx.h"
 #include <WiFi.h>
 #include <esp_now.h>
 #include <algorithm>
@@ -11,9 +12,19 @@
 #include "Defaults.h"
 #include <esp_wifi_types.h>
 #include "channel/RemoteChannelManager.h"
+#include "PatternProgram.h"
 #include "debug/DebugSerialBridge.h"
 
 namespace {
+// Frames waiting for loop(); a full queue drops the frame and the sender's retry brings it back
+constexpr UBaseType_t RX_QUEUE_DEPTH = 8;
+struct RxFrame {
+    uint8_t mac[6];
+    int8_t rssi;
+    uint8_t len;
+    uint8_t data[ESP_NOW_MAX_DATA_LEN];
+};
+
 const char* cmdToString(ProtocolCmd cmd) {
     switch (cmd) {
         case ProtocolCmd::PAIR: return "PAIR";
@@ -27,6 +38,18 @@ const char* cmdToString(ProtocolCmd cmd) {
         case ProtocolCmd::TOGGLE_STATE: return "TOGGLE_STATE";
         case ProtocolCmd::FACTORY_RESET: return "FACTORY_RESET";
         case ProtocolCmd::SET_CHANNEL: return "SET_CHANNEL";
+        case ProtocolCmd::SYNC_PHASE: return "SYNC_PHASE";
+        case ProtocolCmd::SYNC_CLOCK: return "SYNC_CLOCK";
+        case ProtocolCmd::SET_GROUP: return "SET_GROUP";
+        case ProtocolCmd::GROUP_CMD: return "GROUP_CMD";
+        case ProtocolCmd::GROUP_ACK: return "GROUP_ACK";
+        case ProtocolCmd::STATUS_SWEEP: return "STATUS_SWEEP";
+        case ProtocolCmd::CONFIGURE: return "CONFIGURE";
+        case ProtocolCmd::OUTPUT_CMD: return "OUTPUT_CMD";
+        case ProtocolCmd::OUTPUT_STATUS: return "OUTPUT_STATUS";
+        case ProtocolCmd::PATTERN: return "PATTERN";
+        case ProtocolCmd::CUE: return "CUE";
+        case ProtocolCmd::PULSE: return "PULSE";
         default: return "UNKNOWN";
     }
 }
@@ -101,13 +124,14 @@ CommManager::CommManager(DeviceManager& deviceMgr, RemoteChannelManager& channel
 
 void CommManager::begin() {
     instance = this;
+    if (!rxQueue) rxQueue = xQueueCreate(RX_QUEUE_DEPTH, sizeof(RxFrame));
     WiFi.mode(WIFI_STA);
     WiFi.disconnect();
     if (esp_now_init() != ESP_OK) {
         Serial.println("ESP-NOW init failed");
     }
     channelManager.applyStoredChannel();
-    esp_now_register_recv_cb(CommManager::onDataRecv);
+    ReliableEspNow::registerReceive(&CommManager::onDataRecv);
     reliableLink.begin();
     reliableLink.setReceiveHandler([this](const uint8_t* mac, const uint8_t* payload, size_t len) {
         return handleFrame(mac, payload, len);
@@ -136,7 +160,8 @@ void CommManager::begin() {
 }
 
 void CommManager::loop() {
-    reliableLink.loop();
+    ReliableEspNow::captureRssi(rssiWanted || discovering);
+    processIncoming();
     // Non-blocking COMM LED blink
     if (ledBlinkUntil && millis() > ledBlinkUntil) {
         if (Defaults::COMM_LED_ACTIVE_HIGH) digitalWrite(COMM_OUT_GPIO, LOW); else digitalWrite(COMM_OUT_GPIO, HIGH);
@@ -158,42 +183,24 @@ void CommManager::loop() {
             finishDiscovery();
         }
     }
-}
-
-void CommManager::setRssiSnifferEnabled(bool enable) {
-    if (enable == snifferEnabled) return;
-    snifferEnabled = enable;
-    if (enable) {
-        // Enable promiscuous mode to receive packet RSSI
-        esp_wifi_set_promiscuous(true);
-        esp_wifi_set_promiscuous_rx_cb(&CommManager::wifiSniffer);
-    } else {
-        esp_wifi_set_promiscuous_rx_cb(nullptr);
-        esp_wifi_set_promiscuous(false);
+    if (sweepActive && static_cast<long>(millis() - sweepChunkEndMs) >= 0) {
+        if (sweepNextIndex < deviceManager.getDeviceCount()) sendSweepChunk();
+        else sweepActive = false;
+    }
+    if (groupTxn.active && static_cast<long>(millis() - groupTxn.deadlineMs) >= 0) {
+        finishGroupTxn();
+    }
+    reconcileDesired();
+    const bool cuesPending = static_cast<long>(cueBeaconUntilMs - millis()) > 0;
+    if ((phaseGroupActive || cuesPending) && millis() - lastClockBeaconMs >= Defaults::PHASE_CLOCK_BEACON_MS) {
+        broadcastClockBeacon();
     }
-}
-
-// Static sniffer callback
-void CommManager::wifiSniffer(void* buf, wifi_promiscuous_pkt_type_t type) {
-    if (!instance) return;
-    if (type != WIFI_PKT_MGMT && type != WIFI_PKT_DATA) return;
-    const wifi_promiscuous_pkt_t* pkt = (const wifi_promiscuous_pkt_t*)buf;
-    if (!pkt) return;
-    const int8_t rssi = pkt->rx_ctrl.rssi;
-    const uint8_t* mac = pkt->payload + 10; // addr2 in 802.11 header (source MAC)
-    // Basic sanity: payload len must be large enough to contain header
-    if (pkt->rx_ctrl.sig_len < 16) return;
-    instance->noteRssiFromMac(mac, rssi);
 }
 
 void CommManager::noteRssiFromMac(const uint8_t mac[6], int8_t rssi) {
-    // If MAC matches any paired device, update its rssiRemote
+    // Runs for every received frame: one hash probe and a byte store for paired timers
     int idx = deviceManager.findDeviceByMac(mac);
-    if (idx >= 0) {
-        SlaveDevice dev = deviceManager.getDevice(idx);
-        dev.rssiRemote = rssi;
-        deviceManager.updateStatus(idx, dev);
-    }
+    if (idx >= 0) deviceManager.noteRssi(idx, rssi);
 }
 
 ReliableProtocol::HandlerResult CommManager::handleFrame(const uint8_t* mac, const uint8_t* payload, size_t len) {
@@ -212,6 +219,24 @@ ReliableProtocol::HandlerResult CommManager::handleFrame(const uint8_t* mac, con
         return handleDebugPacket(mac, packet);
     }
 
+    if (len == sizeof(GroupMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::GROUP_ACK)) {
+        GroupMsg ack = {};
+        memcpy(&ack, payload, sizeof(ack));
+        handleGroupAck(mac, ack);
+        return result;
+    }
+
+    if (len == sizeof(OutputMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::OUTPUT_STATUS)) {
+        OutputMsg status = {};
+        memcpy(&status, payload, sizeof(status));
+        Serial.printf("[COMM] OUTPUT_STATUS out=%u/%u on=%u override=%u flags=0x%02X ton=%.1f toff=%.1f elapsed=%.1f status=%s from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      status.output, status.outputCount, status.outputOn, status.overrideActive, status.flags,
+                      status.ton, status.toff, status.elapsed,
+                      statusToString(static_cast<ProtocolStatus>(status.status)),
+                      mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+        return result;
+    }
+
     if (len != sizeof(ProtocolMsg)) {
         Serial.printf("[COMM] Dropping payload len=%u (expected %u)\n",
                       static_cast<unsigned>(len), static_cast<unsigned>(sizeof(ProtocolMsg)));
@@ -226,7 +251,7 @@ ReliableProtocol::HandlerResult CommManager::handleFrame(const uint8_t* mac, con
     Serial.printf("[COMM] RX %s from %02X:%02X:%02X:%02X:%02X:%02X len=%u\n",
                   cmdToString(cmd), mac[0],mac[1],mac[2],mac[3],mac[4],mac[5], static_cast<unsigned>(len));
 
-    int8_t rssi = -70; // TODO: capture real RSSI from metadata or sniffer
+    const int8_t rssi = rxRssi ? rxRssi : -127;
     uint8_t reportedChannel = msg.channel;
     if (reportedChannel < 1 || reportedChannel > 13) {
         reportedChannel = channelManager.getActiveChannel();
@@ -237,30 +262,30 @@ ReliableProtocol::HandlerResult CommManager::handleFrame(const uint8_t* mac, con
     }
 
     if (cmd == ProtocolCmd::STATUS) {
-        if (isDuplicateStatus(mac, msg.ton, msg.toff, msg.outputOverride, millis())) {
+        if (isDuplicateStatus(mac, msg.ton, msg.toff, msg.outputOverride, msg.flags, millis())) {
             return result; // already ack success
         }
     }
 
     int idx = deviceManager.findDeviceByMac(mac);
-    if (idx >= 0) {
-        SlaveDevice dev = deviceManager.getDevice(idx);
-        dev.ton = msg.ton;
-        dev.toff = msg.toff;
-        dev.outputState = msg.outputOverride;
-        dev.elapsed = msg.elapsed;
-        dev.rssiRemote = rssi;
+    if (SlaveLive* live = deviceManager.live(idx)) {
+        live->ton = msg.ton;
+        live->toff = msg.toff;
+        live->outputState = msg.outputOverride;
+        live->elapsed = msg.elapsed;
         int8_t rssiTimer = msg.rssiAtTimer;
         if (rssiTimer > 0) rssiTimer = static_cast<int8_t>(-rssiTimer);
         if (rssiTimer < 0 && rssiTimer > -120) {
-            dev.rssiSlave = rssiTimer;
+            live->rssiSlave = rssiTimer;
         }
-        if (msg.name[0]) {
-            strncpy(dev.name, msg.name, sizeof(dev.name)-1);
-            dev.name[sizeof(dev.name)-1] = '\0';
+        live->lastStatusMs = millis();
+        if (msg.flags & ProtocolFlags::GroupInfo) {
+            live->groupMask = msg.groupMask;
+            live->groupSlot = msg.groupSlot;
         }
-        dev.lastStatusMs = millis();
-        deviceManager.updateStatus(idx, dev);
+        deviceManager.setReportedName(idx, msg.name);
+        deviceManager.reconcileReported(idx);
+        if (cmd == ProtocolCmd::STATUS) notePhaseLock(idx, (msg.flags & ProtocolFlags::PhaseLocked) != 0);
     }
 
     return result;
@@ -373,14 +398,14 @@ void CommManager::pairWithIndex(int idx) {
     }
 }
 
-bool CommManager::isDuplicateStatus(const uint8_t mac[6], float ton, float toff, bool state, unsigned long now) {
+bool CommManager::isDuplicateStatus(const uint8_t mac[6], float ton, float toff, bool state, uint8_t flags, unsigned long now) {
     for (auto &e : lastStatus) {
         if (memcmp(e.mac, mac, 6)==0) {
-            if (e.ton==ton && e.toff==toff && e.state==state && (now - e.ts) < 150) return true;
-            e.ton=ton; e.toff=toff; e.state=state; e.ts=now; return false;
+            if (e.ton==ton && e.toff==toff && e.state==state && e.flags==flags && (now - e.ts) < 150) return true;
+            e.ton=ton; e.toff=toff; e.state=state; e.flags=flags; e.ts=now; return false;
         }
     }
-    LastStatusCache c={}; memcpy(c.mac, mac,6); c.ton=ton; c.toff=toff; c.state=state; c.ts=now; lastStatus.push_back(c); return false;
+    LastStatusCache c={}; memcpy(c.mac, mac,6); c.ton=ton; c.toff=toff; c.state=state; c.flags=flags; c.ts=now; lastStatus.push_back(c); return false;
 }
 
 void CommManager::ensurePeer(const uint8_t mac[6]) {
@@ -395,29 +420,39 @@ void CommManager::ensurePeer(const uint8_t mac[6]) {
 }
 
 void CommManager::setActiveName(const char* newName) {
-    const SlaveDevice* act = deviceManager.getActive(); if (!act) return;
-    ProtocolMsg msg={};
-    msg.cmd = (uint8_t)ProtocolCmd::SET_NAME;
-    strncpy(msg.name, newName, sizeof(msg.name)-1);
-    sendProtocol(act->mac, msg, "SET_NAME", true, cmdContext(ProtocolCmd::SET_NAME));
-    // Update local device name immediately for consistent UI reflection
-    int idx = deviceManager.getActiveIndex();
-    if (idx >= 0) {
-        // Persist rename so it survives remote reboot
-        deviceManager.renameDevice(idx, newName);
-    }
+    renameDeviceByIndex(deviceManager.getActiveIndex(), newName);
 }
 
 void CommManager::setActiveTimer(float tonSec, float toffSec) {
-    const SlaveDevice* act = deviceManager.getActive(); if (!act) return;
-    ProtocolMsg msg={};
-    msg.cmd = (uint8_t)ProtocolCmd::SET_TIMER;
-    msg.ton = tonSec;
-    msg.toff = toffSec;
-    sendProtocol(act->mac, msg, "SET_TIMER", true, cmdContext(ProtocolCmd::SET_TIMER));
-    Serial.printf("[COMM] Queue SET_TIMER %.1f/%.1f for %02X:%02X:%02X:%02X:%02X:%02X\n",
-                  tonSec, toffSec, act->mac[0],act->mac[1],act->mac[2],act->mac[3],act->mac[4],act->mac[5]);
-    requestStatus(*act);
+    programTimerByIndex(deviceManager.getActiveIndex(), tonSec, toffSec);
+}
+
+void CommManager::reconcileDesired() {
+    const unsigned long now = millis();
+    for (int i = 0; i < deviceManager.getDeviceCount(); ++i) {
+        const SlaveDevice& dev = deviceManager.getDevice(i);
+        const ReconcileStep step = deviceManager.nextReconcileStep(i, now);
+        if (step == ReconcileStep::GiveUp) {
+            Serial.printf("[COMM] Reconcile gave up on %02X:%02X:%02X:%02X:%02X:%02X, keeping reported state\n",
+                          dev.mac[0],dev.mac[1],dev.mac[2],dev.mac[3],dev.mac[4],dev.mac[5]);
+        }
+        if (step != ReconcileStep::Send) continue;
+        // Name and timer travel in one CONFIGURE frame: one ACK, one flash commit and
+        // one STATUS on the timer; that STATUS is what clears the intent
+        ConfigureMsg msg = {};
+        msg.cmd = static_cast<uint8_t>(ProtocolCmd::CONFIGURE);
+        if (dev.timerPending) {
+            msg.ops |= ConfigureOps::Timer;
+            msg.ton = dev.desiredTon;
+            msg.toff = dev.desiredToff;
+        }
+        if (dev.namePending) {
+            msg.ops |= ConfigureOps::Name;
+            strncpy(msg.name, dev.desiredName, sizeof(msg.name) - 1);
+        }
+        if (!sendConfigure(dev.mac, msg)) continue;
+        deviceManager.markReconcileSent(i, now);
+    }
 }
 
 void CommManager::sendChannelUpdate(const uint8_t mac[6]) {
@@ -459,6 +494,218 @@ void CommManager::onChannelChanged(uint8_t previousChannel) {
     }
 }
 
+void CommManager::startPhaseGroup(uint32_t staggerMs) {
+    int count = deviceManager.getDeviceCount();
+    if (count == 0) return;
+    // Beacon first so timers know the remote timebase before they lock
+    broadcastClockBeacon();
+    uint32_t epoch = millis();
+    for (int i = 0; i < count; ++i) {
+        sendPhaseSync(deviceManager.getDevice(i).mac, true, epoch, static_cast<uint32_t>(i) * staggerMs);
+    }
+    phaseGroupActive = true;
+    Serial.printf("[COMM] Phase group started: %d timers, stagger %lu ms\n", count, static_cast<unsigned long>(staggerMs));
+}
+
+void CommManager::stopPhaseGroup() {
+    int count = deviceManager.getDeviceCount();
+    for (int i = 0; i < count; ++i) {
+        sendPhaseSync(deviceManager.getDevice(i).mac, false, 0, 0);
+    }
+    phaseGroupActive = false;
+}
+
+void CommManager::broadcastClockBeacon() {
+    static constexpr uint8_t broadcast[6] = {0xFF,0xFF,0xFF,0xFF,0xFF,0xFF};
+    PhaseSyncMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::SYNC_CLOCK);
+    // Single unacknowledged transmit: a retried frame would carry a stale timestamp
+    ReliableProtocol::SendConfig cfg;
+    cfg.requireAck = false;
+    cfg.tag = "SYNC_CLOCK";
+    msg.remoteMs = millis();
+    reliableLink.sendStruct(broadcast, msg, cfg);
+    lastClockBeaconMs = msg.remoteMs;
+}
+
+void CommManager::notePhaseLock(int idx, bool locked) {
+    SlaveLive* live = deviceManager.live(idx);
+    if (!live) return;
+    const bool left = live->phaseLocked && !locked;
+    live->phaseLocked = locked;
+    if (!left || !phaseGroupActive) return;
+    // Timers that never confirmed the lock do not keep the group alive
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    Serial.printf("[COMM] %s left the phase group\n", dev.name);
+    int count = deviceManager.getDeviceCount();
+    for (int i = 0; i < count; ++i) {
+        if (deviceManager.getDevice(i).phaseLocked) return;
+    }
+    phaseGroupActive = false;
+    Serial.println("[COMM] Phase group ended: no timer is still locked");
+}
+
+bool CommManager::sendPhaseSync(const uint8_t mac[6], bool enable, uint32_t epochMs, uint32_t phaseOffsetMs) {
+    PhaseSyncMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::SYNC_PHASE);
+    msg.flags = enable ? PhaseSyncFlags::Enable : 0;
+    msg.epochMs = epochMs;
+    msg.phaseOffsetMs = phaseOffsetMs;
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "SYNC_PHASE";
+    cfg.userContext = cmdContext(ProtocolCmd::SYNC_PHASE);
+    bool queued = reliableLink.sendStruct(mac, msg, cfg);
+    if (!queued) {
+        Serial.printf("[COMM] Failed to queue SYNC_PHASE for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+    }
+    return queued;
+}
+
+void CommManager::removeDeviceByIndex(int idx) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount()) return;
+    // The slot may be handed to the next paired timer; it must not inherit a pending group command
+    const uint8_t storeSlot = deviceManager.getDevice(idx).storeSlot;
+    groupTxn.expected.reset(storeSlot);
+    groupTxn.acked.reset(storeSlot);
+    deviceManager.removeDevice(idx);
+}
+
+bool CommManager::assignGroupByIndex(int idx, uint8_t groupMask) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
+        return false;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    GroupMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::SET_GROUP);
+    msg.groupMask = groupMask;
+    msg.slot = dev.storeSlot; // stable across removals, unique among paired timers
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "SET_GROUP";
+    cfg.userContext = cmdContext(ProtocolCmd::SET_GROUP);
+    // The timer answers with STATUS, which carries the stored mask/slot back to us
+    return reliableLink.sendStruct(dev.mac, msg, cfg);
+}
+
+bool CommManager::sendGroupCommand(uint8_t groupMask, ProtocolCmd op, float tonSec, float toffSec, bool on) {
+    if (groupTxn.active) {
+        finishGroupTxn(); // flush stragglers of the previous command before reusing the slot table
+    }
+    GroupTxn txn;
+    uint8_t maxSlot = 0;
+    int count = deviceManager.getDeviceCount();
+    for (int i = 0; i < count; ++i) {
+        const SlaveDevice& dev = deviceManager.getDevice(i);
+        if (groupMask == 0 || (dev.groupMask & groupMask)) {
+            txn.expected.set(dev.storeSlot);
+            if (dev.groupSlot != 0xFF && dev.groupSlot > maxSlot) maxSlot = dev.groupSlot;
+        }
+    }
+    if (txn.expected.none()) {
+        return false;
+    }
+    txn.msg.cmd = static_cast<uint8_t>(ProtocolCmd::GROUP_CMD);
+    txn.msg.groupMask = groupMask;
+    txn.msg.seq = nextGroupSeq;
+    nextGroupSeq = (nextGroupSeq == 255) ? 1 : static_cast<uint8_t>(nextGroupSeq + 1);
+    txn.msg.op = static_cast<uint8_t>(op);
+    txn.msg.ton = tonSec;
+    txn.msg.toff = toffSec;
+    txn.msg.outputOverride = on ? 1 : 0;
+    txn.msg.slotMs = Defaults::GROUP_SLOT_MS;
+    static constexpr uint8_t broadcast[6] = {0xFF,0xFF,0xFF,0xFF,0xFF,0xFF};
+    ReliableProtocol::SendConfig cfg;
+    cfg.requireAck = false;
+    cfg.tag = "GROUP_CMD";
+    if (!reliableLink.sendStruct(broadcast, txn.msg, cfg)) {
+        return false;
+    }
+    txn.active = true;
+    txn.deadlineMs = millis() + static_cast<unsigned long>(maxSlot + 1) * Defaults::GROUP_SLOT_MS + Defaults::GROUP_REPLY_MARGIN_MS;
+    groupTxn = txn;
+    Serial.printf("[COMM] GROUP_CMD seq=%u op=%s mask=0x%02X members=%d\n",
+                  txn.msg.seq, cmdToString(op), groupMask, static_cast<int>(txn.expected.count()));
+    return true;
+}
+
+void CommManager::handleGroupAck(const uint8_t mac[6], const GroupMsg& ack) {
+    int idx = deviceManager.findDeviceByMac(mac);
+    SlaveLive* live = deviceManager.live(idx);
+    if (!live) return;
+    live->ton = ack.ton;
+    live->toff = ack.toff;
+    live->outputState = ack.outputOverride != 0;
+    live->groupMask = ack.groupMask;
+    live->groupSlot = ack.slot;
+    live->lastStatusMs = millis();
+    const uint8_t storeSlot = deviceManager.getDevice(idx).storeSlot;
+    if (groupTxn.active && ack.seq == groupTxn.msg.seq && groupTxn.expected.test(storeSlot)) {
+        // GROUP_ACK carries no STATUS flags, but a reset or toggle takes the member out of its phase group
+        const ProtocolCmd op = static_cast<ProtocolCmd>(groupTxn.msg.op);
+        if (ack.status == static_cast<uint8_t>(ProtocolStatus::OK) &&
+            (op == ProtocolCmd::RESET_STATE || op == ProtocolCmd::TOGGLE_STATE)) {
+            notePhaseLock(idx, false);
+        }
+        groupTxn.acked.set(storeSlot);
+        if (groupTxn.acked == groupTxn.expected) {
+            finishGroupTxn();
+        }
+    }
+}
+
+void CommManager::finishGroupTxn() {
+    groupTxn.active = false;
+    const SlotBits missing = groupTxn.expected & ~groupTxn.acked;
+    Serial.printf("[COMM] GROUP_CMD seq=%u acked=%d missing=%d\n", groupTxn.msg.seq,
+                  static_cast<int>(groupTxn.acked.count()), static_cast<int>(missing.count()));
+    // Stragglers get the same frame by reliable unicast: the timer de-duplicates on seq,
+    // so a member whose GROUP_ACK was lost does not apply a toggle twice.
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "GROUP-RETRY";
+    cfg.userContext = cmdContext(ProtocolCmd::GROUP_CMD);
+    // A member removed since the broadcast is no longer in the list and gets no retry
+    int count = deviceManager.getDeviceCount();
+    for (int i = 0; i < count; ++i) {
+        const SlaveDevice& dev = deviceManager.getDevice(i);
+        if (missing.test(dev.storeSlot)) reliableLink.sendStruct(dev.mac, groupTxn.msg, cfg);
+    }
+}
+
+void CommManager::startStatusSweep() {
+    if (sweepActive || deviceManager.getDeviceCount() == 0) {
+        return; // the running sweep already covers every paired timer
+    }
+    sweepActive = true;
+    sweepNextIndex = 0;
+    sendSweepChunk();
+}
+
+void CommManager::sendSweepChunk() {
+    int count = deviceManager.getDeviceCount();
+    StatusSweepMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::STATUS_SWEEP);
+    msg.seq = nextSweepSeq;
+    nextSweepSeq = (nextSweepSeq == 255) ? 1 : static_cast<uint8_t>(nextSweepSeq + 1);
+    msg.slotMs = Defaults::STATUS_SWEEP_SLOT_MS;
+    while (sweepNextIndex < count && msg.count < StatusSweepMsg::kMaxEntries) {
+        memcpy(msg.macTail[msg.count], deviceManager.getDevice(sweepNextIndex).mac + 3, 3);
+        ++msg.count;
+        ++sweepNextIndex;
+    }
+    static constexpr uint8_t broadcast[6] = {0xFF,0xFF,0xFF,0xFF,0xFF,0xFF};
+    ReliableProtocol::SendConfig cfg;
+    cfg.requireAck = false;
+    cfg.tag = "STATUS_SWEEP";
+    reliableLink.queuePacket(broadcast, &msg, STATUS_SWEEP_HEADER_BYTES + msg.count * 3u, cfg);
+    sweepChunkEndMs = millis() + static_cast<unsigned long>(msg.count) * Defaults::STATUS_SWEEP_SLOT_MS + Defaults::STATUS_SWEEP_MARGIN_MS;
+}
+
 void CommManager::factoryResetActive() {
     const SlaveDevice* act = deviceManager.getActive(); if (!act) return;
     ProtocolMsg msg={};
@@ -471,34 +718,204 @@ void CommManager::renameDeviceByIndex(int idx, const char* newName) {
     if (idx < 0 || idx >= deviceManager.getDeviceCount() || !newName) {
         return;
     }
-    char trimmed[sizeof(SlaveDevice::name)] = {};
-    strncpy(trimmed, newName, sizeof(trimmed) - 1);
-    deviceManager.renameDevice(idx, trimmed);
-    const SlaveDevice& updated = deviceManager.getDevice(idx);
-    ProtocolMsg msg = {};
-    msg.cmd = static_cast<uint8_t>(ProtocolCmd::SET_NAME);
-    strncpy(msg.name, trimmed, sizeof(msg.name) - 1);
-    msg.name[sizeof(msg.name) - 1] = '\0';
-    sendProtocol(updated.mac, msg, "SET_NAME", true, cmdContext(ProtocolCmd::SET_NAME));
-    requestStatus(updated);
+    deviceManager.setDesiredName(idx, newName);
 }
 
 bool CommManager::programTimerByIndex(int idx, float tonSec, float toffSec) {
     if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
         return false;
     }
+    deviceManager.setDesiredTimer(idx, tonSec, toffSec);
+    return true;
+}
+
+bool CommManager::configureByIndex(int idx, uint8_t ops, const char* newName, float tonSec, float toffSec, uint8_t channel) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount() || ops == 0 || (ops & ~ConfigureOps::All) != 0) {
+        return false;
+    }
+    if ((ops & ConfigureOps::Name) && newName) deviceManager.setDesiredName(idx, newName);
+    if (ops & ConfigureOps::Timer) deviceManager.setDesiredTimer(idx, tonSec, toffSec);
+    if (!(ops & ConfigureOps::Channel)) {
+        return true; // the reconciler folds name + timer into one CONFIGURE
+    }
+    // A channel move cannot wait for the reconciler: send everything now as one frame
     const SlaveDevice& dev = deviceManager.getDevice(idx);
-    ProtocolMsg msg = {};
-    msg.cmd = static_cast<uint8_t>(ProtocolCmd::SET_TIMER);
+    ConfigureMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::CONFIGURE);
+    msg.ops = ConfigureOps::Channel;
+    msg.channel = channel;
+    if (dev.timerPending) {
+        msg.ops |= ConfigureOps::Timer;
+        msg.ton = dev.desiredTon;
+        msg.toff = dev.desiredToff;
+    }
+    if (dev.namePending) {
+        msg.ops |= ConfigureOps::Name;
+        strncpy(msg.name, dev.desiredName, sizeof(msg.name) - 1);
+    }
+    if (!sendConfigure(dev.mac, msg)) return false;
+    if (dev.timerPending || dev.namePending) deviceManager.markReconcileSent(idx, millis());
+    return true;
+}
+
+bool CommManager::sendConfigure(const uint8_t mac[6], const ConfigureMsg& msg) {
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    // Finite, so a silent timer times out, frees the reconciler and counts toward its give-up
+    cfg.maxAttempts = Defaults::CONFIGURE_MAX_ATTEMPTS;
+    cfg.tag = "CONFIGURE";
+    cfg.userContext = cmdContext(ProtocolCmd::CONFIGURE);
+    bool queued = reliableLink.sendStruct(mac, msg, cfg);
+    if (queued) {
+        Serial.printf("[COMM] CONFIGURE ops=0x%02X ton=%.1f toff=%.1f name=%.9s ch=%u for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      msg.ops, msg.ton, msg.toff, msg.name, msg.channel,
+                      mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+    }
+    return queued;
+}
+
+bool CommManager::outputCommandByIndex(int idx, uint8_t output, ProtocolCmd op, float tonSec, float toffSec, bool on) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
+        return false;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    OutputMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::OUTPUT_CMD);
+    msg.output = output;
+    msg.op = static_cast<uint8_t>(op);
     msg.ton = tonSec;
     msg.toff = toffSec;
-    bool queued = sendProtocol(dev.mac, msg, "SET_TIMER-PC", true, cmdContext(ProtocolCmd::SET_TIMER));
+    msg.outputOn = on ? 1 : 0;
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "OUTPUT_CMD";
+    cfg.userContext = cmdContext(ProtocolCmd::OUTPUT_CMD);
+    bool queued = reliableLink.sendStruct(dev.mac, msg, cfg);
     if (queued) {
-        requestStatus(dev);
+        Serial.printf("[COMM] OUTPUT_CMD out=%u op=%s for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      output, cmdToString(op),
+                      dev.mac[0],dev.mac[1],dev.mac[2],dev.mac[3],dev.mac[4],dev.mac[5]);
+    }
+    return queued;
+}
+
+bool CommManager::sendPatternByIndex(int idx, uint8_t output, uint8_t op, const uint8_t* code, size_t len) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount() || len > PatternProgram::MAX_BYTES) {
+        return false;
+    }
+    if (op == PatternOps::Load && !PatternProgram::validate(code, len)) {
+        return false;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    PatternMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::PATTERN);
+    msg.output = output;
+    msg.op = op;
+    if (op == PatternOps::Load) {
+        msg.length = static_cast<uint8_t>(len);
+        memcpy(msg.code, code, len);
+    }
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "PATTERN";
+    cfg.userContext = cmdContext(ProtocolCmd::PATTERN);
+    bool queued = reliableLink.sendStruct(dev.mac, msg, cfg);
+    if (queued) {
+        Serial.printf("[COMM] PATTERN out=%u op=%u len=%u for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      output, op, msg.length,
+                      dev.mac[0],dev.mac[1],dev.mac[2],dev.mac[3],dev.mac[4],dev.mac[5]);
+    }
+    return queued;
+}
+
+bool CommManager::sendPulseTrainByIndex(int idx, uint8_t output, const uint16_t* durUs, uint8_t count) {
+    constexpr uint8_t maxDurations = sizeof(PulseMsg::durUs) / sizeof(uint16_t);
+    if (idx < 0 || idx >= deviceManager.getDeviceCount() || count > maxDurations || (count & 1) || (count && !durUs)) {
+        return false;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    PulseMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::PULSE);
+    msg.output = output;
+    msg.count = count;
+    if (count) memcpy(msg.durUs, durUs, count * sizeof(uint16_t));
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "PULSE";
+    cfg.userContext = cmdContext(ProtocolCmd::PULSE);
+    bool queued = reliableLink.sendStruct(dev.mac, msg, cfg);
+    if (queued) {
+        Serial.printf("[COMM] PULSE out=%u count=%u for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      output, count,
+                      dev.mac[0],dev.mac[1],dev.mac[2],dev.mac[3],dev.mac[4],dev.mac[5]);
+    }
+    return queued;
+}
+
+bool CommManager::scheduleCueByIndex(int idx, uint8_t output, uint8_t action, uint32_t atMs, uint16_t durationMs) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
+        return false;
+    }
+    const uint32_t now = millis();
+    const int32_t leadMs = static_cast<int32_t>(atMs - now);
+    if (leadMs < static_cast<int32_t>(Defaults::CUE_MIN_LEAD_MS)) {
+        Serial.printf("[COMM] CUE rejected: lead %ld ms < %lu ms\n", static_cast<long>(leadMs),
+                      static_cast<unsigned long>(Defaults::CUE_MIN_LEAD_MS));
+        return false;
+    }
+    // A timer that has not heard a beacon recently cannot place the cue; refresh it first
+    if (lastClockBeaconMs == 0 || now - lastClockBeaconMs >= Defaults::PHASE_CLOCK_BEACON_MS) {
+        broadcastClockBeacon();
+    }
+    const uint32_t lastDueMs = atMs + durationMs;
+    if (static_cast<long>(cueBeaconUntilMs - now) <= 0 || static_cast<long>(lastDueMs - cueBeaconUntilMs) > 0) {
+        cueBeaconUntilMs = lastDueMs;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    CueMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::CUE);
+    msg.op = CueOps::Add;
+    msg.output = output;
+    msg.action = action;
+    msg.id = nextCueId++;
+    if (nextCueId == 0) nextCueId = 1; // 0 is never deduplicated by the timer
+    msg.durationMs = durationMs;
+    msg.atMs = atMs;
+    // Fast retries, and none past the deadline: the timer would only refuse them as late
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::CUE_RETRY_INTERVAL_MS;
+    const uint32_t attempts = static_cast<uint32_t>(leadMs) / Defaults::CUE_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = static_cast<uint8_t>(attempts > 255 ? 255 : attempts);
+    cfg.tag = "CUE";
+    cfg.userContext = cmdContext(ProtocolCmd::CUE);
+    bool queued = reliableLink.sendStruct(dev.mac, msg, cfg);
+    if (queued) {
+        Serial.printf("[COMM] CUE id=%u out=%u action=%u in %ld ms for %02X:%02X:%02X:%02X:%02X:%02X\n",
+                      msg.id, output, action, static_cast<long>(leadMs),
+                      dev.mac[0],dev.mac[1],dev.mac[2],dev.mac[3],dev.mac[4],dev.mac[5]);
     }
     return queued;
 }
 
+bool CommManager::clearCuesByIndex(int idx) {
+    if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
+        return false;
+    }
+    const SlaveDevice& dev = deviceManager.getDevice(idx);
+    CueMsg msg = {};
+    msg.cmd = static_cast<uint8_t>(ProtocolCmd::CUE);
+    msg.op = CueOps::Clear;
+    ReliableProtocol::SendConfig cfg;
+    cfg.retryIntervalMs = Defaults::COMM_RETRY_INTERVAL_MS;
+    cfg.maxAttempts = Defaults::COMM_MAX_RETRIES;
+    cfg.tag = "CUE";
+    cfg.userContext = cmdContext(ProtocolCmd::CUE);
+    return reliableLink.sendStruct(dev.mac, msg, cfg);
+}
+
 bool CommManager::setOverrideStateByIndex(int idx, bool on) {
     if (idx < 0 || idx >= deviceManager.getDeviceCount()) {
         return false;
@@ -568,6 +985,9 @@ void CommManager::handleAck(const uint8_t* mac, ReliableProtocol::AckType type,
     if (debugBridge) {
         debugBridge->onCommAck(cmd, type, status);
     }
+    if (mac && cmd == ProtocolCmd::CONFIGURE) {
+        deviceManager.markReconcileEnded(deviceManager.findDeviceByMac(mac));
+    }
 
     switch (type) {
         case ReliableProtocol::AckType::Ack:
@@ -598,10 +1018,24 @@ void CommManager::handleAck(const uint8_t* mac, ReliableProtocol::AckType type,
 }
 
 void CommManager::processIncoming() {
+    RxFrame frame;
+    while (rxQueue && xQueueReceive(rxQueue, &frame, 0) == pdTRUE) {
+        // handleFrame runs inside onReceive, so it sees this frame's RSSI
+        rxRssi = frame.rssi;
+        if (frame.rssi) noteRssiFromMac(frame.mac, frame.rssi);
+        reliableLink.onReceive(frame.mac, frame.data, frame.len);
+    }
+    rxRssi = 0;
     reliableLink.loop();
 }
 
-void CommManager::onDataRecv(const uint8_t* mac, const uint8_t* data, int len) {
-    if (!instance) return;
-    instance->reliableLink.onReceive(mac, data, len);
+void CommManager::onDataRecv(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi) {
+    if (!instance || !instance->rxQueue || !mac || !data || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return;
+    // The handlers update the device list and the menus' state, so they run on the loop task
+    RxFrame frame;
+    memcpy(frame.mac, mac, sizeof(frame.mac));
+    frame.rssi = rssi;
+    frame.len = static_cast<uint8_t>(len);
+    memcpy(frame.data, data, static_cast<size_t>(len));
+    xQueueSend(instance->rxQueue, &frame, 0);
 }
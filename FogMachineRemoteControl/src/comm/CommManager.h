@@ -2,6 +2,8 @@
 // Handles ESP-NOW communication and protocol command processing.
 #pragma once
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include "Defaults.h"
 #include "device/DeviceManager.h"
 #include "Pins.h"
@@ -9,6 +11,7 @@
 #include "ReliableProtocol.h"
 #include "DebugProtocol.h"
 #include "protocol/Protocol.h"
+#include <bitset>
 #include <vector>
 
 class RemoteChannelManager;
@@ -21,8 +24,10 @@ public:
     void loop();
     void sendCommand(const SlaveDevice& dev, uint8_t cmd, const void* payload, size_t payloadSize);
     void broadcastDiscovery();
+    // Runs the handlers of frames received since the last call (loop() does this first)
     void processIncoming();
-    static void onDataRecv(const uint8_t* mac, const uint8_t* data, int len);
+    // Wi-Fi task: only copies the frame into rxQueue, so no handler touches the devices there
+    static void onDataRecv(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi);
     void attachDebugBridge(DebugSerialBridge* bridge) { debugBridge = bridge; }
     bool sendDebugPacket(const uint8_t* mac, const DebugProtocol::Packet& packet, const ReliableProtocol::SendConfig& cfg = ReliableProtocol::SendConfig{});
     const ReliableProtocol::TransportStats& getTransportStats() const { return reliableLink.getStats(); }
@@ -43,29 +48,61 @@ public:
     void resetActive();
     void toggleActive();
     void overrideActive(bool on);
+    // Name/timer edits record desired state; the reconciler in loop() sends only the
+    // latest values (one CONFIGURE frame) once edits settle and stops when the timer reports them back.
     void setActiveName(const char* newName);
     void setActiveTimer(float tonSec, float toffSec);
     void factoryResetActive();
     void onChannelChanged(uint8_t previousChannel);
+    // Fleet phase group: every paired timer locks to a shared epoch, timer i
+    // offset by i*staggerMs (0 = all fire together). Sparse beacons keep clocks aligned.
+    // A timer reset or toggled locally leaves the group and says so in STATUS; the group
+    // ends once every timer that confirmed the lock has left it.
+    void startPhaseGroup(uint32_t staggerMs);
+    void stopPhaseGroup();
+    bool isPhaseGroupActive() const { return phaseGroupActive; }
+    // Group addressing: membership is stored on the timer (reply slot = the device's storeSlot);
+    // a group command is one broadcast, then only non-acking members get a unicast.
+    bool assignGroupByIndex(int idx, uint8_t groupMask);
+    bool sendGroupCommand(uint8_t groupMask, ProtocolCmd op, float tonSec = 0.f, float toffSec = 0.f, bool on = false);
+    bool isGroupCommandPending() const { return groupTxn.active; }
+    // Slotted status sweep: one broadcast poll, paired timer i replies in slot i.
+    // Fleets larger than one frame are swept in consecutive chunks.
+    void startStatusSweep();
+    bool isStatusSweepActive() const { return sweepActive; }
+    // Local RSSI is measured only while a screen shows it (and during discovery, which ranks
+    // by it); on older cores that is the only time the radio is promiscuous.
+    void setRssiWanted(bool on) { rssiWanted = on; }
     // Device management helpers
     const SlaveDevice* getActiveDevice() const { return deviceManager.getActive(); }
     int getPairedCount() const { return deviceManager.getDeviceCount(); }
     const SlaveDevice& getPaired(int i) const { return deviceManager.getDevice(i); }
     void activateDeviceByIndex(int idx) { if (idx>=0 && idx<deviceManager.getDeviceCount()) { deviceManager.setActiveIndex(idx); requestStatus(deviceManager.getDevice(idx)); } }
-    void removeDeviceByIndex(int idx) { deviceManager.removeDevice(idx); }
+    void removeDeviceByIndex(int idx);
     // Pairing helpers
     int findPairedIndexByMac(const uint8_t mac[6]) const { return deviceManager.findDeviceByMac(mac); }
-    void unpairByMac(const uint8_t mac[6]) { int idx = deviceManager.findDeviceByMac(mac); if (idx >= 0) deviceManager.removeDevice(idx); }
+    void unpairByMac(const uint8_t mac[6]) { removeDeviceByIndex(deviceManager.findDeviceByMac(mac)); }
     void renameDeviceByIndex(int idx, const char* newName);
     bool programTimerByIndex(int idx, float tonSec, float toffSec);
+    // One transactional CONFIGURE for any of name/timer/channel (ConfigureOps bits)
+    bool configureByIndex(int idx, uint8_t ops, const char* newName, float tonSec, float toffSec, uint8_t channel);
     bool setOverrideStateByIndex(int idx, bool on);
+    // Multi-output timers: command one relay output (0 = fog relay); the timer answers with OUTPUT_STATUS
+    bool outputCommandByIndex(int idx, uint8_t output, ProtocolCmd op, float tonSec = 0.f, float toffSec = 0.f, bool on = false);
+    // Step program for one output (PatternOps); LOAD carries compiled PatternProgram bytecode
+    bool sendPatternByIndex(int idx, uint8_t output, uint8_t op, const uint8_t* code = nullptr, size_t len = 0);
+    // Timestamped cue (CueActions) executed by the timer at remote millis() atMs;
+    // atMs must be at least CUE_MIN_LEAD_MS ahead so retries land before the deadline
+    bool scheduleCueByIndex(int idx, uint8_t output, uint8_t action, uint32_t atMs, uint16_t durationMs = 0);
+    bool clearCuesByIndex(int idx);
+    // SSR pulse train for one output (PulseMsg durations in us, alternating high/low); count 0 = GPIO
+    bool sendPulseTrainByIndex(int idx, uint8_t output, const uint16_t* durUs, uint8_t count);
     static CommManager* get() { return instance; }
-    // RSSI sniffer control (enable only while on RSSI screen)
-    void setRssiSnifferEnabled(bool enable);
 private:
     DeviceManager& deviceManager;
     RemoteChannelManager& channelManager;
     static CommManager* instance;
+    QueueHandle_t rxQueue = nullptr;
     unsigned long ledBlinkUntil = 0;
     // LED helpers respecting polarity
     inline void commLedOn()  { digitalWrite(COMM_OUT_GPIO, Defaults::COMM_LED_ACTIVE_HIGH ? HIGH : LOW); }
@@ -88,15 +125,46 @@ private:
     void addOrUpdateDiscovered(const uint8_t mac[6], const char* name, int8_t rssi, float ton, float toff, uint8_t channel);
     void finishDiscovery();
     // Status de-dup cache (per MAC tail match)
-    struct LastStatusCache { uint8_t mac[6]; float ton; float toff; bool state; unsigned long ts; };
+    struct LastStatusCache { uint8_t mac[6]; float ton; float toff; bool state; uint8_t flags; unsigned long ts; };
     std::vector<LastStatusCache> lastStatus;
-    bool isDuplicateStatus(const uint8_t mac[6], float ton, float toff, bool state, unsigned long now);
-    // Promiscuous-mode RSSI capture
-    bool snifferEnabled = false;
-    static void wifiSniffer(void* buf, wifi_promiscuous_pkt_type_t type);
+    bool isDuplicateStatus(const uint8_t mac[6], float ton, float toff, bool state, uint8_t flags, unsigned long now);
+    // RSSI of the frame being handled (0 = unknown), set as each queued frame is handled
+    int8_t rxRssi = 0;
+    bool rssiWanted = false;
     void noteRssiFromMac(const uint8_t mac[6], int8_t rssi);
     void sendChannelUpdate(const uint8_t mac[6]);
     void switchDiscoveryChannel(uint8_t channel);
+    // Phase group state
+    bool phaseGroupActive = false;
+    unsigned long lastClockBeaconMs = 0;
+    void broadcastClockBeacon();
+    void notePhaseLock(int idx, bool locked);
+    // Cue lists need the timers' clock offset too; beacon until the last cue is due
+    unsigned long cueBeaconUntilMs = 0;
+    uint16_t nextCueId = 1;
+    bool sendPhaseSync(const uint8_t mac[6], bool enable, uint32_t epochMs, uint32_t phaseOffsetMs);
+    // In-flight group command: bit s of expected/acked = the device with storeSlot s, which
+    // (unlike its list index) does not move when another device is removed
+    using SlotBits = std::bitset<Defaults::MAX_PAIRED_DEVICES>;
+    struct GroupTxn {
+        bool active = false;
+        GroupMsg msg = {};
+        SlotBits expected;
+        SlotBits acked;
+        unsigned long deadlineMs = 0;
+    } groupTxn;
+    uint8_t nextGroupSeq = 1;
+    void handleGroupAck(const uint8_t mac[6], const GroupMsg& ack);
+    void finishGroupTxn();
+    // Desired-state reconciler
+    void reconcileDesired();
+    bool sendConfigure(const uint8_t mac[6], const ConfigureMsg& msg);
+    // Status sweep state
+    bool sweepActive = false;
+    int sweepNextIndex = 0;
+    unsigned long sweepChunkEndMs = 0;
+    uint8_t nextSweepSeq = 1;
+    void sendSweepChunk();
     static constexpr unsigned long DISCOVERY_DWELL_MS = 700;
     friend class DebugSerialBridge;
 };
@@ -0,0 +1,16 @@
+// ConfigKeys.h
+// Keys of the remote's settings in the ConfigLog store (lib/ConfigLog).
+#pragma once
+#include <Arduino.h>
+#include "Defaults.h"
+#include "ConfigLog.h"
+
+namespace ConfigKey {
+    static constexpr uint8_t Channel = 1;       // RemoteChannelManager: uint8_t
+    static constexpr uint8_t Remote = 2;        // RemoteConfig::Values
+    static constexpr uint8_t Calibration = 3;   // CalibrationManager: uint16_t[3]
+    static constexpr uint8_t DeviceList = 4;    // DeviceManager: count, active slot (255 = none)
+    static constexpr uint8_t DeviceBase = 16;   // DeviceManager: SlaveIdentity (mac[6], name[10]) per slot
+
+    static_assert(DeviceBase + Defaults::MAX_PAIRED_DEVICES <= ConfigLog::Store::MAX_KEYS, "device keys exceed ConfigLog::Store::MAX_KEYS");
+}
@@ -0,0 +1,85 @@
+// LegacyEeprom.cpp
+// One-time move of settings from the old 512-byte EEPROM image into the ConfigLog store.
+#include "core/LegacyEeprom.h"
+#include <EEPROM.h>
+#include "core/ConfigKeys.h"
+#include "core/RemoteConfig.h"
+
+namespace {
+    // Old layout: [0] device count [1] active [2] 16-byte device records ... [64] calibration
+    // (overlapping the fourth and fifth device) [360] channel [400] remote settings
+    constexpr size_t EEPROM_BYTES = 512;
+    constexpr int DEVICE_COUNT_ADDR = 0;
+    constexpr int DEVICE_ACTIVE_ADDR = 1;
+    constexpr int DEVICE_RECORDS_ADDR = 2;
+    constexpr int DEVICE_RECORD_BYTES = 16;
+    constexpr int CALIBRATION_ADDR = 64;
+    constexpr int CHANNEL_ADDR = 360;
+    constexpr uint8_t CHANNEL_MAGIC = 0xC7;
+    constexpr int REMOTE_ADDR = 400;
+    constexpr uint8_t REMOTE_MAGIC = 0xA5;
+    constexpr uint16_t ADC_MAX = 4095;
+
+    bool macPlausible(const uint8_t mac[6]) {
+        bool allZero = true;
+        bool allOnes = true;
+        for (uint8_t i = 0; i < 6; ++i) {
+            allZero &= mac[i] == 0x00;
+            allOnes &= mac[i] == 0xFF;
+        }
+        return !allZero && !allOnes && (mac[0] & 0x01) == 0; // unicast only
+    }
+}
+
+bool importLegacyEeprom(ConfigLog::Store& store) {
+    if (!store.ready() || !store.empty()) return false;
+    EEPROM.begin(EEPROM_BYTES);
+    ConfigLog::Batch batch; // everything imported lands in one atomic commit
+    if (EEPROM.read(CHANNEL_ADDR) == CHANNEL_MAGIC && EEPROM.read(CHANNEL_ADDR + 1) == 1) {
+        batch.stage(ConfigKey::Channel, EEPROM.read(CHANNEL_ADDR + 2));
+    }
+    if (EEPROM.read(REMOTE_ADDR) == REMOTE_MAGIC) {
+        RemoteConfig::Values vals;
+        EEPROM.get(REMOTE_ADDR + 2, vals);
+        if (EEPROM.read(REMOTE_ADDR + 1) < 2) {
+            // Version 1 predates the RSSI bar bounds
+            vals.rssiLowDbm = RemoteConfig::Values{}.rssiLowDbm;
+            vals.rssiHighDbm = RemoteConfig::Values{}.rssiHighDbm;
+        }
+        batch.stage(ConfigKey::Remote, vals);
+    }
+    uint16_t calib[3] = {0, 0, 0};
+    EEPROM.get(CALIBRATION_ADDR, calib);
+    if (calib[0] < calib[1] && calib[1] < calib[2] && calib[2] <= ADC_MAX) {
+        batch.stage(ConfigKey::Calibration, calib);
+    }
+    // Records from the fourth device on shared bytes with the calibration block, so only
+    // entries that still look like a unicast MAC come across.
+    const uint8_t count = EEPROM.read(DEVICE_COUNT_ADDR);
+    const uint8_t activeRaw = EEPROM.read(DEVICE_ACTIVE_ADDR);
+    uint8_t list[2] = {0, 255};
+    if (count <= (CHANNEL_ADDR - DEVICE_RECORDS_ADDR) / DEVICE_RECORD_BYTES) {
+        for (uint8_t i = 0; i < count && list[0] < Defaults::MAX_PAIRED_DEVICES; ++i) {
+            uint8_t record[DEVICE_RECORD_BYTES];
+            EEPROM.get(DEVICE_RECORDS_ADDR + i * DEVICE_RECORD_BYTES, record);
+            if (!macPlausible(record)) continue;
+            record[DEVICE_RECORD_BYTES - 1] = '\0';
+            if (i == activeRaw) list[1] = list[0];
+            batch.stage(ConfigKey::DeviceBase + list[0], record);
+            list[0]++;
+        }
+    }
+    if (list[0] > 0) batch.stage(ConfigKey::DeviceList, list);
+    const bool imported = !batch.empty() && store.commit(batch);
+    if (imported) {
+        EEPROM.write(DEVICE_COUNT_ADDR, 0);
+        EEPROM.write(DEVICE_ACTIVE_ADDR, 255);
+        const uint16_t cleared[3] = {0, 0, 0};
+        EEPROM.put(CALIBRATION_ADDR, cleared);
+        EEPROM.write(CHANNEL_ADDR, 0);
+        EEPROM.write(REMOTE_ADDR, 0);
+        EEPROM.commit();
+    }
+    EEPROM.end();
+    return imported;
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
-#include <EEPROM.h>
+#include "ConfigLog.h"
+#include "core/ConfigKeys.h"
 
 class RemoteConfig {
 public:
@@ -12,32 +13,23 @@ public:
         int8_t rssiHighDbm = -80;  // dBm value that maps to 6 bars (default changed from -40)
     };
 
-    bool begin(size_t eepromSize = 512) {
-        EEPROM.begin(eepromSize);
+    bool begin(ConfigLog::Store& configStore) {
+        store = &configStore;
         load();
         return true;
     }
 
     void load() {
-        uint8_t magic=0; EEPROM.get(ADDR_MAGIC, magic);
-        if (magic != MAGIC) {
+        if (!store->get(ConfigKey::Remote, vals)) {
             // write defaults
             vals = Values{};
             save();
             return;
         }
-        uint8_t version=0; EEPROM.get(ADDR_VERSION, version);
-        EEPROM.get(ADDR_VALUES, vals);
         // basic sanity
         if (vals.txPowerQdbm < -4) vals.txPowerQdbm = -4;
         if (vals.txPowerQdbm > 84) vals.txPowerQdbm = 84;
         if (vals.blankingSeconds > 3600) vals.blankingSeconds = 3600; // cap to 1h
-        // Migrate defaults for new fields if older version
-        if (version < 2) {
-            vals.rssiLowDbm = -100;
-            vals.rssiHighDbm = -80;
-            save();
-        }
         // Clamp RSSI bounds
     if (vals.rssiHighDbm > 0) vals.rssiHighDbm = 0;
     if (vals.rssiLowDbm < -120) vals.rssiLowDbm = -120;
@@ -45,10 +37,7 @@ public:
     }
 
     void save() {
-        uint8_t magic = MAGIC; EEPROM.put(ADDR_MAGIC, magic);
-        uint8_t version = VERSION; EEPROM.put(ADDR_VERSION, version);
-        EEPROM.put(ADDR_VALUES, vals);
-        EEPROM.commit();
+        store->put(ConfigKey::Remote, vals);
     }
 
     int8_t getTxPowerQdbm() const { return vals.txPowerQdbm; }
@@ -63,12 +52,8 @@ public:
     void setRssiHighDbm(int8_t v) { vals.rssiHighDbm = v; }
 
 private:
-    static constexpr uint8_t MAGIC = 0xA5;
-    static constexpr uint8_t VERSION = 2;
-    // Place near the end of 512B EEPROM to avoid colliding with DeviceManager records
-    static constexpr int ADDR_BASE   = 400;
-    static constexpr int ADDR_MAGIC  = ADDR_BASE + 0;
-    static constexpr int ADDR_VERSION= ADDR_BASE + 1;
-    static constexpr int ADDR_VALUES = ADDR_BASE + 2;
+    // One config log key holds the whole struct; the legacy EEPROM version 1 migration
+    // lives in core/LegacyEeprom.cpp
+    ConfigLog::Store* store = nullptr;
     Values vals;
 };
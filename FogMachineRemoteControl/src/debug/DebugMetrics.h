@@ -12,6 +12,7 @@ public:
         if (flushMs > maxFlush) maxFlush = flushMs;
     }
     void recordSlowFlush() { slowFlushes++; }
+    void recordFlushBytes(uint32_t bytes) { sumFlushBytes += bytes; }
 
     // Accessors for aggregation
     uint32_t getFrameCount() const { return frameCount; }
@@ -19,9 +20,10 @@ public:
     uint32_t getAvgFlush() const { return frameCount ? sumFlush / frameCount : 0; }
     uint32_t getAvgTotal() const { return frameCount ? sumTotal / frameCount : 0; }
     uint32_t getMaxFlush() const { return maxFlush; }
+    uint32_t getAvgFlushBytes() const { return frameCount ? sumFlushBytes / frameCount : 0; }
     uint32_t getSlowFlushes() const { return slowFlushes; }
 
-    void resetDisplay() { frameCount=0; sumPrep=0; sumFlush=0; sumTotal=0; maxFlush=0; slowFlushes=0; }
+    void resetDisplay() { frameCount=0; sumPrep=0; sumFlush=0; sumTotal=0; maxFlush=0; slowFlushes=0; sumFlushBytes=0; }
 
     // Progress bar tracking (menu entry hold)
     void recordProgress(float pct) { progressFrames++; lastProgressPct = pct; }
@@ -37,6 +39,7 @@ private:
     uint32_t sumTotal = 0;
     uint32_t maxFlush = 0;
     uint32_t slowFlushes = 0;
+    uint32_t sumFlushBytes = 0;
     uint32_t progressFrames = 0;
     float lastProgressPct = 0.f;
 };
@@ -1,7 +1,6 @@
 #include "debug/DebugSerialBridge.h"
 
 #include <WiFi.h>
-#include <EEPROM.h>
 #include <algorithm>
 #include <cstddef>
 #include <cctype>
@@ -12,17 +11,17 @@
 #include "channel/RemoteChannelManager.h"
 #include "Defaults.h"
 #include "protocol/Protocol.h"
+#include "PatternProgram.h"
 
 namespace {
-constexpr uint16_t EEPROM_SIZE_BYTES = 512;
 constexpr uint32_t TELEMETRY_INTERVAL_MS = 3000;
 constexpr uint32_t REQUEST_TIMEOUT_MS = 2000;
 constexpr uint32_t REMOTE_FW_VERSION = 0x00010002; // semantic version 0.1.2
 constexpr uint32_t REMOTE_BUILD_TIMESTAMP = 20251029; // YYYYMMDD
 }
 
-DebugSerialBridge::DebugSerialBridge(CommManager& comm, DeviceManager& devices, RemoteChannelManager& channelMgr)
-    : commManager(comm), deviceManager(devices), channelManager(channelMgr) {}
+DebugSerialBridge::DebugSerialBridge(CommManager& comm, DeviceManager& devices, RemoteChannelManager& channelMgr, ConfigLog::Store& configStore)
+    : commManager(comm), deviceManager(devices), channelManager(channelMgr), configStore(configStore) {}
 
 void DebugSerialBridge::begin(uint32_t baud) {
     serialLink.attach(Serial, baud);
@@ -87,7 +86,8 @@ void DebugSerialBridge::handlePcPacket(DebugProtocol::Packet& packet) {
             respondToPc(packet, DebugProtocol::Status::Ok);
             break;
         }
-        case DebugProtocol::Command::GetTimerStats: {
+        case DebugProtocol::Command::GetTimerStats:
+        case DebugProtocol::Command::GetEdgeTiming: {
             const SlaveDevice* active = commManager.getActiveDevice();
             if (!active) {
                 respondError(packet, DebugProtocol::Status::NotReady);
@@ -171,18 +171,14 @@ void DebugSerialBridge::handlePcPacket(DebugProtocol::Packet& packet) {
             uint16_t address = packet.data[1] | (static_cast<uint16_t>(packet.data[2]) << 8);
             uint16_t length = packet.data[3] | (static_cast<uint16_t>(packet.data[4]) << 8);
             if (target == 0) {
-                if (address >= EEPROM_SIZE_BYTES) {
+                // Addresses index the raw config log partition (sector headers and records)
+                if (address >= configStore.regionSize()) {
                     respondError(packet, DebugProtocol::Status::InvalidArgument);
                     return;
                 }
                 uint16_t capped = std::min<uint16_t>(length, DebugProtocol::MAX_DATA_BYTES);
-                if (address + capped > EEPROM_SIZE_BYTES) {
-                    capped = EEPROM_SIZE_BYTES - address;
-                }
                 uint8_t buffer[DebugProtocol::MAX_DATA_BYTES] = {0};
-                for (uint16_t i = 0; i < capped; ++i) {
-                    buffer[i] = EEPROM.read(address + i);
-                }
+                capped = static_cast<uint16_t>(configStore.readRaw(address, buffer, capped));
                 DebugProtocol::setData(packet, buffer, capped);
                 respondToPc(packet, DebugProtocol::Status::Ok);
             } else {
@@ -212,27 +208,14 @@ void DebugSerialBridge::handlePcPacket(DebugProtocol::Packet& packet) {
                 return;
             }
             uint8_t target = packet.data[0];
-            uint16_t address = packet.data[1] | (static_cast<uint16_t>(packet.data[2]) << 8);
             uint16_t length = packet.data[3] | (static_cast<uint16_t>(packet.data[4]) << 8);
             if (length + 5 > packet.dataLength) {
                 respondError(packet, DebugProtocol::Status::InvalidArgument);
                 return;
             }
-            const uint8_t* payload = packet.data + 5;
             if (target == 0) {
-                if (address >= EEPROM_SIZE_BYTES) {
-                    respondError(packet, DebugProtocol::Status::InvalidArgument);
-                    return;
-                }
-                uint16_t capped = std::min<uint16_t>(length, static_cast<uint16_t>(packet.dataLength - 5));
-                if (address + capped > EEPROM_SIZE_BYTES) {
-                    capped = EEPROM_SIZE_BYTES - address;
-                }
-                for (uint16_t i = 0; i < capped; ++i) {
-                    EEPROM.write(address + i, payload[i]);
-                }
-                EEPROM.commit();
-                respondToPc(packet, DebugProtocol::Status::Ok);
+                // Settings live in an append-only log now; raw byte pokes would break its CRCs
+                respondError(packet, DebugProtocol::Status::Unsupported);
             } else {
                 const SlaveDevice* active = commManager.getActiveDevice();
                 if (!active) {
@@ -462,6 +445,221 @@ void DebugSerialBridge::handlePcPacket(DebugProtocol::Packet& packet) {
             respondToPc(packet, DebugProtocol::Status::Ok);
             break;
         }
+        case DebugProtocol::Command::SetGroupMembership: {
+            // data: [index][groupMask]
+            if (packet.dataLength < 2) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            if (!commManager.assignGroupByIndex(packet.data[0], packet.data[1])) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::GroupCommand: {
+            // data: [groupMask][ProtocolCmd op] + SET_TIMER: ton f32, toff f32 | OVERRIDE_OUTPUT: on u8
+            if (packet.dataLength < 2) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            uint8_t groupMask = packet.data[0];
+            ProtocolCmd op = static_cast<ProtocolCmd>(packet.data[1]);
+            float tonSec = 0.f;
+            float toffSec = 0.f;
+            bool on = false;
+            if (op == ProtocolCmd::SET_TIMER) {
+                if (packet.dataLength < 2 + sizeof(float) * 2) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+                memcpy(&tonSec, packet.data + 2, sizeof(float));
+                memcpy(&toffSec, packet.data + 2 + sizeof(float), sizeof(float));
+                if (!std::isfinite(tonSec) || !std::isfinite(toffSec) || tonSec < 0.f || toffSec < 0.f) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+            } else if (op == ProtocolCmd::OVERRIDE_OUTPUT) {
+                if (packet.dataLength < 3 || packet.data[2] > 1) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+                on = packet.data[2] != 0;
+            } else if (op != ProtocolCmd::RESET_STATE && op != ProtocolCmd::TOGGLE_STATE) {
+                respondError(packet, DebugProtocol::Status::Unsupported);
+                return;
+            }
+            if (!commManager.sendGroupCommand(groupMask, op, tonSec, toffSec, on)) {
+                respondError(packet, DebugProtocol::Status::TransportError);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::ConfigureDevice: {
+            // data: [index][ConfigureOps][channel][ton f32][toff f32][name up to 9 chars]
+            constexpr size_t fixedLen = 3 + sizeof(float) * 2;
+            if (packet.dataLength < fixedLen) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            uint8_t index = packet.data[0];
+            uint8_t ops = packet.data[1];
+            uint8_t channel = packet.data[2];
+            if (index >= static_cast<uint8_t>(std::max(deviceManager.getDeviceCount(), 0)) ||
+                ops == 0 || (ops & ~ConfigureOps::All) != 0) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            float tonSec;
+            float toffSec;
+            memcpy(&tonSec, packet.data + 3, sizeof(float));
+            memcpy(&toffSec, packet.data + 3 + sizeof(float), sizeof(float));
+            if ((ops & ConfigureOps::Timer) &&
+                (!std::isfinite(tonSec) || !std::isfinite(toffSec) || tonSec < 0.f || toffSec < 0.f)) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            if ((ops & ConfigureOps::Channel) && (channel < 1 || channel > 13)) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            char nameBuf[sizeof(SlaveDevice::name)] = {};
+            if (ops & ConfigureOps::Name) {
+                size_t copyLen = std::min<size_t>(packet.dataLength - fixedLen, sizeof(nameBuf) - 1);
+                memcpy(nameBuf, packet.data + fixedLen, copyLen);
+                nameBuf[copyLen] = '\0';
+                if (nameBuf[0] == '\0') {
+                    strncpy(nameBuf, "Timer", sizeof(nameBuf) - 1);
+                }
+            }
+            if (!commManager.configureByIndex(index, ops, nameBuf, tonSec, toffSec, channel)) {
+                respondError(packet, DebugProtocol::Status::TransportError);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::OutputCommand: {
+            // data: [index][output][ProtocolCmd op][on u8] + SET_TIMER: ton f32, toff f32
+            if (packet.dataLength < 4) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            uint8_t index = packet.data[0];
+            uint8_t output = packet.data[1];
+            ProtocolCmd op = static_cast<ProtocolCmd>(packet.data[2]);
+            bool on = packet.data[3] != 0;
+            if (index >= static_cast<uint8_t>(std::max(deviceManager.getDeviceCount(), 0)) || packet.data[3] > 1) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            float tonSec = 0.f;
+            float toffSec = 0.f;
+            if (op == ProtocolCmd::SET_TIMER) {
+                if (packet.dataLength < 4 + sizeof(float) * 2) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+                memcpy(&tonSec, packet.data + 4, sizeof(float));
+                memcpy(&toffSec, packet.data + 4 + sizeof(float), sizeof(float));
+                if (!std::isfinite(tonSec) || !std::isfinite(toffSec) || tonSec < 0.f || toffSec < 0.f) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+            } else if (op != ProtocolCmd::STATUS && op != ProtocolCmd::OVERRIDE_OUTPUT &&
+                       op != ProtocolCmd::RESET_STATE && op != ProtocolCmd::TOGGLE_STATE) {
+                respondError(packet, DebugProtocol::Status::Unsupported);
+                return;
+            }
+            // The output index is checked by the timer, which knows how many it drives
+            if (!commManager.outputCommandByIndex(index, output, op, tonSec, toffSec, on)) {
+                respondError(packet, DebugProtocol::Status::TransportError);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::PatternCommand: {
+            // data: [index][output][PatternOps op] + LOAD: program text, compiled here
+            if (packet.dataLength < 3 ||
+                packet.data[0] >= static_cast<uint8_t>(std::max(deviceManager.getDeviceCount(), 0))) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            uint8_t op = packet.data[2];
+            uint8_t code[PatternProgram::MAX_BYTES] = {};
+            size_t codeLen = 0;
+            if (op == PatternOps::Load) {
+                char source[DebugProtocol::MAX_DATA_BYTES] = {};
+                memcpy(source, packet.data + 3, std::min<size_t>(packet.dataLength - 3, sizeof(source) - 1));
+                if (!PatternProgram::compile(source, code, sizeof(code), &codeLen)) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+            } else if (op != PatternOps::Clear && op != PatternOps::Restart && op != PatternOps::Trigger) {
+                respondError(packet, DebugProtocol::Status::Unsupported);
+                return;
+            }
+            if (!commManager.sendPatternByIndex(packet.data[0], packet.data[1], op, code, codeLen)) {
+                respondError(packet, DebugProtocol::Status::TransportError);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::ScheduleCue: {
+            // data: [index][CueOps op] + ADD: [output][CueActions action][delayMs u32][durationMs u16]
+            // The delay is relative so the PC needs no view of the remote clock
+            if (packet.dataLength < 2 ||
+                packet.data[0] >= static_cast<uint8_t>(std::max(deviceManager.getDeviceCount(), 0))) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            bool ok = false;
+            if (packet.data[1] == CueOps::Clear) {
+                ok = commManager.clearCuesByIndex(packet.data[0]);
+            } else if (packet.data[1] == CueOps::Add && packet.dataLength >= 10) {
+                uint32_t delayMs = 0;
+                uint16_t durationMs = 0;
+                memcpy(&delayMs, packet.data + 4, sizeof(delayMs));
+                memcpy(&durationMs, packet.data + 8, sizeof(durationMs));
+                if (delayMs < Defaults::CUE_MIN_LEAD_MS) {
+                    respondError(packet, DebugProtocol::Status::InvalidArgument);
+                    return;
+                }
+                ok = commManager.scheduleCueByIndex(packet.data[0], packet.data[2], packet.data[3],
+                                                    static_cast<uint32_t>(millis()) + delayMs, durationMs);
+            } else {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            if (!ok) {
+                respondError(packet, DebugProtocol::Status::TransportError);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
+        case DebugProtocol::Command::PulseTrain: {
+            // data: [index][output][count][durUs u16 x count]; count 0 returns the output to GPIO
+            if (packet.dataLength < 3 ||
+                packet.data[0] >= static_cast<uint8_t>(std::max(deviceManager.getDeviceCount(), 0)) ||
+                packet.dataLength < 3 + packet.data[2] * sizeof(uint16_t)) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            uint16_t durUs[(DebugProtocol::MAX_DATA_BYTES - 3) / sizeof(uint16_t)] = {};
+            const uint8_t count = packet.data[2];
+            memcpy(durUs, packet.data + 3, count * sizeof(uint16_t));
+            if (!commManager.sendPulseTrainByIndex(packet.data[0], packet.data[1], durUs, count)) {
+                respondError(packet, DebugProtocol::Status::InvalidArgument);
+                return;
+            }
+            respondToPc(packet, DebugProtocol::Status::Ok);
+            break;
+        }
         case DebugProtocol::Command::GetLogSnapshot: {
             respondError(packet, DebugProtocol::Status::Unsupported);
             break;
@@ -665,7 +863,7 @@ bool DebugSerialBridge::queueTimerChannelUpdate(uint8_t newChannel, bool persist
     ProtocolMsg update = {};
     update.cmd = static_cast<uint8_t>(ProtocolCmd::SET_CHANNEL);
     update.channel = newChannel;
-    update.reserved[0] = persist ? ProtocolFlags::ChannelPersist : 0;
+    update.flags = persist ? ProtocolFlags::ChannelPersist : 0;
 
     pendingChannelTarget = newChannel;
     channelAckPersist = persist;
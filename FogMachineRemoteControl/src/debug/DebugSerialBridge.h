@@ -6,6 +6,7 @@
 #include "DebugProtocol.h"
 #include "protocol/Protocol.h"
 #include "ReliableProtocol.h"
+#include "ConfigLog.h"
 
 class CommManager;
 class DeviceManager;
@@ -13,7 +14,7 @@ class RemoteChannelManager;
 
 class DebugSerialBridge {
 public:
-    DebugSerialBridge(CommManager& comm, DeviceManager& devices, RemoteChannelManager& channelMgr);
+    DebugSerialBridge(CommManager& comm, DeviceManager& devices, RemoteChannelManager& channelMgr, ConfigLog::Store& configStore);
 
     void begin(uint32_t baud = 115200);
     void loop();
@@ -35,6 +36,7 @@ private:
     CommManager& commManager;
     DeviceManager& deviceManager;
     RemoteChannelManager& channelManager;
+    ConfigLog::Store& configStore;
     ReliableSerial::Link serialLink;
     std::vector<PendingRequest> pending;
     DebugProtocol::TimerStatsPayload lastTimerStats{};
@@ -1,66 +1,131 @@
 // DeviceManager.cpp
-// Manages paired slave devices, active selection, and EEPROM persistence.
+// Manages paired slave devices, active selection, and persistence in the config log.
 #include "DeviceManager.h"
-#include <EEPROM.h>
+#include "Defaults.h"
+#include "core/ConfigKeys.h"
 #include <string.h>
+#include <math.h>
 
-// EEPROM layout (simple, not wear-levelled):
-// [0] count (uint8)
-// [1] activeIndex (int8, -1 if none) -> store as uint8_t with 255 meaning -1
-// Then per device: mac[6], name[10]
-// NOTE: Extend later for additional persisted fields.
+// Stored layout:
+// DeviceList: count (uint8), active device's storeSlot as uint8 with 255 meaning none
+// DeviceBase + slot: SlaveIdentity. Slots are stable, so removing a device erases one
+// record instead of renumbering everything behind it; load() lists devices by slot.
 
-static constexpr int EEPROM_ADDR_COUNT = 0;
-static constexpr int EEPROM_ADDR_ACTIVE = 1;
-static constexpr int EEPROM_ADDR_DEVICES = 2; // start of device records
+static constexpr float TIMER_MATCH_EPSILON = 0.05f; // half a tenth of a second
 
-DeviceManager::DeviceManager() {}
+static bool timerMatches(const SlaveDevice& dev) {
+    return fabsf(dev.ton - dev.desiredTon) < TIMER_MATCH_EPSILON &&
+           fabsf(dev.toff - dev.desiredToff) < TIMER_MATCH_EPSILON;
+}
+
+static bool nameMatches(const SlaveDevice& dev) {
+    return strncmp(dev.name, dev.desiredName, sizeof(dev.name) - 1) == 0;
+}
 
-void DeviceManager::begin() {
-    loadFromEEPROM();
+DeviceManager::DeviceManager() {
+    devices.reserve(Defaults::MAX_PAIRED_DEVICES);
 }
 
-void DeviceManager::loadFromEEPROM() {
+void DeviceManager::begin(ConfigLog::Store& configStore) {
+    store = &configStore;
+    loadFromStore();
+}
+
+void DeviceManager::loadFromStore() {
     devices.clear();
-    uint8_t count = 0; EEPROM.get(EEPROM_ADDR_COUNT, count);
-    uint8_t activeRaw = 255; EEPROM.get(EEPROM_ADDR_ACTIVE, activeRaw);
-    int base = EEPROM_ADDR_DEVICES;
-    for (int i = 0; i < count; ++i) {
+    uint8_t list[2] = {0, 255};
+    store->get(ConfigKey::DeviceList, list);
+    activeIndex = -1;
+    for (int slot = 0; slot < Defaults::MAX_PAIRED_DEVICES; ++slot) {
+        SlaveIdentity id;
+        if (!store->get(ConfigKey::DeviceBase + slot, id)) continue;
         SlaveDevice dev = {};
-    EEPROM.get(base, dev.mac); base += 6;
-    EEPROM.get(base, dev.name); base += 10;
+        static_cast<SlaveIdentity&>(dev) = id;
+        dev.name[sizeof(dev.name) - 1] = '\0';
+        dev.storeSlot = (uint8_t)slot;
+        if (slot == list[1]) activeIndex = (int)devices.size();
         devices.push_back(dev);
     }
-    activeIndex = (activeRaw == 255) ? -1 : (int)activeRaw;
+    rebuildIndex();
     ensureActiveValid();
+    touch();
 }
 
-void DeviceManager::saveToEEPROM() {
-    uint8_t count = (uint8_t)devices.size();
-    EEPROM.put(EEPROM_ADDR_COUNT, count);
-    uint8_t activeRaw = (activeIndex < 0) ? 255 : (uint8_t)activeIndex;
-    EEPROM.put(EEPROM_ADDR_ACTIVE, activeRaw);
-    int base = EEPROM_ADDR_DEVICES;
-    for (int i = 0; i < count; ++i) {
-    EEPROM.put(base, devices[i].mac); base += 6;
-    EEPROM.put(base, devices[i].name); base += 10;
+bool DeviceManager::stageList(ConfigLog::Batch& batch) {
+    uint8_t list[2] = {(uint8_t)devices.size(), (uint8_t)((activeIndex < 0) ? 255 : devices[activeIndex].storeSlot)};
+    return batch.stage(ConfigKey::DeviceList, list);
+}
+
+bool DeviceManager::stageRecord(int index, ConfigLog::Batch& batch) {
+    return batch.stage(ConfigKey::DeviceBase + devices[index].storeSlot, static_cast<const SlaveIdentity&>(devices[index]));
+}
+
+uint8_t DeviceManager::allocateSlot() const {
+    // Normally the slot after the last one, which keeps the new device at the end of the list
+    const int next = devices.empty() ? 0 : devices.back().storeSlot + 1;
+    if (next < Defaults::MAX_PAIRED_DEVICES) return (uint8_t)next;
+    uint8_t slot = 0;
+    for (const SlaveDevice& dev : devices) {
+        if (dev.storeSlot != slot) break; // devices are sorted by slot: first gap
+        ++slot;
     }
-    EEPROM.commit();
+    return slot;
+}
+
+size_t DeviceManager::macHash(const uint8_t mac[6]) {
+    // The vendor prefix is shared by every timer; the last three bytes carry the entropy
+    uint32_t h = (uint32_t)mac[3] << 16 | (uint32_t)mac[4] << 8 | mac[5];
+    h ^= (uint32_t)mac[2] << 24;
+    h *= 0x9E3779B1u;
+    return h >> 24; // top 8 bits: MAC_INDEX_SLOTS = 256
+}
+
+void DeviceManager::indexInsert(int index) {
+    size_t at = macHash(devices[index].mac);
+    while (macIndex[at]) at = (at + 1) & (MAC_INDEX_SLOTS - 1);
+    macIndex[at] = (uint8_t)(index + 1);
+}
+
+void DeviceManager::rebuildIndex() {
+    memset(macIndex, 0, sizeof(macIndex));
+    touch();
+    for (int i = 0; i < (int)devices.size(); ++i) indexInsert(i);
 }
 
 void DeviceManager::addDevice(const SlaveDevice& dev) {
-    devices.push_back(dev);
-    if (activeIndex < 0) activeIndex = (int)devices.size() - 1; // auto-select first added
-    saveToEEPROM();
+    if ((int)devices.size() >= Defaults::MAX_PAIRED_DEVICES || findDeviceByMac(dev.mac) >= 0) return;
+    SlaveDevice added = dev;
+    added.storeSlot = allocateSlot();
+    auto pos = devices.begin();
+    while (pos != devices.end() && pos->storeSlot < added.storeSlot) ++pos;
+    const int index = (int)(pos - devices.begin());
+    devices.insert(pos, added);
+    if (index == (int)devices.size() - 1) {
+        indexInsert(index);
+    } else {
+        rebuildIndex(); // filled a gap: later indices moved up
+        if (activeIndex >= index) activeIndex++;
+    }
+    if (activeIndex < 0) activeIndex = index; // auto-select first added
+    touch();
+    ConfigLog::Batch batch;
+    stageRecord(index, batch);
+    stageList(batch);
+    store->commit(batch);
 }
 
 void DeviceManager::removeDevice(int index) {
     if (index >= 0 && index < (int)devices.size()) {
+        ConfigLog::Batch batch;
+        batch.stageErase(ConfigKey::DeviceBase + devices[index].storeSlot);
         devices.erase(devices.begin() + index);
+        rebuildIndex();
         if (activeIndex == index) activeIndex = -1;
         else if (activeIndex > index) activeIndex--; // shift down
         ensureActiveValid();
-        saveToEEPROM();
+        touch();
+        stageList(batch);
+        store->commit(batch);
     }
 }
 
@@ -68,22 +133,128 @@ void DeviceManager::renameDevice(int index, const char* newName) {
     if (index >= 0 && index < (int)devices.size()) {
         strncpy(devices[index].name, newName, sizeof(devices[index].name)-1);
         devices[index].name[sizeof(devices[index].name)-1] = '\0';
-        saveToEEPROM();
+        touch();
+        ConfigLog::Batch batch;
+        if (stageRecord(index, batch)) store->commit(batch);
     }
 }
 
 void DeviceManager::updateDevice(int index, const SlaveDevice& dev) {
     if (index >= 0 && index < (int)devices.size()) {
+        const uint8_t slot = devices[index].storeSlot;
+        const bool macChanged = memcmp(devices[index].mac, dev.mac, 6) != 0;
         devices[index] = dev;
-        saveToEEPROM();
+        devices[index].storeSlot = slot;
+        if (macChanged) rebuildIndex();
+        touch();
+        ConfigLog::Batch batch;
+        if (stageRecord(index, batch)) store->commit(batch);
     }
 }
 
-void DeviceManager::updateStatus(int index, const SlaveDevice& dev) {
-    if (index >= 0 && index < (int)devices.size()) {
-        devices[index] = dev; // already has lastStatusMs set by caller
-        // Do not persist status fields every time to avoid EEPROM wear; skip saveToEEPROM here.
+SlaveLive* DeviceManager::live(int index) {
+    if (index < 0 || index >= (int)devices.size()) return nullptr;
+    touch(); // callers write through the pointer
+    return &devices[index];
+}
+
+void DeviceManager::noteRssi(int index, int8_t rssi) {
+    if (index < 0 || index >= (int)devices.size() || devices[index].rssiRemote == rssi) return;
+    devices[index].rssiRemote = rssi;
+    touch();
+}
+
+void DeviceManager::setReportedName(int index, const char* name) {
+    if (index < 0 || index >= (int)devices.size() || !name || !name[0]) return;
+    strncpy(devices[index].name, name, sizeof(devices[index].name)-1);
+    devices[index].name[sizeof(devices[index].name)-1] = '\0';
+    touch();
+}
+
+void DeviceManager::setDesiredTimer(int index, float ton, float toff) {
+    if (index < 0 || index >= (int)devices.size()) return;
+    SlaveDevice& dev = devices[index];
+    dev.desiredTon = ton;
+    dev.desiredToff = toff;
+    // Reverting to the reported value before anything went out needs no exchange at all
+    if (timerMatches(dev) && dev.reconcileSentMs == 0 && dev.reconcileInFlight == 0) {
+        dev.timerPending = false;
+        return;
+    }
+    dev.timerPending = true;
+    dev.desiredChangedMs = millis();
+    dev.reconcileSentMs = 0;
+    dev.reconcileAttempts = 0;
+}
+
+void DeviceManager::setDesiredName(int index, const char* newName) {
+    if (index < 0 || index >= (int)devices.size() || !newName) return;
+    SlaveDevice& dev = devices[index];
+    strncpy(dev.desiredName, newName, sizeof(dev.desiredName) - 1);
+    dev.desiredName[sizeof(dev.desiredName) - 1] = '\0';
+    if (nameMatches(dev) && dev.reconcileSentMs == 0 && dev.reconcileInFlight == 0) {
+        dev.namePending = false;
+        return;
+    }
+    dev.namePending = true;
+    dev.desiredChangedMs = millis();
+    dev.reconcileSentMs = 0;
+    dev.reconcileAttempts = 0;
+}
+
+bool DeviceManager::hasPendingDesired(int index) const {
+    if (index < 0 || index >= (int)devices.size()) return false;
+    return devices[index].timerPending || devices[index].namePending;
+}
+
+bool DeviceManager::reconcileReported(int index) {
+    if (index < 0 || index >= (int)devices.size()) return true;
+    SlaveDevice& dev = devices[index];
+    if (dev.timerPending && timerMatches(dev)) dev.timerPending = false;
+    if (dev.namePending && nameMatches(dev)) {
+        dev.namePending = false;
+        ConfigLog::Batch batch;
+        if (stageRecord(index, batch)) store->commit(batch); // one record per converged rename, not per keystroke
     }
+    if (dev.timerPending || dev.namePending) return false;
+    dev.reconcileSentMs = 0;
+    dev.reconcileAttempts = 0;
+    return true;
+}
+
+ReconcileStep DeviceManager::nextReconcileStep(int index, unsigned long now) {
+    if (index < 0 || index >= (int)devices.size()) return ReconcileStep::Idle;
+    const SlaveDevice& dev = devices[index];
+    if (!dev.timerPending && !dev.namePending) return ReconcileStep::Idle;
+    if (dev.reconcileInFlight) return ReconcileStep::Wait; // one exchange per timer; newer edits wait for it
+    if (now - dev.desiredChangedMs < Defaults::RECONCILE_SETTLE_MS) return ReconcileStep::Wait;
+    if (dev.reconcileSentMs && now - dev.reconcileSentMs < Defaults::RECONCILE_RETRY_MS) return ReconcileStep::Wait;
+    if (dev.reconcileAttempts < Defaults::RECONCILE_MAX_ATTEMPTS) return ReconcileStep::Send;
+    dropDesired(index);
+    return ReconcileStep::GiveUp;
+}
+
+void DeviceManager::markReconcileSent(int index, unsigned long now) {
+    if (index < 0 || index >= (int)devices.size()) return;
+    SlaveDevice& dev = devices[index];
+    dev.reconcileSentMs = now ? now : 1;
+    if (dev.reconcileAttempts < 255) dev.reconcileAttempts++;
+    dev.reconcileInFlight = 1; // name and timer share one CONFIGURE frame
+}
+
+void DeviceManager::markReconcileEnded(int index) {
+    if (index < 0 || index >= (int)devices.size()) return;
+    if (devices[index].reconcileInFlight) devices[index].reconcileInFlight--;
+}
+
+void DeviceManager::dropDesired(int index) {
+    if (index < 0 || index >= (int)devices.size()) return;
+    SlaveDevice& dev = devices[index];
+    dev.timerPending = false;
+    dev.namePending = false;
+    dev.reconcileSentMs = 0;
+    dev.reconcileAttempts = 0;
+    dev.reconcileInFlight = 0;
 }
 
 int DeviceManager::getDeviceCount() const { return (int)devices.size(); }
@@ -91,7 +262,8 @@ int DeviceManager::getDeviceCount() const { return (int)devices.size(); }
 const SlaveDevice& DeviceManager::getDevice(int index) const { return devices[index]; }
 
 int DeviceManager::findDeviceByMac(const uint8_t mac[6]) const {
-    for (int i = 0; i < (int)devices.size(); ++i) {
+    for (size_t at = macHash(mac); macIndex[at]; at = (at + 1) & (MAC_INDEX_SLOTS - 1)) {
+        const int i = macIndex[at] - 1;
         if (memcmp(devices[i].mac, mac, 6) == 0) return i;
     }
     return -1;
@@ -100,10 +272,10 @@ int DeviceManager::findDeviceByMac(const uint8_t mac[6]) const {
 void DeviceManager::setActiveIndex(int idx) {
     if (idx < 0 || idx >= (int)devices.size()) { activeIndex = -1; }
     else activeIndex = idx;
-    // Persist only the active index to avoid heavy EEPROM writes that can stall the UI
-    uint8_t activeRaw = (activeIndex < 0) ? 255 : (uint8_t)activeIndex;
-    EEPROM.put(EEPROM_ADDR_ACTIVE, activeRaw);
-    EEPROM.commit();
+    touch();
+    // Persist only the list header; the device records are unchanged
+    ConfigLog::Batch batch;
+    if (stageList(batch)) store->commit(batch);
 }
 
 const SlaveDevice* DeviceManager::getActive() const {
@@ -119,12 +291,15 @@ void DeviceManager::ensureActiveValid() {
 void DeviceManager::factoryReset() {
     devices.clear();
     activeIndex = -1;
-    // Persist cleared state
-    uint8_t zero = 0;
-    EEPROM.put(EEPROM_ADDR_COUNT, zero);
-    uint8_t inactive = 255; // -1 sentinel
-    EEPROM.put(EEPROM_ADDR_ACTIVE, inactive);
-    // Optionally clear device slots region (not strictly necessary)
-    // Keep it simple to avoid wear; just commit header changes
-    EEPROM.commit();
+    memset(macIndex, 0, sizeof(macIndex));
+    // Drop the records as well so no stale MAC survives the reset. Erasing an absent key
+    // writes nothing; commit in chunks so a full registry stays within one batch each.
+    ConfigLog::Batch batch;
+    for (int slot = 0; slot < Defaults::MAX_PAIRED_DEVICES; ++slot) {
+        if (!store->contains(ConfigKey::DeviceBase + slot)) continue;
+        batch.stageErase(ConfigKey::DeviceBase + slot);
+        if (batch.size() == ConfigLog::Batch::CAPACITY) store->commit(batch);
+    }
+    batch.stageErase(ConfigKey::DeviceList);
+    store->commit(batch);
 }
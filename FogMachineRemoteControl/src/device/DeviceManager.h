@@ -1,44 +1,115 @@
 // DeviceManager.h
-// Manages paired slave devices, active selection, names, MACs, and EEPROM persistence.
+// Manages paired slave devices, active selection, names, MACs, and their persistence.
 #pragma once
 #include <Arduino.h>
+#include <atomic>
 #include <vector>
+#include "ConfigLog.h"
+#include "Defaults.h"
 
-struct SlaveDevice {
+// Persisted identity: one config log record per paired timer, written as is
+struct SlaveIdentity {
     uint8_t mac[6];
     char name[10]; // 9 + NUL
-    int8_t rssiRemote = -127;   // RSSI measured at remote (placeholder)
-    int8_t rssiSlave = -127;    // RSSI reported by slave (placeholder)
+};
+static_assert(sizeof(SlaveIdentity) == 16, "SlaveIdentity is stored verbatim");
+
+// Live state reported by the timer or measured here; RAM only, updated in place
+struct SlaveLive {
+    int8_t rssiRemote = -127;   // RSSI measured at remote
+    int8_t rssiSlave = -127;    // RSSI reported by slave
     float ton = 0.f;
     float toff = 0.f;
     float elapsed = 0.f;        // seconds elapsed in current state (from slave)
     bool outputState = false;
     unsigned long lastStatusMs = 0; // millis() timestamp of last received status
+    uint8_t groupMask = 0;          // group memberships reported by the timer (not persisted here)
+    uint8_t groupSlot = 0xFF;       // reply slot for group commands (0xFF = unassigned)
+    bool phaseLocked = false;       // timer reports its fog output locked to the phase group
+};
+
+struct SlaveDevice : SlaveIdentity, SlaveLive {
+    uint8_t storeSlot = 0xFF;   // config log record (ConfigKey::DeviceBase + storeSlot), set by DeviceManager
+    // Desired state (RAM only). ton/toff/name above are what the timer last reported;
+    // CommManager reconciles these intents until the reported values match.
+    float desiredTon = 0.f;
+    float desiredToff = 0.f;
+    char desiredName[10] = {};
+    bool timerPending = false;
+    bool namePending = false;
+    unsigned long desiredChangedMs = 0; // last edit, used to coalesce bursts
+    unsigned long reconcileSentMs = 0;  // last reconcile send (0 = none since last edit)
+    uint8_t reconcileAttempts = 0;
+    uint8_t reconcileInFlight = 0;      // CONFIGURE frames awaiting link ACK
+};
+
+// What the reconciler does for one device on a loop pass
+enum class ReconcileStep : uint8_t {
+    Idle,   // nothing pending
+    Wait,   // settling, a CONFIGURE in flight, or waiting for the STATUS it triggers
+    Send,   // send one CONFIGURE with the pending name/timer
+    GiveUp, // RECONCILE_MAX_ATTEMPTS sent without convergence; the intent was dropped
 };
 
 class DeviceManager {
 public:
     DeviceManager();
-    void begin();
-    void loadFromEEPROM();
-    void saveToEEPROM();
+    void begin(ConfigLog::Store& configStore);
+    void loadFromStore();
+    // Each device persists as its own record, so add/remove/rename write one record
+    // (plus the list header when the active selection moves), however many are paired.
+    // Ignored once Defaults::MAX_PAIRED_DEVICES timers are paired
     void addDevice(const SlaveDevice& dev);
     void removeDevice(int index);
     void renameDevice(int index, const char* newName);
     void updateDevice(int index, const SlaveDevice& dev);
     int getDeviceCount() const;
     const SlaveDevice& getDevice(int index) const;
+    // O(1) through the MAC hash index. Loop task only, like every other member: CommManager
+    // queues received frames and handles them in loop()
     int findDeviceByMac(const uint8_t mac[6]) const;
     // Active device management
     int getActiveIndex() const { return activeIndex; }
     void setActiveIndex(int idx);
     const SlaveDevice* getActive() const;
-    // Update status convenience
-    void updateStatus(int index, const SlaveDevice& dev);
-    // Wipe all paired devices and reset active selection; persists to EEPROM
+    // Hot path: live fields are updated in place, nothing is copied or persisted
+    SlaveLive* live(int index);
+    void noteRssi(int index, int8_t rssi);
+    // Name the timer reported; persisted only once a pending rename converges
+    void setReportedName(int index, const char* name);
+    // Desired-state tracking (see SlaveDevice). Setters only record intent; nothing is sent here.
+    void setDesiredTimer(int index, float ton, float toff);
+    void setDesiredName(int index, const char* newName);
+    bool hasPendingDesired(int index) const;
+    // Compare reported against desired after a STATUS; clears satisfied intents and
+    // persists a converged rename. Returns true when nothing is left pending.
+    bool reconcileReported(int index);
+    ReconcileStep nextReconcileStep(int index, unsigned long now);
+    void markReconcileSent(int index, unsigned long now);
+    // The CONFIGURE exchange ended: ACK, NAK or link timeout. A timeout leaves the
+    // intent pending, so the reconciler re-sends until RECONCILE_MAX_ATTEMPTS.
+    void markReconcileEnded(int index);
+    void dropDesired(int index);
+    // Wipe all paired devices and reset active selection; persists the empty list
     void factoryReset();
+    // Bumped by every change the UI shows, including in-place live() updates from STATUS replies
+    uint32_t getRevision() const { return revision.load(std::memory_order_relaxed); }
 private:
+    void touch() { revision.fetch_add(1, std::memory_order_relaxed); }
+    // Open addressing with linear probing; at most half full at MAX_PAIRED_DEVICES
+    static constexpr size_t MAC_INDEX_SLOTS = 256;
+    static_assert(MAC_INDEX_SLOTS >= 2 * Defaults::MAX_PAIRED_DEVICES, "MAC index too small");
+    static_assert((MAC_INDEX_SLOTS & (MAC_INDEX_SLOTS - 1)) == 0, "MAC index size must be a power of two");
+    static size_t macHash(const uint8_t mac[6]);
+    void indexInsert(int index);
+    void rebuildIndex();
     void ensureActiveValid();
-    std::vector<SlaveDevice> devices;
+    bool stageList(ConfigLog::Batch& batch);
+    bool stageRecord(int index, ConfigLog::Batch& batch);
+    uint8_t allocateSlot() const;
+    ConfigLog::Store* store = nullptr;
+    std::vector<SlaveDevice> devices; // sorted by storeSlot; capacity reserved, so references stay valid across adds
+    uint8_t macIndex[MAC_INDEX_SLOTS] = {}; // device index + 1, 0 = empty
     int activeIndex = -1;
+    std::atomic<uint32_t> revision{0};
 };
@@ -1,7 +1,6 @@
 // main.cpp - FogMachineRemoteControl entry point
 #include <Arduino.h>
 #include "Pins.h"
-#include <EEPROM.h>
 #include "Defaults.h"
 #include <vector>
 
@@ -20,6 +19,9 @@
 #include "protocol/Protocol.h"
 #include "core/RemoteConfig.h"
 #include "channel/RemoteChannelManager.h"
+#include "core/LegacyEeprom.h"
+#include "ConfigLog.h"
+#include "ConfigLogFlusher.h"
 #include <esp_wifi.h>
 #include <esp_sleep.h>
 #include <driver/gpio.h>
@@ -41,13 +43,12 @@ RemoteChannelManager channelMgr;
 CommManager comm(deviceMgr, channelMgr);
 InputInterpreter inputInterp;
 RemoteConfig rconfig;
-DebugSerialBridge debugBridge(comm, deviceMgr, channelMgr);
+ConfigLog::Store configStore;
+ConfigLog::Flusher configFlusher;
+DebugSerialBridge debugBridge(comm, deviceMgr, channelMgr, configStore);
 
-static void wipeRemoteEeprom() {
-  for (int i = 0; i < 512; ++i) {
-    EEPROM.write(i, 0);
-  }
-  EEPROM.commit();
+static void wipeRemoteConfig() {
+  configStore.format();
 }
 
 void setup() {
@@ -85,15 +86,29 @@ void setup() {
   }
   menu.begin();
   displayMgr.drawBootStatus("Boot: menu OK");
-  EEPROM.begin(512); // ensure EEPROM is available for DeviceManager persistence
-  displayMgr.drawBootStatus("Boot: EEPROM OK");
-  channelMgr.begin(&wipeRemoteEeprom, 512);
+  {
+    ConfigLog::FlashRegion region;
+    if (!ConfigLog::openPartition(region) || !configStore.begin(region)) {
+      Serial.println("[REMOTE] No config log partition, settings will not persist");
+      displayMgr.drawBootStatus("Boot: no config storage");
+    } else {
+      if (importLegacyEeprom(configStore)) {
+        Serial.println("[REMOTE] Imported settings from legacy EEPROM");
+      }
+      displayMgr.drawBootStatus("Boot: storage OK");
+    }
+  }
+  channelMgr.begin(configStore, &wipeRemoteConfig);
   displayMgr.drawBootStatus("Boot: channel OK");
-  deviceMgr.begin();
+  deviceMgr.begin(configStore);
   displayMgr.drawBootStatus("Boot: devices OK");
-  rconfig.begin(512);
+  rconfig.begin(configStore);
   displayMgr.drawBootStatus("Boot: config OK");
-  calibMgr.begin();
+  calibMgr.begin(configStore);
+  // Status replies can rename or re-pair devices; the flusher keeps their flash writes out of loop()
+  if (configStore.ready() && !configFlusher.begin(configStore, Defaults::CONFIG_FLUSH_QUIET_MS, Defaults::CONFIG_FLUSH_MAX_DELAY_MS)) {
+    Serial.println("[REMOTE] Config flusher not started, saves write flash directly");
+  }
   displayMgr.drawBootStatus("Boot: calib OK");
   battery.begin();
   displayMgr.drawBootStatus("Boot: battery OK");
@@ -280,28 +295,18 @@ void loop() {
     }
   }
 
-  // Live RSSI screen refresh: when on SHOW_RSSI, periodically poll the visible devices
-  static unsigned long lastRssiRefreshMs = 0;
-  if (menu.getMode() == MenuSystem::Mode::SHOW_RSSI && !displayMgr.isBlank()) {
-    // Enable remote-side RSSI sniffer while on this screen
-    comm.setRssiSnifferEnabled(true);
+  // Live RSSI screen / dashboard refresh: one slotted status sweep covers every paired timer
+  static unsigned long lastSweepMs = 0;
+  bool onRssi = (menu.getMode() == MenuSystem::Mode::SHOW_RSSI);
+  bool onDashboard = (menu.getMode() == MenuSystem::Mode::DASHBOARD);
+  // The RSSI list and the PC's GET_RSSI are the only readers of the remote-side RSSI
+  comm.setRssiWanted((onRssi && !displayMgr.isBlank()) || debugBridge.isPcConnected());
+  if ((onRssi || onDashboard) && !displayMgr.isBlank()) {
     unsigned long nowMs = millis();
-    if (nowMs - lastRssiRefreshMs > 1000) { // 1s cadence for visible list
-      int first = menu.getRssiFirst();
-      int count = comm.getPairedCount();
-      int maxRows = 4;
-      for (int i = 0; i < maxRows; ++i) {
-        int idx = first + i;
-        if (idx >= 0 && idx < count) {
-          const SlaveDevice &dev = comm.getPaired(idx);
-          comm.requestStatus(dev);
-        }
-      }
-      lastRssiRefreshMs = nowMs;
+    if (nowMs - lastSweepMs > Defaults::STATUS_SWEEP_INTERVAL_MS) {
+      comm.startStatusSweep();
+      lastSweepMs = nowMs;
     }
-  } else {
-    // Turn off sniffer when leaving RSSI screen
-    comm.setRssiSnifferEnabled(false);
   }
 
   // While calibrating RSSI thresholds, keep polling the active device for Timer-side RSSI updates
@@ -331,13 +336,12 @@ void loop() {
     pairingWasActive = onPair;
   }
 
-  static unsigned long lastDisplay = 0;
+  battery.update();
+
   unsigned long now = millis();
-  if (now - lastDisplay > 33) { // ~30Hz
-    displayMgr.setPreventBlanking(debugBridge.isPcConnected());
-    displayMgr.render(deviceMgr, battery, menu, buttons);
-    lastDisplay = now;
-  }
+  displayMgr.setPreventBlanking(debugBridge.isPcConnected());
+  // Cheap when nothing changed: render() schedules its own frames (see DisplayManager)
+  displayMgr.render(deviceMgr, battery, menu, buttons);
 
   // Handle battery calibration UI lifecycle
   if (menu.getMode() == MenuSystem::Mode::BATTERY_CALIB) {
@@ -395,10 +399,10 @@ void loop() {
   loopCount++;
   if (now - lastDiag > 1000) {
     DebugMetrics &dm = DebugMetrics::instance();
-    Serial.printf("[DIAG] loop/s=%lu inMenu=%d #hold=%lums BTN(U,D,#,*,#L)=%lu,%lu,%lu,%lu,%lu DISP(fr=%lu avgPrep=%lums avgFlush=%lums maxFlush=%lums slow=%lu pbarFr=%lu pbarLast=%.0f%%)\n",
+    Serial.printf("[DIAG] loop/s=%lu inMenu=%d #hold=%lums BTN(U,D,#,*,#L)=%lu,%lu,%lu,%lu,%lu DISP(fr=%lu avgPrep=%lums avgFlush=%lums maxFlush=%lums avgBytes=%lu slow=%lu pbarFr=%lu pbarLast=%.0f%%)\n",
           loopCount, menu.isInMenu(), buttons.hashHoldDuration(),
           (unsigned long)upPresses,(unsigned long)downPresses,(unsigned long)hashPresses,(unsigned long)starPresses,(unsigned long)hashLongEntries,
-          (unsigned long)dm.getFrameCount(), (unsigned long)dm.getAvgPrep(), (unsigned long)dm.getAvgFlush(), (unsigned long)dm.getMaxFlush(), (unsigned long)dm.getSlowFlushes(),
+          (unsigned long)dm.getFrameCount(), (unsigned long)dm.getAvgPrep(), (unsigned long)dm.getAvgFlush(), (unsigned long)dm.getMaxFlush(), (unsigned long)dm.getAvgFlushBytes(), (unsigned long)dm.getSlowFlushes(),
           (unsigned long)dm.getProgressFrames(), dm.getLastProgressPct()*100.0f);
     dm.resetProgress();
     dm.resetDisplay();
@@ -431,6 +435,7 @@ static void configureDeepSleepWakePins() {
 
 static void enterDeepSleepNow() {
   Serial.println("[REMOTE] Entering deep sleep...");
+  configStore.flush(); // deep sleep skips the restart shutdown handlers
   configureDeepSleepWakePins();
   esp_deep_sleep_start();
 }
@@ -13,9 +13,13 @@ static constexpr unsigned long NAV_REPEAT_INTERVAL_MS = 140; // subsequent repea
 MenuSystem::MenuSystem() : selectedIndex(0), inMenu(false), menuEnterTime(0), scrollOffset(0), lastNavTime(0), lastSelectTime(0) {
     items = {
         {"Pair Timer"},
+        {"Dashboard"},
         {"Rename Device"},
         {"Active Timer"},
         {"Edit Timers"},
+        {"Sync Timers"},
+        {"Stagger Timers"},
+        {"Free Run Timers"},
         {"OLED Brightness"},
         {"WiFi TX Power"},
         {"Show RSSI"},
@@ -76,12 +80,20 @@ void MenuSystem::update(bool upPressed, bool downPressed, bool hashPressed, bool
                     if (act) { ton = act->ton; toff = act->toff; }
                 }
                 enterEditTimers(ton, toff);
+            } else if (strcmp(label, "Sync Timers") == 0) {
+                if (auto *comm = CommManager::get()) comm->startPhaseGroup(0);
+            } else if (strcmp(label, "Stagger Timers") == 0) {
+                if (auto *comm = CommManager::get()) comm->startPhaseGroup(Defaults::PHASE_STAGGER_MS);
+            } else if (strcmp(label, "Free Run Timers") == 0) {
+                if (auto *comm = CommManager::get()) comm->stopPhaseGroup();
             } else if (strcmp(label, "WiFi TX Power") == 0) {
                 enterTxPower();
             } else if (strcmp(label, "OLED Brightness") == 0) {
                 enterBrightness();
             } else if (strcmp(label, "RSSI Calibration") == 0) {
                 enterRssiCalib();
+            } else if (strcmp(label, "Dashboard") == 0) {
+                enterDashboard();
             } else if (strcmp(label, "Show RSSI") == 0) {
                 enterShowRssi();
             } else if (strcmp(label, "Channel Settings") == 0) {
@@ -304,12 +316,15 @@ void MenuSystem::update(bool upPressed, bool downPressed, bool hashPressed, bool
         // Up/Down scroll list
         if (upPressed) { if (rssiFirstIndex > 0) rssiFirstIndex--; }
         if (downPressed) { if (rssiFirstIndex < (count>0?count-1:0)) rssiFirstIndex++; }
-        // '#' refresh all RSSI by requesting status from each paired device
-        if (hashPressed && comm) {
-            for (int i=0;i<comm->getPairedCount();++i) {
-                comm->requestStatus(comm->getPaired(i));
-            }
-        }
+        // '#' refresh all RSSI with one slotted status sweep
+        if (hashPressed && comm) comm->startStatusSweep();
+        if (starPressed) { mode = Mode::ROOT; return; }
+    } else if (mode == Mode::DASHBOARD) {
+        auto *comm = CommManager::get();
+        int count = comm ? comm->getPairedCount() : 0;
+        if (upPressed) { if (dashFirstIndex > 0) dashFirstIndex--; }
+        if (downPressed) { if (dashFirstIndex < (count>0?count-1:0)) dashFirstIndex++; }
+        if (hashPressed && comm) comm->startStatusSweep();
         if (starPressed) { mode = Mode::ROOT; return; }
     } else if (mode == Mode::BATTERY_CALIB) {
         // Battery Calibration keys with hold-to-repeat:
@@ -570,6 +585,11 @@ void MenuSystem::enterShowRssi() {
     mode = Mode::SHOW_RSSI;
     if (auto *comm = CommManager::get()) comm->requestStatusActive();
 }
+void MenuSystem::enterDashboard() {
+    mode = Mode::DASHBOARD;
+    dashFirstIndex = 0;
+    if (auto *comm = CommManager::get()) comm->startStatusSweep();
+}
 void MenuSystem::enterChannelSettings() {
     inMenu = true;
     mode = Mode::CHANNEL_SETTINGS;
@@ -33,7 +33,7 @@ public:
     bool justSelected() const { return lastSelectTime && (millis() - lastSelectTime < 400); }
     const char* getLastActionLabel() const { return lastActionLabel; }
     // Editing helpers / modes
-    enum class Mode { ROOT, EDIT_BLANKING, EDIT_TXPOWER, EDIT_BRIGHTNESS, PAIRING, MANAGE_DEVICES, RENAME_DEVICE, SELECT_ACTIVE, SHOW_RSSI, BATTERY_CALIB, EDIT_RSSI_CALIB, EDIT_TIMERS, EDIT_NAME, CONFIRM, CHANNEL_SETTINGS };
+    enum class Mode { ROOT, EDIT_BLANKING, EDIT_TXPOWER, EDIT_BRIGHTNESS, PAIRING, MANAGE_DEVICES, RENAME_DEVICE, SELECT_ACTIVE, SHOW_RSSI, BATTERY_CALIB, EDIT_RSSI_CALIB, EDIT_TIMERS, EDIT_NAME, CONFIRM, CHANNEL_SETTINGS, DASHBOARD };
     struct ChannelOption {
         uint8_t channel;
         uint16_t apCount;
@@ -144,6 +144,7 @@ public:
     // Enter Active Timer selection; if returnToMain=true, exit returns to main screen, else to menu
     void enterSelectActive(bool returnToMain = false);
     void enterShowRssi();
+    void enterDashboard();
     void enterTxPower();
     void enterBrightness();
     void enterBatteryCal();
@@ -228,6 +229,9 @@ public:
     unsigned long calibLastRepeatMs = 0;
     // RSSI list scroll pos
     int rssiFirstIndex = 0;
+    // Dashboard list scroll pos
+    int dashFirstIndex = 0;
+    int getDashFirst() const { return dashFirstIndex; }
     // Remote reset pending flag
     bool remoteResetPending = false;
     // Power cycle (software restart) pending flag
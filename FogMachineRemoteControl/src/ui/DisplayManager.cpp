@@ -8,7 +8,12 @@
 #include "Defaults.h"
 #include "comm/CommManager.h"
 
-DisplayManager::DisplayManager() : display(128, 64, &Wire, -1) {}
+namespace {
+constexpr uint8_t OLED_I2C_ADDR = 0x3C;
+} // namespace
+
+// Keep the bus at full speed between flushes too; the OLED is its only device
+DisplayManager::DisplayManager() : display(128, 64, &Wire, -1, Defaults::OLED_I2C_HZ, Defaults::OLED_I2C_HZ) {}
 
 void DisplayManager::splash() {
 	display.clearDisplay();
@@ -19,7 +24,7 @@ void DisplayManager::splash() {
 	display.drawLine(0, 9, 127, 9, SSD1306_WHITE);
 	display.setCursor(0, 20);
 	display.println(Defaults::VERSION());
-	display.display();
+	present();
 }
 
 void DisplayManager::begin() {
@@ -27,13 +32,13 @@ void DisplayManager::begin() {
 	selectedSda = OLED_SDA_PIN;
 	selectedScl = OLED_SCL_PIN;
 	Wire.begin(selectedSda, selectedScl);
-	bool ok = display.begin(SSD1306_SWITCHCAPVCC, 0x3C, false, false);
+	bool ok = display.begin(SSD1306_SWITCHCAPVCC, OLED_I2C_ADDR, false, false);
 	if (!ok) {
 		// Try alternate pins
 		selectedSda = OLED_SDA_PIN_ALT;
 		selectedScl = OLED_SCL_PIN_ALT;
 		Wire.begin(selectedSda, selectedScl);
-		ok = display.begin(SSD1306_SWITCHCAPVCC, 0x3C, false, false);
+		ok = display.begin(SSD1306_SWITCHCAPVCC, OLED_I2C_ADDR, false, false);
 	}
 	if (!ok) {
 		initFailed = true;
@@ -42,9 +47,17 @@ void DisplayManager::begin() {
 	}
 	inited = true;
 	initFailed = false;
+	// Panel RAM is undefined after power-up, so the first flush sends everything
+	if (!flusher.begin(OLED_I2C_ADDR)) {
+		Serial.println("[DISPLAY] Flush task not started, frames flush inline");
+	}
+	appliedContrast = -1;
 	display.clearDisplay();
 	display.setRotation(Defaults::OLED_ROTATION);
 	if (!skipSplash) splash();
+#ifdef UI_BLIT_BENCHMARK
+	benchmarkTimerRows();
+#endif
 	// Start unblanked
 	isBlanked = false;
 	lastWakeMs = millis();
@@ -60,6 +73,7 @@ void DisplayManager::setPreventBlanking(bool value) {
 		if (isBlanked) {
 			isBlanked = false;
 			display.ssd1306_command(SSD1306_DISPLAYON);
+			frameRequested = true;
 		}
 	}
 }
@@ -76,17 +90,23 @@ void DisplayManager::blankNow() {
 }
 
 void DisplayManager::render(const DeviceManager& deviceMgr, const BatteryMonitor& battery, const MenuSystem& menu, const ButtonInput& buttons) {
+	const unsigned long now = millis();
 	if (!inited) {
 		// If init failed, draw a minimal error panel repeatedly
-		if (initFailed) {
+		if (initFailed && now - lastFrameMs >= Defaults::UI_IDLE_FRAME_MS) {
 			drawErrorScreen();
+			lastFrameMs = now;
 		}
 		return;
 	}
 
-	// Apply contrast/brightness from menu (clamped in menu)
-	display.ssd1306_command(SSD1306_SETCONTRAST);
-	display.ssd1306_command(menu.getAppliedOledBrightness());
+	// Apply contrast/brightness from menu (clamped in menu) when it changes
+	const uint8_t contrast = menu.getAppliedOledBrightness();
+	if (appliedContrast != contrast) {
+		display.ssd1306_command(SSD1306_SETCONTRAST);
+		display.ssd1306_command(contrast);
+		appliedContrast = contrast;
+	}
 
 	// Wake on any interaction
 	bool anyActive = buttons.upHeld() || buttons.downHeld() || buttons.hashHeld() || buttons.starHeld() ||
@@ -94,7 +114,7 @@ void DisplayManager::render(const DeviceManager& deviceMgr, const BatteryMonitor
 	bool keepAwake = anyActive || preventBlanking;
 	if (keepAwake) {
 		lastWakeMs = millis();
-		if (isBlanked) { isBlanked = false; display.ssd1306_command(SSD1306_DISPLAYON); }
+		if (isBlanked) { isBlanked = false; display.ssd1306_command(SSD1306_DISPLAYON); frameRequested = true; }
 	}
 	// Handle Auto Off based on applied seconds
 	int blankSecs = menu.getAppliedBlankingSeconds();
@@ -109,13 +129,32 @@ void DisplayManager::render(const DeviceManager& deviceMgr, const BatteryMonitor
 		}
 	} else {
 		// Blanking disabled
-		if (isBlanked) { isBlanked = false; display.ssd1306_command(SSD1306_DISPLAYON); }
+		if (isBlanked) { isBlanked = false; display.ssd1306_command(SSD1306_DISPLAYON); frameRequested = true; }
 	}
 	if (isBlanked) {
 		// Nothing to draw while blanked
 		return;
 	}
 
+	// Draw only when the shown state changed, input is active (hold bar, auto-repeat), or an
+	// element drawn last frame asked for a redraw; cap at 60 Hz
+	const uint32_t deviceRevision = deviceMgr.getRevision();
+	const uint32_t batteryRevision = battery.getRevision();
+	const uint32_t menuState = ((uint32_t)menu.getMode() << 24) ^ ((uint32_t)menu.isInMenu() << 23) ^ (uint32_t)menu.getSelectedIndex();
+	const bool due = frameRequested || anyActive || deviceRevision != drawnDeviceRevision || menuState != drawnMenuState ||
+					 batteryRevision != drawnBatteryRevision ||
+					 (long)(now - nextFrameMs) >= 0;
+	if (!due || now - lastFrameMs < Defaults::UI_FRAME_MIN_MS) {
+		return;
+	}
+	frameRequested = false;
+	drawnDeviceRevision = deviceRevision;
+	drawnMenuState = menuState;
+	drawnBatteryRevision = batteryRevision;
+	lastFrameMs = now;
+	// While input is active keep frames coming, so the one after a release clears the hold bar
+	nextFrameMs = now + (anyActive ? Defaults::UI_FRAME_MIN_MS : Defaults::UI_IDLE_FRAME_MS);
+
 	// Draw frame
 	unsigned long tStart = millis();
 	display.clearDisplay();
@@ -138,12 +177,28 @@ void DisplayManager::render(const DeviceManager& deviceMgr, const BatteryMonitor
 		}
 	}
 	// Flush to OLED
+	unsigned long prepMs = (millis() - tStart);
 	unsigned long tFlushStartUs = micros();
-	display.display();
+	present();
 	unsigned long flushMs = (micros() - tFlushStartUs) / 1000UL;
-	unsigned long prepMs = (millis() - tStart);
 	unsigned long totalMs = prepMs + flushMs;
 	DebugMetrics::instance().recordDisplayFrame((uint32_t)prepMs, (uint32_t)flushMs, (uint32_t)totalMs);
+	DebugMetrics::instance().recordFlushBytes(flusher.takeBytesSent());
+}
+
+bool DisplayManager::blitFrame(PageBlit::Frame& out) const {
+	if (display.getRotation() != 0) return false;
+	out.buf = display.getBuffer();
+	out.width = display.width();
+	out.height = display.height();
+	return true;
 }
 
+void DisplayManager::redrawIn(unsigned long ms) const {
+	const unsigned long at = millis() + ms;
+	if ((long)(at - nextFrameMs) < 0) nextFrameMs = at;
+}
 
+void DisplayManager::present() const {
+	flusher.submit(display.getBuffer());
+}
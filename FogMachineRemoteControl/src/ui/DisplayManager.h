@@ -2,13 +2,18 @@
 // Handles OLED rendering, UI, and battery indicator.
 #pragma once
 #include <Adafruit_SSD1306.h>
+#include "Defaults.h"
 #include "device/DeviceManager.h"
 #include "battery/BatteryMonitor.h"
 #include "menu/MenuSystem.h"
 #include "ui/ButtonInput.h"
+#include "ui/OledFlusher.h"
+#include "PageBlit.h"
 
 class DisplayManager {
 public:
+    // How drawTimerRow renders digits; the blitter writes glyph columns straight into the buffer
+    enum class DigitStyle : uint8_t { Gfx, Blit, Segment };
     DisplayManager();
     void begin();
     void render(const DeviceManager& deviceMgr, const BatteryMonitor& battery, const MenuSystem& menu, const ButtonInput& buttons);
@@ -22,6 +27,8 @@ public:
     void drawBootStatus(const char* msg) const;
     void setPreventBlanking(bool value);
     void blankNow();
+    // Draw on the next render() even if nothing it tracks has changed
+    void invalidate() { frameRequested = true; }
 private:
     mutable Adafruit_SSD1306 display;
     bool inited = false;
@@ -33,11 +40,30 @@ private:
     bool preventBlanking = false;
     int selectedSda = -1;
     int selectedScl = -1;
+    int16_t appliedContrast = -1;
+    // Change-driven frames: render() draws only when one of these moved or nextFrameMs is due
+    bool frameRequested = true;
+    unsigned long lastFrameMs = 0;
+    mutable unsigned long nextFrameMs = 0;
+    uint32_t drawnDeviceRevision = 0;
+    uint32_t drawnMenuState = 0;
+    uint32_t drawnBatteryRevision = 0;
+    // Called while drawing by elements that change on their own (counters, blinks, animations)
+    void redrawIn(unsigned long ms) const;
+    mutable OledFlusher flusher;
+    // Hands the framebuffer to the flusher; returns once it is copied, not sent
+    void present() const;
     void splash();
     void drawErrorScreen() const;
     void drawBatteryIndicator(uint8_t percent) const;
     void drawMenu(const MenuSystem& menu, const DeviceManager& deviceMgr, const BatteryMonitor& battery) const;
     void drawMainScreen(const DeviceManager& deviceMgr, const BatteryMonitor& battery, const MenuSystem& menu) const;
     void drawProgressBar(unsigned long holdMs, unsigned long longPressMs) const;
-    void drawTimerRow(int tenths, int y, const char* label, int startX = 10) const;
+    // invertDigit (0-4) draws that digit black on white, as the timer editor's cursor
+    void drawTimerRow(int tenths, int y, const char* label, int startX = 10, int invertDigit = -1,
+                      DigitStyle style = static_cast<DigitStyle>(Defaults::UI_TIMER_DIGIT_STYLE)) const;
+    // Page-major view of the framebuffer for PageBlit; false while rotated (GFX only then)
+    bool blitFrame(PageBlit::Frame& out) const;
+    // Serial report of drawTimerRow cost per style (build with -DUI_BLIT_BENCHMARK)
+    void benchmarkTimerRows() const;
 };
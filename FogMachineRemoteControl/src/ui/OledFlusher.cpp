@@ -0,0 +1,125 @@
+// OledFlusher.cpp
+// Sends SSD1306 frames to the panel from a low-priority task, changed column spans only.
+#include "ui/OledFlusher.h"
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include <cstring>
+
+namespace {
+constexpr uint32_t TASK_STACK_BYTES = 2048;
+constexpr UBaseType_t TASK_PRIORITY = tskIDLE_PRIORITY + 1;
+// Re-addressing a span costs a command transaction, so changes closer than this share one
+constexpr uint8_t SPAN_MERGE_GAP = 8;
+#ifdef I2C_BUFFER_LENGTH
+constexpr size_t DATA_CHUNK = I2C_BUFFER_LENGTH - 1;
+#else
+constexpr size_t DATA_CHUNK = 31;
+#endif
+} // namespace
+
+bool OledFlusher::begin(uint8_t i2cAddr) {
+    addr = i2cAddr;
+    invalidate();
+    if (task) return true;
+    TaskHandle_t handle = nullptr;
+    if (xTaskCreate(&OledFlusher::taskEntry, "oledflush", TASK_STACK_BYTES, this, TASK_PRIORITY, &handle) != pdPASS) {
+        return false;
+    }
+    task = handle;
+    return true;
+}
+
+void OledFlusher::submit(const uint8_t* frame) {
+    if (!task) {
+        bytesSent += flushFrame(frame);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        memcpy(pending, frame, FRAME_BYTES);
+        hasPending = true;
+    }
+    xTaskNotifyGive(static_cast<TaskHandle_t>(task));
+}
+
+void OledFlusher::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    shadowValid = false;
+}
+
+void OledFlusher::taskEntry(void* arg) {
+    static_cast<OledFlusher*>(arg)->run();
+}
+
+void OledFlusher::run() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!hasPending) continue;
+            std::swap(pending, sending);
+            hasPending = false;
+        }
+        bytesSent += flushFrame(sending);
+    }
+}
+
+size_t OledFlusher::flushFrame(const uint8_t* frame) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        full = !shadowValid;
+        shadowValid = true;
+    }
+    // The buffer is page-major: byte [page * 128 + col] holds 8 vertical pixels. Send each
+    // run of changed columns per page, merging runs separated by short unchanged gaps.
+    size_t sent = 0;
+    for (uint8_t page = 0; page < 8; ++page) {
+        const uint8_t* row = frame + page * 128;
+        uint8_t* old = shadow + page * 128;
+        if (full) {
+            sent += sendSpan(page, 0, 127, row);
+            memcpy(old, row, 128);
+            continue;
+        }
+        int col = 0;
+        while (col < 128) {
+            while (col < 128 && row[col] == old[col]) ++col;
+            if (col == 128) break;
+            const int first = col;
+            int last = col;
+            for (++col; col < 128 && col - last <= SPAN_MERGE_GAP; ++col) {
+                if (row[col] != old[col]) last = col;
+            }
+            sent += sendSpan(page, (uint8_t)first, (uint8_t)last, row + first);
+            memcpy(old + first, row + first, last - first + 1);
+        }
+    }
+    return sent;
+}
+
+size_t OledFlusher::sendSpan(uint8_t page, uint8_t firstCol, uint8_t lastCol, const uint8_t* data) {
+    // One command transaction sets the window, then data streams into it. Wire locks each
+    // transaction, so commands the UI task sends in between (contrast, on/off) are safe.
+    Wire.beginTransmission(addr);
+    Wire.write((uint8_t)0x00); // Co=0, D/C=0: command stream
+    Wire.write((uint8_t)SSD1306_PAGEADDR);
+    Wire.write(page);
+    Wire.write(page);
+    Wire.write((uint8_t)SSD1306_COLUMNADDR);
+    Wire.write(firstCol);
+    Wire.write(lastCol);
+    Wire.endTransmission();
+    size_t left = (size_t)(lastCol - firstCol) + 1;
+    const size_t total = left;
+    while (left) {
+        const size_t n = left < DATA_CHUNK ? left : DATA_CHUNK;
+        Wire.beginTransmission(addr);
+        Wire.write((uint8_t)0x40); // Co=0, D/C=1: data stream
+        Wire.write(data, n);
+        Wire.endTransmission();
+        data += n;
+        left -= n;
+    }
+    return total;
+}
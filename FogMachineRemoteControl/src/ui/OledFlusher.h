@@ -0,0 +1,38 @@
+// OledFlusher.h
+// Sends SSD1306 frames to the panel from a low-priority task, changed column spans only.
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <mutex>
+
+class OledFlusher {
+public:
+    static constexpr size_t FRAME_BYTES = 128 * 64 / 8;
+
+    // Starts the flush task; without it submit() transmits on the caller's task
+    bool begin(uint8_t i2cAddr);
+    // Copies the frame and hands it to the task, so drawing the next frame overlaps sending
+    // this one. A frame still waiting when a newer one arrives is dropped.
+    void submit(const uint8_t* frame);
+    // Panel contents unknown (power-up); the next frame goes out whole
+    void invalidate();
+    // I2C payload bytes sent since the previous call
+    uint32_t takeBytesSent() { return bytesSent.exchange(0); }
+private:
+    static void taskEntry(void* arg);
+    void run();
+    size_t flushFrame(const uint8_t* frame);
+    size_t sendSpan(uint8_t page, uint8_t firstCol, uint8_t lastCol, const uint8_t* data);
+
+    uint8_t addr = 0x3C;
+    void* task = nullptr; // TaskHandle_t
+    std::mutex mutex;     // guards pending/hasPending/shadowValid
+    uint8_t frames[2][FRAME_BYTES];
+    uint8_t* pending = frames[0];
+    uint8_t* sending = frames[1];
+    bool hasPending = false;
+    // What the panel holds; only the transmitting side touches it
+    uint8_t shadow[FRAME_BYTES];
+    bool shadowValid = false;
+    std::atomic<uint32_t> bytesSent{0};
+};
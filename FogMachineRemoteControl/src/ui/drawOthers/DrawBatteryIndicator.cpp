@@ -51,6 +51,7 @@ void DisplayManager::drawBatteryIndicator(uint8_t percent) const {
         if (charging) {
             // Blink the entire battery fill to indicate charging (ignore percent)
             bool blinkOn = ((millis() / 350) % 2) == 0;
+            redrawIn(350 - (millis() % 350));
             if (blinkOn) {
                 display.fillRect(x + 1, y + 1, innerW, innerH, SSD1306_WHITE);
             } else {
@@ -16,5 +16,5 @@ void DisplayManager::drawBootStatus(const char* msg) const {
     if ((int)strlen(buf) > maxChars) buf[maxChars] = 0;
     display.setCursor(0, y);
     display.print(buf);
-    display.display();
+    present();
 }
@@ -1,15 +1,22 @@
 // DrawTimerRow.cpp
 #include "Defaults.h"
 #include <cstdio>
+#include <cstring>
 #include "ui/DisplayManager.h"
 
-void DisplayManager::drawTimerRow(int tenths, int y, const char* label, int startX) const {
+void DisplayManager::drawTimerRow(int tenths, int y, const char* label, int startX, int invertDigit, DigitStyle style) const {
     char buf[8]; int integerPart = tenths/10; int frac = tenths%10; snprintf(buf,sizeof(buf),"%04d%01d", integerPart, frac);
     display.setTextSize(2);
+    PageBlit::Frame frame;
+    if (style != DigitStyle::Gfx && !blitFrame(frame)) style = DigitStyle::Gfx;
     int x = startX; int digitW = Defaults::UI_DIGIT_WIDTH;
-    for (int i=0;i<5;i++) {
-        display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
-        display.fillRect(x,y,digitW,16,SSD1306_BLACK);
+    // test_page_blit checks the blitter against this GFX loop and golden rows on the host
+    if (style == DigitStyle::Blit) PageBlit::timerDigits(frame, startX, y, buf, 5, 3, digitW, invertDigit);
+    else if (style == DigitStyle::Segment) PageBlit::timerSegments(frame, startX, y, buf, 5, 3, digitW, invertDigit);
+    else for (int i=0;i<5;i++) {
+        const bool inv = (i == invertDigit);
+        if (inv) { display.setTextColor(SSD1306_BLACK, SSD1306_WHITE); display.fillRect(x,y,digitW,16,SSD1306_WHITE); }
+        else { display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.fillRect(x,y,digitW,16,SSD1306_BLACK); }
         display.setCursor(x,y);
         display.print(buf[i]);
         if (i==3) { display.print('.'); x+=digitW; }
@@ -18,3 +25,19 @@ void DisplayManager::drawTimerRow(int tenths, int y, const char* label, int star
     int labelX = startX + digitW*(5+1) + Defaults::UI_LABEL_GAP_X;
     display.setTextSize(1); display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.setCursor(labelX,y+7); display.print(label);
 }
+
+void DisplayManager::benchmarkTimerRows() const {
+    // On-device cost only; pixel equality with GFX is checked on the host by test_page_blit
+    static const char* const NAMES[] = {"gfx", "blit", "segment"};
+    constexpr int ROUNDS = 200;
+    for (int s = 0; s < 3; ++s) {
+        const DigitStyle style = static_cast<DigitStyle>(s);
+        display.clearDisplay();
+        display.setTextSize(2);
+        const unsigned long t0 = micros();
+        for (int i = 0; i < ROUNDS; ++i) drawTimerRow(12345 + i, Defaults::UI_TIMER_ROW_Y_TIME, "TIME", Defaults::UI_TIMER_START_X, i % 5, style);
+        const unsigned long us = micros() - t0;
+        Serial.printf("[BLIT] timer row %-7s %5lu us/row\n", NAMES[s], us / ROUNDS);
+    }
+    display.clearDisplay();
+}
@@ -25,6 +25,7 @@ void DisplayManager::drawMainScreen(const DeviceManager& deviceMgr, const Batter
     }
     unsigned long now = millis();
     bool fresh = (act->lastStatusMs != 0) && (now - act->lastStatusMs < Defaults::RSSI_STALE_MS);
+    if (fresh) redrawIn(act->lastStatusMs + Defaults::RSSI_STALE_MS - now); // flips to "Stale"
     {
         if (!fresh) {
             display.setTextSize(1);
@@ -80,6 +81,7 @@ void DisplayManager::drawMainScreen(const DeviceManager& deviceMgr, const Batter
         float e = act->elapsed + since;
         float cap = act->outputState ? act->ton : act->toff;
         if (e > cap) e = cap;
+        else redrawIn(Defaults::UI_TICK_MS); // TIME counts up in tenths
         drawTimerRow((int)(e*10.0f + 0.5f), Defaults::UI_TIMER_ROW_Y_TIME,  "TIME",  Defaults::UI_TIMER_START_X);
     }
     display.setTextSize(2); if (act->outputState) { display.setCursor(0, Defaults::UI_STATE_CHAR_Y); display.print('*'); }
@@ -40,19 +40,10 @@ void DisplayManager::drawMenu(const MenuSystem& menu, const DeviceManager& devic
         display.setCursor(0,40); display.println("#=Save  *=Back");
         return;
     } else if (menu.getMode() == MenuSystem::Mode::EDIT_TIMERS) {
-        auto drawTimerRowEdit = [&](int tenths, int y, const char* label, int startDigit){
-            char buf[8]; int integerPart = tenths/10; int frac = tenths%10; snprintf(buf,sizeof(buf),"%04d%01d", integerPart, frac);
-            display.setTextSize(2);
-            int startX = Defaults::UI_TIMER_START_X; int digitW = Defaults::UI_DIGIT_WIDTH; int x=startX;
-            for (int i=0;i<5;i++) {
-                bool inv = ((i+startDigit)==menu.getEditDigitIndex());
-                if (inv) { display.setTextColor(SSD1306_BLACK, SSD1306_WHITE); display.fillRect(x,y,digitW,16,SSD1306_WHITE);} else { display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.fillRect(x,y,digitW,16,SSD1306_BLACK);} display.setCursor(x,y); display.print(buf[i]); if (i==3) { display.print('.'); x+=digitW;} x+=digitW;
-            }
-            int labelX = startX + digitW*(5+1) + Defaults::UI_LABEL_GAP_X;
-            display.setTextSize(1); display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.setCursor(labelX,y+7); display.print(label);
-        };
-        drawTimerRowEdit(menu.getEditToffTenths(), Defaults::UI_TIMER_ROW_Y_OFF, "Toff", 0);
-        drawTimerRowEdit(menu.getEditTonTenths(),  Defaults::UI_TIMER_ROW_Y_ON,  "Ton",  5);
+        // Digits 0-4 edit Toff, 5-9 Ton
+        const int editDigit = menu.getEditDigitIndex();
+        drawTimerRow(menu.getEditToffTenths(), Defaults::UI_TIMER_ROW_Y_OFF, "Toff", Defaults::UI_TIMER_START_X, editDigit);
+        drawTimerRow(menu.getEditTonTenths(),  Defaults::UI_TIMER_ROW_Y_ON,  "Ton",  Defaults::UI_TIMER_START_X, editDigit - 5);
         display.setTextSize(1); display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.setCursor(0,54); display.print("#=Next *=Cancel");
         return;
     } else if (menu.getMode() == MenuSystem::Mode::PAIRING) {
@@ -68,14 +59,14 @@ void DisplayManager::drawMenu(const MenuSystem& menu, const DeviceManager& devic
             if (highlight) { display.fillRect(0,y,128,10,SSD1306_WHITE); display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);} else { display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);}                
             display.setCursor(2,y);
             char macBuf[18]; snprintf(macBuf,sizeof(macBuf),"%02X%02X%02X", d.mac[3],d.mac[4],d.mac[5]);
-            bool already=false; for(int p=0;p<deviceMgr.getDeviceCount();++p){ if (memcmp(deviceMgr.getDevice(p).mac,d.mac,6)==0){already=true;break;} }
+            bool already = deviceMgr.findDeviceByMac(d.mac) >= 0;
             char line[32]; snprintf(line,sizeof(line),"%c%s %s",already?'*':' ', macBuf, d.name[0]?d.name:"(noname)");
             display.print(line);
         }
         display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
         if (count>0) {
             const auto &d = comm->getDiscovered(sel);
-            bool already=false; for(int p=0;p<deviceMgr.getDeviceCount();++p){ if (memcmp(deviceMgr.getDevice(p).mac,d.mac,6)==0){already=true;break;} }
+            bool already = deviceMgr.findDeviceByMac(d.mac) >= 0;
             display.setCursor(0,54); display.print("#="); display.print(already?"Unpair":"Pair"); display.print(" *=Back");
         } else {
             display.setCursor(0,14); display.println("Scanning...");
@@ -261,6 +252,42 @@ void DisplayManager::drawMenu(const MenuSystem& menu, const DeviceManager& devic
         }
         display.setCursor(0,57); display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.print("Up/Down scroll  *=Back  #=Refresh");
         return;
+    } else if (menu.getMode() == MenuSystem::Mode::DASHBOARD) {
+        // Fleet dashboard: one row per paired timer with output state and elapsed time,
+        // kept fresh by the slotted status sweep
+        display.setCursor(0,0); display.setTextColor(SSD1306_WHITE); display.println("Dashboard"); display.drawLine(0,9,127,9,SSD1306_WHITE);
+        auto *cm = CommManager::get();
+        int count = cm ? cm->getPairedCount() : 0;
+        if (count == 0) { display.setCursor(0,14); display.println("No devices"); display.setCursor(0,26); display.println("*=Back"); return; }
+        int activeIdx = -1; if (cm->getActiveDevice()) activeIdx = cm->getActiveDevice() - &cm->getPaired(0);
+        int first = menu.getDashFirst(); if (first > count-1) first = count-1; if (first < 0) first = 0;
+        unsigned long nowMs = millis();
+        for (int i=0;i<4;i++) {
+            int idx = first + i; if (idx >= count) break;
+            const auto &d = cm->getPaired(idx);
+            int y = 12 + i*10;
+            char name[10]; strncpy(name, d.name[0]?d.name:"(noname)", sizeof(name)-1); name[sizeof(name)-1]=0;
+            display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
+            display.setCursor(2, y);
+            display.print((idx==activeIdx)?'*':' ');
+            display.print(name);
+            bool stale = d.lastStatusMs == 0 || (nowMs - d.lastStatusMs) > Defaults::RSSI_STALE_MS;
+            char buf[12];
+            if (stale) {
+                strcpy(buf, "--");
+            } else {
+                // Inverted ON badge keeps the state readable at a glance
+                if (d.outputState) { display.fillRect(64, y-1, 20, 9, SSD1306_WHITE); display.setTextColor(SSD1306_BLACK, SSD1306_WHITE); }
+                display.setCursor(66, y); display.print(d.outputState ? "ON" : "off");
+                display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
+                float elapsed = d.elapsed + (nowMs - d.lastStatusMs) / 1000.0f;
+                redrawIn(Defaults::UI_TICK_MS);
+                snprintf(buf, sizeof(buf), "%.1fs", (double)elapsed);
+            }
+            int w = (int)strlen(buf) * 6; display.setCursor(127 - w, y); display.print(buf);
+        }
+        display.setCursor(0,54); display.setTextColor(SSD1306_WHITE, SSD1306_BLACK); display.print("Up/Dn  #=Refresh *=Back");
+        return;
     } else if (menu.getMode() == MenuSystem::Mode::BATTERY_CALIB) {
         // Battery calibration UI with inverted highlight on the active field and live ADC display
         display.setCursor(0,0); display.setTextColor(SSD1306_WHITE); display.println("Battery Cal"); display.drawLine(0,9,127,9,SSD1306_WHITE);
@@ -345,6 +372,7 @@ void DisplayManager::drawMenu(const MenuSystem& menu, const DeviceManager& devic
         float scrollProgress = 1.0f;
         int prevScroll = menu.getPrevScrollOffset();
         int dir = menu.getScrollAnimDir();
+        if (scrollAnim || selAnim) redrawIn(Defaults::UI_FRAME_MIN_MS);
         if (scrollAnim) {
             unsigned long dt = millis() - menu.getScrollAnimStart();
             if (dt > MenuSystem::SCROLL_ANIM_MS) dt = MenuSystem::SCROLL_ANIM_MS;
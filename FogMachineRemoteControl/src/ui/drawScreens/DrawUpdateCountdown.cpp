@@ -30,5 +30,5 @@ void DisplayManager::drawUpdateCountdown(uint8_t secondsRemaining) const {
         display.setCursor(x, y);
         display.print(buf);
     }
-    display.display();
+    present();
 }
@@ -11,6 +11,10 @@
 
 namespace Defaults {
 	static constexpr uint8_t DEFAULT_CHANNEL = 1;
+	// Relay outputs per timer: 0 = fog relay, 1.. = auxiliary (pump, heater enable, fan)
+	static constexpr uint8_t MAX_OUTPUTS = 4;
+	static constexpr float AUX_DEFAULT_TON = 0.0f;    // aux outputs idle (OFF) until programmed
+	static constexpr float AUX_DEFAULT_TOFF = 10.0f;
 	// Hardware Pins (ESP32-C3 Seeed XIAO) - replicate for symmetry; adjust if hardware diverges
 	static constexpr int RELAY_PIN = 2;
 	static constexpr int BTN_UP = 3;
@@ -38,6 +42,12 @@ namespace Defaults {
 	static constexpr unsigned long MENU_FULL_BLINK_INTERVAL_MS = 400;
 	static constexpr unsigned long MENU_RESULT_TIMEOUT_MS = 5000;
 	static constexpr unsigned long LOOP_DELAY_MS = 10;
+	// Tickless loop: longest sleep without an event (housekeeping safety net)
+	static constexpr uint32_t LOOP_IDLE_MAX_MS = 1000;
+	// Config write-back: flush after this long without a new change, and never later than
+	// MAX_DELAY after the first unflushed one (the window a power cut can lose)
+	static constexpr uint32_t CONFIG_FLUSH_QUIET_MS = 1000;
+	static constexpr uint32_t CONFIG_FLUSH_MAX_DELAY_MS = 5000;
 
 	inline const char* VERSION() { return "FogMachineTimer v1.0"; }
 }
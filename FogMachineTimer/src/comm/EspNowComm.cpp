@@ -1,18 +1,28 @@
 // EspNowComm.cpp
 // Handles ESP-NOW communication and protocol command processing.
 #include "EspNowComm.h"
+#include "EspNowRx.h"
 #include <WiFi.h>
 #include <esp_now.h>
 #include <esp_wifi.h>
-#include <EEPROM.h>
 #include <algorithm>
 #include <cstring>
+#include <cmath>
 #include <cstdint>
 
 
 namespace {
-constexpr uint16_t TIMER_EEPROM_SIZE = 256;
 constexpr uint32_t CHANNEL_APPLY_GRACE_MS = 150;
+constexpr uint8_t GROUP_DEFAULT_SLOT_MS = 8;
+constexpr uint32_t GROUP_RANDOM_WINDOW_MS = 120; // reply spread for timers without a slot
+// Frames waiting for loop(); a full queue drops the frame and the sender's retry brings it back
+constexpr UBaseType_t RX_QUEUE_DEPTH = 8;
+static_assert(sizeof(PatternMsg::code) == PatternProgram::MAX_BYTES, "PatternMsg must carry a whole program");
+static_assert(DebugProtocol::EdgeTimingPayload::kMaxEntries == TimerController::EDGE_HISTORY &&
+              DebugProtocol::EdgeTimingPayload::kBuckets == TimerController::LATENESS_BUCKETS,
+              "edge timing payload must mirror the timer's history");
+static_assert(sizeof(DebugProtocol::EdgeTimingPayload) <= DebugProtocol::MAX_DATA_BYTES, "edge timing must fit one packet");
+static_assert(sizeof(PulseMsg::durUs) / sizeof(uint16_t) == PulseOutput::MAX_DURATIONS, "PulseMsg must match one RMT block");
 const char* cmdToString(ProtocolCmd cmd) {
     switch (cmd) {
         case ProtocolCmd::PAIR: return "PAIR";
@@ -26,6 +36,18 @@ const char* cmdToString(ProtocolCmd cmd) {
         case ProtocolCmd::TOGGLE_STATE: return "TOGGLE_STATE";
         case ProtocolCmd::FACTORY_RESET: return "FACTORY_RESET";
         case ProtocolCmd::SET_CHANNEL: return "SET_CHANNEL";
+        case ProtocolCmd::SYNC_PHASE: return "SYNC_PHASE";
+        case ProtocolCmd::SYNC_CLOCK: return "SYNC_CLOCK";
+        case ProtocolCmd::SET_GROUP: return "SET_GROUP";
+        case ProtocolCmd::GROUP_CMD: return "GROUP_CMD";
+        case ProtocolCmd::GROUP_ACK: return "GROUP_ACK";
+        case ProtocolCmd::STATUS_SWEEP: return "STATUS_SWEEP";
+        case ProtocolCmd::CONFIGURE: return "CONFIGURE";
+        case ProtocolCmd::OUTPUT_CMD: return "OUTPUT_CMD";
+        case ProtocolCmd::OUTPUT_STATUS: return "OUTPUT_STATUS";
+        case ProtocolCmd::PATTERN: return "PATTERN";
+        case ProtocolCmd::CUE: return "CUE";
+        case ProtocolCmd::PULSE: return "PULSE";
         default: return "UNKNOWN";
     }
 }
@@ -54,21 +76,23 @@ ProtocolCmd contextToCmd(void* ctx) {
 
 EspNowComm* EspNowComm::instance = nullptr;
 volatile int8_t EspNowComm::lastRxRssi = 0;
-uint8_t EspNowComm::lastSenderMac[6] = {0};
 
 
-EspNowComm::EspNowComm(TimerController& timerRef, DeviceConfig& configRef, TimerChannelSettings& channelRef)
-    : timer(timerRef), config(configRef), channelSettings(channelRef) {}
+EspNowComm::EspNowComm(TimerController& timerRef, DeviceConfig& configRef, TimerChannelSettings& channelRef, TimerGroupSettings& groupRef, OutputSettings& outputRef, PatternStore& patternRef, ConfigLog::Store& storeRef)
+    : timer(timerRef), config(configRef), channelSettings(channelRef), groupSettings(groupRef), outputSettings(outputRef), patternStore(patternRef), configStore(storeRef) {}
 
 void EspNowComm::begin() {
     instance = this;
+    if (!rxQueue) rxQueue = xQueueCreate(RX_QUEUE_DEPTH, sizeof(RxFrame));
     WiFi.mode(WIFI_STA);
     WiFi.disconnect();
     if (esp_now_init() != ESP_OK) {
         Serial.println("ESP-NOW init failed");
     }
     channelSettings.apply();
-    esp_now_register_recv_cb(EspNowComm::onDataRecv);
+    esp_wifi_get_mac(WIFI_IF_STA, ownMac_);
+    ReliableEspNow::registerReceive(&EspNowComm::onDataRecv);
+    ReliableEspNow::captureRssi(true); // STATUS reports the RSSI of every remote frame
     reliableLink.begin();
     reliableLink.setReceiveHandler([this](const uint8_t* mac, const uint8_t* payload, size_t len) {
         return handleFrame(mac, payload, len);
@@ -110,25 +134,53 @@ void EspNowComm::begin() {
     reliableLink.setEnsurePeerCallback([this](const uint8_t* mac) {
         ensurePeer(mac);
     });
-    // Enable promiscuous mode to read RSSI of incoming frames
-    esp_wifi_set_promiscuous(true);
-    esp_wifi_set_promiscuous_rx_cb(&EspNowComm::wifiSniffer);
 }
 
 void EspNowComm::loop() {
+    RxFrame frame;
+    while (rxQueue && xQueueReceive(rxQueue, &frame, 0) == pdTRUE) {
+        // Status replies go back to this sender, so its frame's RSSI is the one to report
+        if (frame.rssi) lastRxRssi = frame.rssi;
+        reliableLink.onReceive(frame.mac, frame.data, frame.len);
+    }
     reliableLink.loop();
     // Push status to the last known sender when the output state changes
     pushStatusIfStateChanged();
     processPendingChannelChange();
+    processPendingGroupAck();
+    processPendingSweepReply();
 }
 
 int8_t EspNowComm::getRssi() const {
     return WiFi.RSSI();
 }
 
-void EspNowComm::onDataRecv(const uint8_t* mac, const uint8_t* data, int len) {
-    if (!instance) return;
-    instance->reliableLink.onReceive(mac, data, len);
+uint32_t EspNowComm::msUntilNextWork() const {
+    if (rxQueue && uxQueueMessagesWaiting(rxQueue)) return 0;
+    const uint32_t now = millis();
+    uint32_t wait = reliableLink.msUntilNextDeadline(now);
+    auto due = [&](bool pending, uint32_t atMs) {
+        if (!pending) return;
+        const int32_t left = static_cast<int32_t>(atMs - now);
+        const uint32_t ms = left > 0 ? static_cast<uint32_t>(left) : 0;
+        if (ms < wait) wait = ms;
+    };
+    due(pendingChannelChange_, pendingChannelApplyAtMs_);
+    due(pendingGroupAck_, pendingGroupAckAtMs_);
+    due(pendingSweepReply_, pendingSweepAtMs_);
+    return wait;
+}
+
+void EspNowComm::onDataRecv(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi) {
+    if (!instance || !instance->rxQueue || !mac || !data || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return;
+    // The handlers change the timer's schedule, so they run on the loop task, never here
+    RxFrame frame;
+    memcpy(frame.mac, mac, sizeof(frame.mac));
+    frame.rssi = rssi;
+    frame.len = static_cast<uint8_t>(len);
+    memcpy(frame.data, data, static_cast<size_t>(len));
+    if (xQueueSend(instance->rxQueue, &frame, 0) != pdTRUE) return;
+    if (instance->wakeTask) xTaskNotifyGive(instance->wakeTask);
 }
 
 void EspNowComm::sendStatus(const uint8_t* mac, bool requireAck) {
@@ -140,9 +192,13 @@ void EspNowComm::sendStatus(const uint8_t* mac, bool requireAck) {
     strncpy(reply.name, config.getName(), sizeof(reply.name)-1);
     reply.outputOverride = timer.isOutputOn();
     reply.resetState = false;
-    // Prefer captured RSSI from sniffer for the last sender if available
+    // Prefer the RSSI of the sender's last frame when the radio reported one
     reply.rssiAtTimer = lastRxRssi ? lastRxRssi : getRssi();
     reply.channel = channelSettings.getChannel();
+    reply.flags = ProtocolFlags::GroupInfo;
+    if (timer.isPhaseLocked()) reply.flags |= ProtocolFlags::PhaseLocked;
+    reply.groupMask = groupSettings.getGroupMask();
+    reply.groupSlot = groupSettings.getSlot();
     ReliableProtocol::SendConfig cfg;
     cfg.requireAck = requireAck;
     cfg.retryIntervalMs = 200;
@@ -168,6 +224,54 @@ ReliableProtocol::HandlerResult EspNowComm::handleFrame(const uint8_t* mac, cons
         return handleDebugPacket(mac, packet);
     }
 
+    if (len == sizeof(PhaseSyncMsg) &&
+        (payload[0] == static_cast<uint8_t>(ProtocolCmd::SYNC_PHASE) || payload[0] == static_cast<uint8_t>(ProtocolCmd::SYNC_CLOCK))) {
+        PhaseSyncMsg sync = {};
+        memcpy(&sync, payload, sizeof(sync));
+        return processPhaseSync(sync, mac);
+    }
+
+    if (len >= STATUS_SWEEP_HEADER_BYTES && payload[0] == static_cast<uint8_t>(ProtocolCmd::STATUS_SWEEP)) {
+        return processStatusSweep(payload, len, mac);
+    }
+
+    if (len == sizeof(GroupMsg) &&
+        (payload[0] == static_cast<uint8_t>(ProtocolCmd::SET_GROUP) || payload[0] == static_cast<uint8_t>(ProtocolCmd::GROUP_CMD))) {
+        GroupMsg group = {};
+        memcpy(&group, payload, sizeof(group));
+        return processGroup(group, mac);
+    }
+
+    if (len == sizeof(ConfigureMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::CONFIGURE)) {
+        ConfigureMsg configure = {};
+        memcpy(&configure, payload, sizeof(configure));
+        return processConfigure(configure, mac);
+    }
+
+    if (len == sizeof(OutputMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::OUTPUT_CMD)) {
+        OutputMsg output = {};
+        memcpy(&output, payload, sizeof(output));
+        return processOutput(output, mac);
+    }
+
+    if (len == sizeof(PatternMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::PATTERN)) {
+        PatternMsg pattern = {};
+        memcpy(&pattern, payload, sizeof(pattern));
+        return processPattern(pattern, mac);
+    }
+
+    if (len == sizeof(PulseMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::PULSE)) {
+        PulseMsg pulse = {};
+        memcpy(&pulse, payload, sizeof(pulse));
+        return processPulse(pulse, mac);
+    }
+
+    if (len == sizeof(CueMsg) && payload[0] == static_cast<uint8_t>(ProtocolCmd::CUE)) {
+        CueMsg cue = {};
+        memcpy(&cue, payload, sizeof(cue));
+        return processCue(cue, mac);
+    }
+
     if (len != sizeof(ProtocolMsg)) {
         Serial.printf("[SLAVE] Dropping payload len=%u (expected %u)\n",
                       static_cast<unsigned>(len), static_cast<unsigned>(sizeof(ProtocolMsg)));
@@ -181,23 +285,9 @@ ReliableProtocol::HandlerResult EspNowComm::handleFrame(const uint8_t* mac, cons
     ProtocolCmd cmd = static_cast<ProtocolCmd>(msg.cmd);
     Serial.printf("[SLAVE] RX %s from %02X:%02X:%02X:%02X:%02X:%02X len=%u\n",
                   cmdToString(cmd), mac[0],mac[1],mac[2],mac[3],mac[4],mac[5], static_cast<unsigned>(len));
-    memcpy(lastSenderMac, mac, 6);
     return processCommand(msg, mac);
 }
 
-// Static sniffer callback to capture RSSI
-void EspNowComm::wifiSniffer(void* buf, wifi_promiscuous_pkt_type_t type) {
-    if (type != WIFI_PKT_MGMT && type != WIFI_PKT_DATA) return;
-    const wifi_promiscuous_pkt_t* pkt = (const wifi_promiscuous_pkt_t*)buf;
-    if (!pkt) return;
-    // Source MAC is at payload+10 for 802.11 header (addr2)
-    if (pkt->rx_ctrl.sig_len < 16) return;
-    const uint8_t* src = pkt->payload + 10;
-    if (memcmp(src, lastSenderMac, 6) == 0) {
-        lastRxRssi = pkt->rx_ctrl.rssi;
-    }
-}
-
 void EspNowComm::ensurePeer(const uint8_t* mac) {
     if (!mac) return;
     if (!esp_now_is_peer_exist(mac)) {
@@ -220,6 +310,11 @@ ReliableProtocol::HandlerResult EspNowComm::processCommand(const ProtocolMsg& ms
             sendStatus(mac, true);
             break;
         case ProtocolCmd::SET_TIMER:
+            if (!std::isfinite(msg.ton) || !std::isfinite(msg.toff) || msg.ton < 0.f || msg.toff < 0.f) {
+                result.ack = false;
+                result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+                break;
+            }
             config.saveTimer(msg.ton, msg.toff);
             timer.setTimes(msg.ton, msg.toff);
             sendStatus(mac, true);
@@ -246,7 +341,7 @@ ReliableProtocol::HandlerResult EspNowComm::processCommand(const ProtocolMsg& ms
                 result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
                 break;
             }
-            bool persist = (msg.reserved[0] & ProtocolFlags::ChannelPersist) != 0;
+            bool persist = (msg.flags & ProtocolFlags::ChannelPersist) != 0;
             bool pendingSame = pendingChannelChange_ && pendingChannelValue_ == msg.channel && pendingChannelPersist_ == persist;
             bool storedUpdated = persist ? channelSettings.storeChannel(msg.channel) : false;
 
@@ -272,10 +367,20 @@ ReliableProtocol::HandlerResult EspNowComm::processCommand(const ProtocolMsg& ms
             break;
         }
         case ProtocolCmd::FACTORY_RESET:
-            Serial.println("[SLAVE] FACTORY_RESET -> wiping EEPROM and restoring defaults");
+            Serial.println("[SLAVE] FACTORY_RESET -> restoring default settings");
             config.factoryReset();
             timer.setTimes(config.getTon(), config.getToff());
+            outputSettings.resetToDefault();
+            patternStore.resetToDefault();
+            for (uint8_t output = 1; output < timer.getOutputCount(); ++output) {
+                timer.setTimes(outputSettings.getTon(output), outputSettings.getToff(output), output);
+            }
+            for (uint8_t output = 0; output < timer.getOutputCount(); ++output) {
+                timer.clearPattern(output);
+                timer.setPulseTrain(output, nullptr, 0);
+            }
             channelSettings.resetToDefault();
+            groupSettings.resetToDefault();
             sendStatus(mac, true);
             break;
         case ProtocolCmd::GET_RSSI:
@@ -289,6 +394,356 @@ ReliableProtocol::HandlerResult EspNowComm::processCommand(const ProtocolMsg& ms
     return result;
 }
 
+ReliableProtocol::HandlerResult EspNowComm::processConfigure(const ConfigureMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    const bool setName = (msg.ops & ConfigureOps::Name) != 0;
+    const bool setTimer = (msg.ops & ConfigureOps::Timer) != 0;
+    const bool setChannel = (msg.ops & ConfigureOps::Channel) != 0;
+    Serial.printf("[SLAVE] RX CONFIGURE ops=0x%02X from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                  msg.ops, mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+
+    // Validate every op before applying any, so a rejected frame leaves nothing half-written
+    if (msg.ops == 0 || (msg.ops & ~ConfigureOps::All) != 0) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::UNSUPPORTED);
+        return result;
+    }
+    if ((setTimer && (!std::isfinite(msg.ton) || !std::isfinite(msg.toff) || msg.ton < 0.f || msg.toff < 0.f)) ||
+        (setChannel && !channelSettings.isChannelSupported(msg.channel))) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+        return result;
+    }
+
+    ConfigLog::Batch batch;
+    bool dirty = false;
+    if (setName) {
+        char name[sizeof(msg.name)] = {};
+        memcpy(name, msg.name, sizeof(name) - 1);
+        config.saveName(name, &batch);
+        dirty = true;
+    }
+    if (setTimer) {
+        config.saveTimer(msg.ton, msg.toff, &batch);
+        timer.setTimes(msg.ton, msg.toff);
+        dirty = true;
+    }
+    bool channelMoves = false;
+    if (setChannel) {
+        dirty |= channelSettings.storeChannel(msg.channel, &batch);
+        channelMoves = pendingChannelChange_ || channelSettings.getChannel() != msg.channel;
+    }
+    if (dirty) {
+        configStore.commit(batch); // one atomic log commit for the whole frame
+    }
+
+    // Exactly one STATUS: after the channel hop if there is one, otherwise right away
+    if (channelMoves) {
+        scheduleChannelApply(msg.channel, mac, true, true);
+    } else {
+        sendStatus(mac, true);
+    }
+    return result;
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processOutput(const OutputMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    const ProtocolCmd op = static_cast<ProtocolCmd>(msg.op);
+    Serial.printf("[SLAVE] RX OUTPUT_CMD output=%u op=%s from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                  msg.output, cmdToString(op), mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+    if (!timer.isValidOutput(msg.output)) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+        return result;
+    }
+    switch (op) {
+        case ProtocolCmd::STATUS:
+            break;
+        case ProtocolCmd::SET_TIMER:
+            if (!std::isfinite(msg.ton) || !std::isfinite(msg.toff) || msg.ton < 0.f || msg.toff < 0.f) {
+                result.ack = false;
+                result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+                return result;
+            }
+            // Output 0 keeps its original home so STATUS and older remotes see the same values
+            if (msg.output == 0) {
+                config.saveTimer(msg.ton, msg.toff);
+            } else if (!outputSettings.store(msg.output, msg.ton, msg.toff)) {
+                result.ack = false;
+                result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+                return result;
+            }
+            timer.setTimes(msg.ton, msg.toff, msg.output);
+            break;
+        case ProtocolCmd::OVERRIDE_OUTPUT:
+            timer.overrideOutput(msg.outputOn != 0, msg.output);
+            break;
+        case ProtocolCmd::RESET_STATE:
+            timer.resetState(msg.output);
+            break;
+        case ProtocolCmd::TOGGLE_STATE:
+            timer.toggleAndReset(msg.output);
+            break;
+        default:
+            result.ack = false;
+            result.status = static_cast<uint8_t>(ProtocolStatus::UNSUPPORTED);
+            return result;
+    }
+    sendOutputStatus(mac, msg.output, ProtocolStatus::OK);
+    return result;
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processPattern(const PatternMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    Serial.printf("[SLAVE] RX PATTERN output=%u op=%u len=%u from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                  msg.output, msg.op, msg.length, mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+    if (!timer.isValidOutput(msg.output)) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+        return result;
+    }
+    switch (msg.op) {
+        case PatternOps::Load:
+            if (msg.length > sizeof(msg.code) || !timer.setPattern(msg.output, msg.code, msg.length)) {
+                result.ack = false;
+                result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+                return result;
+            }
+            patternStore.store(msg.output, msg.code, msg.length);
+            break;
+        case PatternOps::Clear:
+            timer.clearPattern(msg.output);
+            patternStore.clear(msg.output);
+            break;
+        case PatternOps::Restart:
+            timer.resetState(msg.output);
+            break;
+        case PatternOps::Trigger:
+            timer.triggerPattern(msg.output);
+            break;
+        default:
+            result.ack = false;
+            result.status = static_cast<uint8_t>(ProtocolStatus::UNSUPPORTED);
+            return result;
+    }
+    sendOutputStatus(mac, msg.output, ProtocolStatus::OK);
+    return result;
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processPulse(const PulseMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    Serial.printf("[SLAVE] RX PULSE output=%u count=%u from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                  msg.output, msg.count, mac[0],mac[1],mac[2],mac[3],mac[4],mac[5]);
+    uint16_t durUs[PulseOutput::MAX_DURATIONS];
+    memcpy(durUs, msg.durUs, sizeof(durUs)); // aligned copy of the packed field
+    if (!timer.isValidOutput(msg.output) || (msg.count && !PulseOutput::isValidTrain(durUs, msg.count))) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+        return result;
+    }
+    if (!timer.setPulseTrain(msg.output, durUs, msg.count)) {
+        // Every RMT channel already serves another output
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::BUSY);
+        return result;
+    }
+    sendOutputStatus(mac, msg.output, ProtocolStatus::OK);
+    return result;
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processCue(const CueMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    if (msg.op == CueOps::Clear) {
+        Serial.printf("[SLAVE] RX CUE clear (%u pending)\n", timer.getPendingCues());
+        timer.clearCues();
+        return result;
+    }
+    if (msg.op != CueOps::Add) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ProtocolStatus::UNSUPPORTED);
+        return result;
+    }
+    const TimerController::CueResult queued =
+        timer.scheduleCue(msg.id, msg.output, msg.action, msg.atMs, msg.durationMs, millis());
+    Serial.printf("[SLAVE] RX CUE id=%u output=%u action=%u at=%lu -> %u (%u pending)\n",
+                  msg.id, msg.output, msg.action, static_cast<unsigned long>(msg.atMs),
+                  static_cast<unsigned>(queued), timer.getPendingCues());
+    switch (queued) {
+        case TimerController::CueResult::Queued:
+        case TimerController::CueResult::Duplicate: // retry of a cue we already hold: ACK again
+            break;
+        case TimerController::CueResult::NoClock: // no SYNC_CLOCK yet; the remote beacons and retries
+        case TimerController::CueResult::Full:
+            result.ack = false;
+            result.status = static_cast<uint8_t>(ProtocolStatus::BUSY);
+            break;
+        case TimerController::CueResult::Late:
+        case TimerController::CueResult::Invalid:
+            result.ack = false;
+            result.status = static_cast<uint8_t>(ProtocolStatus::INVALID_PARAM);
+            break;
+    }
+    return result;
+}
+
+void EspNowComm::sendOutputStatus(const uint8_t* mac, uint8_t output, ProtocolStatus status) {
+    OutputMsg reply = {};
+    reply.cmd = static_cast<uint8_t>(ProtocolCmd::OUTPUT_STATUS);
+    reply.output = output;
+    reply.outputCount = timer.getOutputCount();
+    reply.ton = timer.getTon(output);
+    reply.toff = timer.getToff(output);
+    reply.elapsed = timer.getCurrentStateSeconds(output);
+    reply.outputOn = timer.isOutputOn(output) ? 1 : 0;
+    reply.overrideActive = timer.isOverrideActive(output) ? 1 : 0;
+    reply.status = static_cast<uint8_t>(status);
+    if (timer.isPatternActive(output)) reply.flags |= OutputFlags::Pattern;
+    if (timer.isPatternHolding(output)) reply.flags |= OutputFlags::Holding;
+    if (timer.isPulseOutput(output)) reply.flags |= OutputFlags::Pulse;
+    ReliableProtocol::SendConfig cfg;
+    cfg.requireAck = true;
+    cfg.retryIntervalMs = 200;
+    cfg.maxAttempts = 5;
+    cfg.tag = "OUTPUT_STATUS";
+    cfg.userContext = cmdContext(ProtocolCmd::OUTPUT_STATUS);
+    reliableLink.sendStruct(mac, reply, cfg);
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processPhaseSync(const PhaseSyncMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    if (msg.cmd == static_cast<uint8_t>(ProtocolCmd::SYNC_CLOCK)) {
+        // Fire-and-forget beacon: stamped at transmit, so adopt it as-is
+        timer.syncClock(msg.remoteMs, millis());
+        return result;
+    }
+    if (msg.flags & PhaseSyncFlags::Enable) {
+        Serial.printf("[SLAVE] SYNC_PHASE epoch=%lu offset=%lu\n",
+                      static_cast<unsigned long>(msg.epochMs), static_cast<unsigned long>(msg.phaseOffsetMs));
+        timer.setPhaseLock(msg.epochMs, msg.phaseOffsetMs);
+    } else {
+        Serial.println("[SLAVE] SYNC_PHASE -> free-run");
+        timer.clearPhaseLock();
+    }
+    sendStatus(mac, true);
+    return result;
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processGroup(const GroupMsg& msg, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    if (msg.cmd == static_cast<uint8_t>(ProtocolCmd::SET_GROUP)) {
+        groupSettings.store(msg.groupMask, msg.slot);
+        Serial.printf("[SLAVE] SET_GROUP mask=0x%02X slot=%u\n", msg.groupMask, msg.slot);
+        sendStatus(mac, true);
+        return result;
+    }
+    if (!groupSettings.isMember(msg.groupMask)) {
+        return result;
+    }
+    // A repeated seq only re-arms the reply; the command has already been applied
+    bool duplicate = lastGroupSeqValid_ && msg.seq == lastGroupSeq_;
+    if (!duplicate) {
+        ProtocolStatus status = ProtocolStatus::OK;
+        switch (static_cast<ProtocolCmd>(msg.op)) {
+            case ProtocolCmd::SET_TIMER:
+                // Rejected in the GROUP_ACK status like the unicast paths, never stored
+                if (!std::isfinite(msg.ton) || !std::isfinite(msg.toff) || msg.ton < 0.f || msg.toff < 0.f) {
+                    status = ProtocolStatus::INVALID_PARAM;
+                    break;
+                }
+                config.saveTimer(msg.ton, msg.toff);
+                timer.setTimes(msg.ton, msg.toff);
+                break;
+            case ProtocolCmd::OVERRIDE_OUTPUT:
+                timer.overrideOutput(msg.outputOverride != 0);
+                break;
+            case ProtocolCmd::RESET_STATE:
+                timer.resetState();
+                break;
+            case ProtocolCmd::TOGGLE_STATE:
+                timer.toggleAndReset();
+                break;
+            default:
+                status = ProtocolStatus::UNSUPPORTED;
+                break;
+        }
+        // The GROUP_ACK carries the new state; skip the broadcast STATUS every member would send
+        timer.consumeStateChanged();
+        lastGroupSeq_ = msg.seq;
+        lastGroupStatus_ = static_cast<uint8_t>(status);
+        lastGroupSeqValid_ = true;
+        Serial.printf("[SLAVE] GROUP_CMD seq=%u op=%s status=%s\n", msg.seq,
+                      cmdToString(static_cast<ProtocolCmd>(msg.op)), statusToString(status));
+    }
+    uint8_t slot = groupSettings.getSlot();
+    uint32_t delayMs;
+    if (slot != TimerGroupSettings::SLOT_NONE) {
+        uint8_t slotMs = msg.slotMs ? msg.slotMs : GROUP_DEFAULT_SLOT_MS;
+        delayMs = static_cast<uint32_t>(slot) * slotMs;
+    } else {
+        delayMs = esp_random() % GROUP_RANDOM_WINDOW_MS;
+    }
+    memcpy(pendingGroupAckMac_, mac, sizeof(pendingGroupAckMac_));
+    pendingGroupAckAtMs_ = millis() + delayMs;
+    pendingGroupAck_ = true;
+    return result;
+}
+
+void EspNowComm::processPendingGroupAck() {
+    if (!pendingGroupAck_) {
+        return;
+    }
+    if (static_cast<int32_t>(millis() - pendingGroupAckAtMs_) < 0) {
+        return;
+    }
+    pendingGroupAck_ = false;
+    GroupMsg ack = {};
+    ack.cmd = static_cast<uint8_t>(ProtocolCmd::GROUP_ACK);
+    ack.groupMask = groupSettings.getGroupMask();
+    ack.seq = lastGroupSeq_;
+    ack.ton = config.getTon();
+    ack.toff = config.getToff();
+    ack.outputOverride = timer.isOutputOn() ? 1 : 0;
+    ack.slot = groupSettings.getSlot();
+    ack.status = lastGroupStatus_;
+    // Single shot: the remote retries stragglers by unicast instead
+    ReliableProtocol::SendConfig cfg;
+    cfg.requireAck = false;
+    cfg.tag = "GROUP_ACK";
+    reliableLink.sendStruct(pendingGroupAckMac_, ack, cfg);
+}
+
+ReliableProtocol::HandlerResult EspNowComm::processStatusSweep(const uint8_t* payload, size_t len, const uint8_t* mac) {
+    ReliableProtocol::HandlerResult result;
+    StatusSweepMsg sweep = {};
+    memcpy(&sweep, payload, std::min(len, sizeof(sweep)));
+    if (sweep.count > StatusSweepMsg::kMaxEntries || len < STATUS_SWEEP_HEADER_BYTES + sweep.count * 3u) {
+        result.ack = false;
+        result.status = static_cast<uint8_t>(ReliableProtocol::Status::InvalidLength);
+        return result;
+    }
+    for (uint8_t slot = 0; slot < sweep.count; ++slot) {
+        if (memcmp(sweep.macTail[slot], ownMac_ + 3, 3) == 0) {
+            memcpy(pendingSweepMac_, mac, sizeof(pendingSweepMac_));
+            pendingSweepAtMs_ = millis() + static_cast<uint32_t>(slot) * sweep.slotMs;
+            pendingSweepReply_ = true;
+            break;
+        }
+    }
+    return result;
+}
+
+void EspNowComm::processPendingSweepReply() {
+    if (!pendingSweepReply_) {
+        return;
+    }
+    if (static_cast<int32_t>(millis() - pendingSweepAtMs_) < 0) {
+        return;
+    }
+    pendingSweepReply_ = false;
+    // Unacknowledged: the next sweep is the retry
+    sendStatus(pendingSweepMac_, false);
+}
+
 ReliableProtocol::HandlerResult EspNowComm::handleDebugPacket(const uint8_t* mac, const DebugProtocol::Packet& packet) {
     ReliableProtocol::HandlerResult result;
     DebugProtocol::Packet response = packet;
@@ -314,6 +769,31 @@ ReliableProtocol::HandlerResult EspNowComm::handleDebugPacket(const uint8_t* mac
             DebugProtocol::setData(response, &payload, sizeof(payload));
             break;
         }
+        case DebugProtocol::Command::GetEdgeTiming: {
+            // data[0] != 0: reset the counters after this read
+            TimerController::EdgeTiming timing;
+            timer.getEdgeTiming(timing, packet.dataLength >= 1 && packet.data[0] != 0);
+            DebugProtocol::EdgeTimingPayload payload = {};
+            payload.edgeCount = timing.count;
+            payload.maxLateUs = timing.maxLateUs;
+            for (uint8_t i = 0; i < DebugProtocol::EdgeTimingPayload::kBuckets; ++i) {
+                payload.histogram[i] = static_cast<uint16_t>(timing.histogram[i] > UINT16_MAX ? UINT16_MAX : timing.histogram[i]);
+            }
+            const uint8_t held = static_cast<uint8_t>(timing.count < TimerController::EDGE_HISTORY ? timing.count : TimerController::EDGE_HISTORY);
+            for (uint8_t i = 0; i < held; ++i) {
+                const TimerController::EdgeRecord& edge =
+                    timing.recent[(timing.next + TimerController::EDGE_HISTORY - 1 - i) % TimerController::EDGE_HISTORY];
+                DebugProtocol::EdgeTimingEntry& entry = payload.entries[i];
+                entry.scheduledMs = static_cast<uint32_t>(edge.scheduledUs / 1000);
+                entry.lateUs = static_cast<uint16_t>(edge.lateUs > UINT16_MAX ? UINT16_MAX : edge.lateUs);
+                entry.output = edge.output;
+                entry.flags = (edge.on ? DebugProtocol::EdgeTimingFlags::On : 0) |
+                              (edge.cue ? DebugProtocol::EdgeTimingFlags::Cue : 0);
+            }
+            payload.entryCount = held;
+            DebugProtocol::setData(response, &payload, sizeof(payload));
+            break;
+        }
         case DebugProtocol::Command::GetRssi: {
             struct RssiReport {
                 int8_t timerLocal;
@@ -359,6 +839,7 @@ ReliableProtocol::HandlerResult EspNowComm::handleDebugPacket(const uint8_t* mac
             break;
         }
         case DebugProtocol::Command::ReadConfig: {
+            // Addresses index the raw config log partition (sector headers and records)
             if (packet.dataLength < 5) {
                 response.status = DebugProtocol::Status::InvalidArgument;
                 DebugProtocol::clearData(response);
@@ -366,47 +847,22 @@ ReliableProtocol::HandlerResult EspNowComm::handleDebugPacket(const uint8_t* mac
             }
             uint16_t address = packet.data[1] | (static_cast<uint16_t>(packet.data[2]) << 8);
             uint16_t length = packet.data[3] | (static_cast<uint16_t>(packet.data[4]) << 8);
-            if (address >= TIMER_EEPROM_SIZE) {
+            if (address >= configStore.regionSize()) {
                 response.status = DebugProtocol::Status::InvalidArgument;
                 DebugProtocol::clearData(response);
                 break;
             }
             uint16_t capped = std::min<uint16_t>(length, DebugProtocol::MAX_DATA_BYTES);
-            if (address + capped > TIMER_EEPROM_SIZE) {
-                capped = TIMER_EEPROM_SIZE - address;
-            }
             uint8_t buffer[DebugProtocol::MAX_DATA_BYTES] = {0};
-            for (uint16_t i = 0; i < capped; ++i) {
-                buffer[i] = EEPROM.read(address + i);
-            }
+            capped = static_cast<uint16_t>(configStore.readRaw(address, buffer, capped));
             DebugProtocol::setData(response, buffer, capped);
             break;
         }
-        case DebugProtocol::Command::WriteConfig: {
-            if (packet.dataLength < 5) {
-                response.status = DebugProtocol::Status::InvalidArgument;
-                DebugProtocol::clearData(response);
-                break;
-            }
-            uint16_t address = packet.data[1] | (static_cast<uint16_t>(packet.data[2]) << 8);
-            uint16_t length = packet.data[3] | (static_cast<uint16_t>(packet.data[4]) << 8);
-            if (address >= TIMER_EEPROM_SIZE || length + 5 > packet.dataLength) {
-                response.status = DebugProtocol::Status::InvalidArgument;
-                DebugProtocol::clearData(response);
-                break;
-            }
-            uint16_t capped = std::min<uint16_t>(length, static_cast<uint16_t>(packet.dataLength - 5));
-            if (address + capped > TIMER_EEPROM_SIZE) {
-                capped = TIMER_EEPROM_SIZE - address;
-            }
-            const uint8_t* payload = packet.data + 5;
-            for (uint16_t i = 0; i < capped; ++i) {
-                EEPROM.write(address + i, payload[i]);
-            }
-            EEPROM.commit();
+        case DebugProtocol::Command::WriteConfig:
+            // Settings live in an append-only log now; raw byte pokes would break its CRCs
+            response.status = DebugProtocol::Status::Unsupported;
             DebugProtocol::clearData(response);
             break;
-        }
         case DebugProtocol::Command::GetDeviceInfo: {
             DebugProtocol::DeviceInfo info = {};
             info.firmwareVersion = 0x00010002;
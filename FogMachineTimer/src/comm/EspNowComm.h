@@ -2,6 +2,9 @@
 // Handles ESP-NOW communication and protocol command processing.
 #pragma once
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <esp_now.h>
 #include "protocol/Protocol.h"
 #include "ReliableEspNow.h"
 #include "ReliableProtocol.h"
@@ -9,22 +12,53 @@
 #include "timer/TimerController.h"
 #include "config/DeviceConfig.h"
 #include "config/TimerChannelSettings.h"
-#include <esp_wifi_types.h>
+#include "config/TimerGroupSettings.h"
+#include "config/OutputSettings.h"
+#include "config/PatternStore.h"
+#include "ConfigLog.h"
 
 class EspNowComm {
 public:
-    EspNowComm(TimerController& timer, DeviceConfig& config, TimerChannelSettings& channelSettings);
+    EspNowComm(TimerController& timer, DeviceConfig& config, TimerChannelSettings& channelSettings, TimerGroupSettings& groupSettings, OutputSettings& outputSettings, PatternStore& patternStore, ConfigLog::Store& configStore);
     void begin();
+    // Runs the handlers of frames received since the last call, then retries and replies
     void loop();
+    // Tickless loop support: radio RX notifies this task, and msUntilNextWork() is the time
+    // until loop() has a retry or scheduled reply due (UINT32_MAX = nothing pending)
+    void setWakeTask(TaskHandle_t task) { wakeTask = task; }
+    uint32_t msUntilNextWork() const;
     void pushStatusIfStateChanged();
     int8_t getRssi() const;
-    static void onDataRecv(const uint8_t* mac, const uint8_t* data, int len);
+    // Wi-Fi task: only copies the frame into rxQueue, so no handler touches the timer there
+    static void onDataRecv(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi);
 private:
+    struct RxFrame {
+        uint8_t mac[6];
+        int8_t rssi;
+        uint8_t len;
+        uint8_t data[ESP_NOW_MAX_DATA_LEN];
+    };
+    QueueHandle_t rxQueue = nullptr;
     TimerController& timer;
     DeviceConfig& config;
     TimerChannelSettings& channelSettings;
+    TimerGroupSettings& groupSettings;
+    OutputSettings& outputSettings;
+    PatternStore& patternStore;
+    ConfigLog::Store& configStore;
     void sendStatus(const uint8_t* mac, bool requireAck = true);
     ReliableProtocol::HandlerResult processCommand(const ProtocolMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processConfigure(const ConfigureMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processOutput(const OutputMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processPattern(const PatternMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processPulse(const PulseMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processCue(const CueMsg& msg, const uint8_t* mac);
+    void sendOutputStatus(const uint8_t* mac, uint8_t output, ProtocolStatus status);
+    ReliableProtocol::HandlerResult processPhaseSync(const PhaseSyncMsg& msg, const uint8_t* mac);
+    ReliableProtocol::HandlerResult processGroup(const GroupMsg& msg, const uint8_t* mac);
+    void processPendingGroupAck();
+    ReliableProtocol::HandlerResult processStatusSweep(const uint8_t* payload, size_t len, const uint8_t* mac);
+    void processPendingSweepReply();
     ReliableProtocol::HandlerResult handleFrame(const uint8_t* mac, const uint8_t* payload, size_t len);
     ReliableProtocol::HandlerResult handleDebugPacket(const uint8_t* mac, const DebugProtocol::Packet& packet);
     void ensurePeer(const uint8_t* mac);
@@ -32,10 +66,8 @@ private:
     void processPendingChannelChange();
     ReliableEspNow::Link reliableLink;
     static EspNowComm* instance;
-    // RSSI capture via promiscuous callback
-    static void wifiSniffer(void* buf, wifi_promiscuous_pkt_type_t type);
+    // RSSI of the last frame received, from the ESP-NOW receive hook
     static volatile int8_t lastRxRssi;
-    static uint8_t lastSenderMac[6];
     bool pendingChannelChange_ = false;
     bool pendingChannelSendStatus_ = false;
     bool pendingChannelMacValid_ = false;
@@ -43,4 +75,17 @@ private:
     uint8_t pendingChannelValue_ = 0;
     uint8_t pendingChannelMac_[6] = {0};
     uint32_t pendingChannelApplyAtMs_ = 0;
+    // Group command reply scheduled into this timer's slot
+    bool pendingGroupAck_ = false;
+    uint8_t pendingGroupAckMac_[6] = {0};
+    uint32_t pendingGroupAckAtMs_ = 0;
+    uint8_t lastGroupSeq_ = 0;
+    uint8_t lastGroupStatus_ = 0;
+    bool lastGroupSeqValid_ = false;
+    // Status sweep reply scheduled into this timer's slot
+    uint8_t ownMac_[6] = {0};
+    bool pendingSweepReply_ = false;
+    uint8_t pendingSweepMac_[6] = {0};
+    uint32_t pendingSweepAtMs_ = 0;
+    TaskHandle_t wakeTask = nullptr;
 };
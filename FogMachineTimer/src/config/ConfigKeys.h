@@ -0,0 +1,18 @@
+// ConfigKeys.h
+// Keys of the timer's settings in the ConfigLog store (lib/ConfigLog).
+#pragma once
+#include <Arduino.h>
+#include "Defaults.h"
+#include "ConfigLog.h"
+
+namespace ConfigKey {
+    static constexpr uint8_t Timer = 1;          // DeviceConfig: float ton, float toff (output 0)
+    static constexpr uint8_t Name = 2;           // DeviceConfig: char[10]
+    static constexpr uint8_t Channel = 3;        // TimerChannelSettings: uint8_t
+    static constexpr uint8_t Groups = 4;         // TimerGroupSettings: mask, slot
+    static constexpr uint8_t AuxTimesBase = 8;   // OutputSettings: float ton, float toff per aux output
+    static constexpr uint8_t PatternBase = 16;   // PatternStore: program bytes per output
+
+    static_assert(AuxTimesBase + Defaults::MAX_OUTPUTS - 1 <= PatternBase, "aux keys overlap patterns");
+    static_assert(PatternBase + Defaults::MAX_OUTPUTS <= ConfigLog::Store::MAX_KEYS, "pattern keys exceed ConfigLog::Store::MAX_KEYS");
+}
@@ -1,64 +1,65 @@
 // DeviceConfig.cpp
-// Handles persistent storage of timer values and device name in EEPROM.
+// Handles persistent storage of timer values and device name in the config log.
 #include "DeviceConfig.h"
+#include "config/ConfigKeys.h"
 
 DeviceConfig::DeviceConfig() : ton(0.1f), toff(10.0f) {
     name[0] = '\0';
 }
 
-void DeviceConfig::begin(size_t eepromSize) {
-    EEPROM.begin(eepromSize);
-    uint8_t magic = 0;
-    EEPROM.get(EEPROM_MAGIC_ADDR, magic);
-    if (magic != EEPROM_MAGIC) {
+void DeviceConfig::begin(ConfigLog::Store& configStore) {
+    store = &configStore;
+    if (isUninitialized()) {
         // Write default config on first boot or after wipe
-        ton = 0.1f;
-        toff = 10.0f;
-        strncpy(name, "FogTimer", sizeof(name)-1);
-        EEPROM.put(0, ton);
-        EEPROM.put(sizeof(float), toff);
-            EEPROM.put(sizeof(float)*2, name);
-        magic = EEPROM_MAGIC;
-        EEPROM.put(EEPROM_MAGIC_ADDR, magic);
-        EEPROM.commit();
+        writeDefaults();
     }
     load();
 }
 
+void DeviceConfig::writeDefaults() {
+    ton = 0.1f;
+    toff = 10.0f;
+    strncpy(name, "FogTimer", sizeof(name)-1);
+    name[sizeof(name)-1] = '\0';
+    ConfigLog::Batch batch;
+    saveTimer(ton, toff, &batch);
+    saveName(name, &batch);
+    store->commit(batch);
+}
+
 void DeviceConfig::load() {
-    EEPROM.get(0, ton);
-    EEPROM.get(sizeof(float), toff);
-        EEPROM.get(sizeof(float)*2, name);
+    float times[2] = {ton, toff};
+    store->get(ConfigKey::Timer, times);
+    store->get(ConfigKey::Name, name);
+    ton = times[0];
+    toff = times[1];
+    name[sizeof(name)-1] = '\0';
     if (ton < 0.1f || ton > 3600.0f) ton = 0.1f;
     if (toff < 0.1f || toff > 3600.0f) toff = 10.0f;
     if (name[0] == '\0') strncpy(name, "FogTimer", sizeof(name)-1);
 }
 
-void DeviceConfig::saveTimer(float tOn, float tOff) {
+void DeviceConfig::saveTimer(float tOn, float tOff, ConfigLog::Batch* batch) {
     ton = tOn;
     toff = tOff;
-    EEPROM.put(0, ton);
-    EEPROM.put(sizeof(float), toff);
-    EEPROM.commit();
+    const float times[2] = {ton, toff};
+    if (batch) batch->stage(ConfigKey::Timer, times);
+    else store->put(ConfigKey::Timer, times);
 }
 
-void DeviceConfig::saveName(const char* newName) {
+void DeviceConfig::saveName(const char* newName, ConfigLog::Batch* batch) {
     strncpy(name, newName, sizeof(name)-1);
     name[sizeof(name)-1] = '\0';
-    EEPROM.put(sizeof(float)*2, name);
-    EEPROM.commit();
+    if (batch) batch->stage(ConfigKey::Name, name);
+    else store->put(ConfigKey::Name, name);
 }
 
 void DeviceConfig::factoryReset() {
-    // Erase EEPROM content to zeros including magic
-    for (int i = 0; i < 128; ++i) EEPROM.write(i, 0);
-    EEPROM.commit();
-    // Re-run begin to write defaults
-    begin(128);
+    writeDefaults();
 }
 
 bool DeviceConfig::isUninitialized() const {
-    uint8_t magic = 0; EEPROM.get(EEPROM_MAGIC_ADDR, magic); return magic != EEPROM_MAGIC;
+    return !store->contains(ConfigKey::Timer);
 }
 
 float DeviceConfig::getTon() const {
@@ -1,16 +1,17 @@
 // DeviceConfig.h
-// Handles persistent storage of timer values and device name in EEPROM.
+// Handles persistent storage of timer values and device name in the config log.
 #pragma once
 #include <Arduino.h>
-#include <EEPROM.h>
+#include "ConfigLog.h"
 
 class DeviceConfig {
 public:
     DeviceConfig();
-    void begin(size_t eepromSize = 128);
+    void begin(ConfigLog::Store& configStore);
     void load();
-    void saveTimer(float ton, float toff);
-    void saveName(const char* name);
+    // With a batch the write is only staged there, for the caller to commit with other fields
+    void saveTimer(float ton, float toff, ConfigLog::Batch* batch = nullptr);
+    void saveName(const char* name, ConfigLog::Batch* batch = nullptr);
     void factoryReset();
     bool isUninitialized() const;
     float getTon() const;
@@ -18,6 +19,7 @@ public:
     const char* getName() const;
     float ton, toff;
     char name[10]; // 9 + NUL
-         static constexpr uint8_t EEPROM_MAGIC = 0x42;
-         static constexpr int EEPROM_MAGIC_ADDR = 100;
+private:
+    void writeDefaults();
+    ConfigLog::Store* store = nullptr;
 };
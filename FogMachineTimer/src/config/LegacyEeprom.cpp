@@ -0,0 +1,77 @@
+// LegacyEeprom.cpp
+// One-time move of settings from the old 256-byte EEPROM image into the ConfigLog store.
+#include "config/LegacyEeprom.h"
+#include <EEPROM.h>
+#include "config/ConfigKeys.h"
+#include "PatternProgram.h"
+
+namespace {
+    // Old layout: [0] ton [4] toff [8] name ... [64] aux outputs [100] magic
+    // [112] channel [120] groups [128] pattern slots
+    constexpr size_t EEPROM_BYTES = 256;
+    constexpr int DEVICE_MAGIC_ADDR = 100;
+    constexpr uint8_t DEVICE_MAGIC = 0x42;
+    constexpr int AUX_ADDR = 64;
+    constexpr uint8_t AUX_MAGIC = 0xCA;
+    constexpr int CHANNEL_ADDR = 112;
+    constexpr uint8_t CHANNEL_MAGIC = 0xC8;
+    constexpr int GROUPS_ADDR = 120;
+    constexpr uint8_t GROUPS_MAGIC = 0xC9;
+    constexpr int PATTERN_ADDR = 128;
+    constexpr int PATTERN_SLOT_BYTES = 1 + PatternProgram::MAX_BYTES;
+    constexpr uint8_t SECTION_VERSION = 1;
+
+    bool sectionValid(int addr, uint8_t magic) {
+        return EEPROM.read(addr) == magic && EEPROM.read(addr + 1) == SECTION_VERSION;
+    }
+}
+
+bool importLegacyEeprom(ConfigLog::Store& store) {
+    if (!store.ready() || !store.empty()) return false;
+    EEPROM.begin(EEPROM_BYTES);
+    ConfigLog::Batch batch; // everything imported lands in one atomic commit
+    if (EEPROM.read(DEVICE_MAGIC_ADDR) == DEVICE_MAGIC) {
+        float times[2];
+        char name[10];
+        EEPROM.get(0, times);
+        EEPROM.get(sizeof(times), name);
+        name[sizeof(name) - 1] = '\0';
+        batch.stage(ConfigKey::Timer, times);
+        batch.stage(ConfigKey::Name, name);
+    }
+    if (sectionValid(AUX_ADDR, AUX_MAGIC)) {
+        for (uint8_t output = 1; output < Defaults::MAX_OUTPUTS; ++output) {
+            float times[2];
+            EEPROM.get(AUX_ADDR + 2 + (output - 1) * sizeof(times), times);
+            batch.stage(ConfigKey::AuxTimesBase + output - 1, times);
+        }
+    }
+    if (sectionValid(CHANNEL_ADDR, CHANNEL_MAGIC)) {
+        batch.stage(ConfigKey::Channel, EEPROM.read(CHANNEL_ADDR + 2));
+    }
+    if (sectionValid(GROUPS_ADDR, GROUPS_MAGIC)) {
+        const uint8_t groups[2] = { EEPROM.read(GROUPS_ADDR + 2), EEPROM.read(GROUPS_ADDR + 3) };
+        batch.stage(ConfigKey::Groups, groups);
+    }
+    for (uint8_t output = 0; output < Defaults::MAX_OUTPUTS; ++output) {
+        const int addr = PATTERN_ADDR + output * PATTERN_SLOT_BYTES;
+        const uint8_t len = EEPROM.read(addr);
+        if (len == 0 || len > PatternProgram::MAX_BYTES) continue;
+        uint8_t code[PatternProgram::MAX_BYTES];
+        for (uint8_t i = 0; i < len; ++i) code[i] = EEPROM.read(addr + 1 + i);
+        if (PatternProgram::validate(code, len)) batch.stage(ConfigKey::PatternBase + output, code, len);
+    }
+    const bool imported = !batch.empty() && store.commit(batch);
+    if (imported) {
+        EEPROM.write(DEVICE_MAGIC_ADDR, 0);
+        EEPROM.write(AUX_ADDR, 0);
+        EEPROM.write(CHANNEL_ADDR, 0);
+        EEPROM.write(GROUPS_ADDR, 0);
+        for (uint8_t output = 0; output < Defaults::MAX_OUTPUTS; ++output) {
+            EEPROM.write(PATTERN_ADDR + output * PATTERN_SLOT_BYTES, 0);
+        }
+        EEPROM.commit();
+    }
+    EEPROM.end();
+    return imported;
+}
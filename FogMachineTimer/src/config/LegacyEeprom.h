@@ -0,0 +1,10 @@
+// LegacyEeprom.h
+// One-time move of settings from the old 256-byte EEPROM image into the ConfigLog store.
+#pragma once
+#include <Arduino.h>
+#include "ConfigLog.h"
+
+// Runs only while the store is empty. Copies every section whose magic checks out in one
+// atomic commit, then clears the old magics so a later factory reset does not bring the
+// EEPROM values back. Returns true when something was imported.
+bool importLegacyEeprom(ConfigLog::Store& store);
@@ -0,0 +1,57 @@
+// OutputSettings.cpp
+// Persists ON/OFF times of the auxiliary relay outputs (output 0 lives in DeviceConfig).
+#include "config/OutputSettings.h"
+#include "config/ConfigKeys.h"
+#include <cmath>
+
+namespace {
+    constexpr float kMaxSeconds = 3600.0f;
+
+    bool validTime(float seconds) {
+        return std::isfinite(seconds) && seconds >= 0.0f && seconds <= kMaxSeconds;
+    }
+}
+
+void OutputSettings::begin(ConfigLog::Store& configStore) {
+    store_ = &configStore;
+    for (uint8_t i = 0; i < AUX_COUNT; ++i) {
+        float times[2] = {Defaults::AUX_DEFAULT_TON, Defaults::AUX_DEFAULT_TOFF};
+        store_->get(ConfigKey::AuxTimesBase + i, times); // absent -> defaults, nothing written
+        ton_[i] = validTime(times[0]) ? times[0] : Defaults::AUX_DEFAULT_TON;
+        toff_[i] = validTime(times[1]) ? times[1] : Defaults::AUX_DEFAULT_TOFF;
+    }
+}
+
+float OutputSettings::getTon(uint8_t output) const {
+    return output >= 1 && output <= AUX_COUNT ? ton_[output - 1] : 0.0f;
+}
+
+float OutputSettings::getToff(uint8_t output) const {
+    return output >= 1 && output <= AUX_COUNT ? toff_[output - 1] : 0.0f;
+}
+
+bool OutputSettings::store(uint8_t output, float ton, float toff, ConfigLog::Batch* batch) {
+    if (output < 1 || output > AUX_COUNT || !validTime(ton) || !validTime(toff)) {
+        return false;
+    }
+    ton_[output - 1] = ton;
+    toff_[output - 1] = toff;
+    write(output - 1, batch);
+    return true;
+}
+
+void OutputSettings::resetToDefault() {
+    ConfigLog::Batch batch;
+    for (uint8_t i = 0; i < AUX_COUNT; ++i) {
+        ton_[i] = Defaults::AUX_DEFAULT_TON;
+        toff_[i] = Defaults::AUX_DEFAULT_TOFF;
+        batch.stageErase(ConfigKey::AuxTimesBase + i);
+    }
+    store_->commit(batch);
+}
+
+void OutputSettings::write(uint8_t index, ConfigLog::Batch* batch) {
+    const float times[2] = {ton_[index], toff_[index]};
+    if (batch) batch->stage(ConfigKey::AuxTimesBase + index, times);
+    else store_->put(ConfigKey::AuxTimesBase + index, times);
+}
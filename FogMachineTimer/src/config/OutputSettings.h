@@ -0,0 +1,22 @@
+// OutputSettings.h
+// Persists ON/OFF times of the auxiliary relay outputs (output 0 lives in DeviceConfig).
+#pragma once
+#include <Arduino.h>
+#include "Defaults.h"
+#include "ConfigLog.h"
+
+class OutputSettings {
+public:
+    void begin(ConfigLog::Store& configStore);
+    float getTon(uint8_t output) const;
+    float getToff(uint8_t output) const;
+    // output must be 1..MAX_OUTPUTS-1; a batch only stages the write, like DeviceConfig
+    bool store(uint8_t output, float ton, float toff, ConfigLog::Batch* batch = nullptr);
+    void resetToDefault();
+private:
+    static constexpr uint8_t AUX_COUNT = Defaults::MAX_OUTPUTS - 1;
+    void write(uint8_t index, ConfigLog::Batch* batch = nullptr);
+    ConfigLog::Store* store_ = nullptr;
+    float ton_[AUX_COUNT] = {};
+    float toff_[AUX_COUNT] = {};
+};
@@ -0,0 +1,33 @@
+// PatternStore.cpp
+// Persists one step program (lib/PatternProgram bytecode) per relay output.
+#include "config/PatternStore.h"
+#include "config/ConfigKeys.h"
+
+bool PatternStore::load(uint8_t output, uint8_t* code, size_t& len) const {
+    len = 0;
+    if (output >= Defaults::MAX_OUTPUTS) return false;
+    const size_t stored = store_->size(ConfigKey::PatternBase + output);
+    if (stored == 0 || stored > PatternProgram::MAX_BYTES) return false;
+    if (store_->read(ConfigKey::PatternBase + output, code, stored) != stored) return false;
+    if (!PatternProgram::validate(code, stored)) return false;
+    len = stored;
+    return true;
+}
+
+bool PatternStore::store(uint8_t output, const uint8_t* code, size_t len) {
+    if (output >= Defaults::MAX_OUTPUTS || !PatternProgram::validate(code, len)) return false;
+    return store_->put(ConfigKey::PatternBase + output, code, len);
+}
+
+void PatternStore::clear(uint8_t output) {
+    if (output >= Defaults::MAX_OUTPUTS || !store_->contains(ConfigKey::PatternBase + output)) return;
+    store_->erase(ConfigKey::PatternBase + output);
+}
+
+void PatternStore::resetToDefault() {
+    ConfigLog::Batch batch;
+    for (uint8_t output = 0; output < Defaults::MAX_OUTPUTS; ++output) {
+        batch.stageErase(ConfigKey::PatternBase + output);
+    }
+    store_->commit(batch);
+}
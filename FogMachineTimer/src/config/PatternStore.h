@@ -0,0 +1,22 @@
+// PatternStore.h
+// Persists one step program (lib/PatternProgram bytecode) per relay output.
+#pragma once
+#include <Arduino.h>
+#include "Defaults.h"
+#include "PatternProgram.h"
+#include "ConfigLog.h"
+
+class PatternStore {
+public:
+    void begin(ConfigLog::Store& configStore) { store_ = &configStore; }
+    // Copies the stored program into code (MAX_BYTES); false if the slot is empty or invalid
+    bool load(uint8_t output, uint8_t* code, size_t& len) const;
+    bool store(uint8_t output, const uint8_t* code, size_t len);
+    void clear(uint8_t output);
+    void resetToDefault();
+private:
+    // One key per output holding the bytecode; no key = no program. Programs are
+    // re-validated on load, so a stale value simply reads as empty.
+    static_assert(PatternProgram::MAX_BYTES <= ConfigLog::Store::MAX_VALUE_BYTES, "program exceeds a config log value");
+    ConfigLog::Store* store_ = nullptr;
+};
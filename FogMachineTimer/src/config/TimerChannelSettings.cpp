@@ -1,5 +1,5 @@
 #include "config/TimerChannelSettings.h"
-#include <EEPROM.h>
+#include "config/ConfigKeys.h"
 #include <esp_wifi.h>
 
 namespace {
@@ -7,7 +7,8 @@ namespace {
     constexpr uint8_t kMaxChannel = 13;
 }
 
-void TimerChannelSettings::begin(void (*factoryResetCallback)()) {
+void TimerChannelSettings::begin(ConfigLog::Store& configStore, void (*factoryResetCallback)()) {
+    store_ = &configStore;
     factoryResetCb_ = factoryResetCallback;
     load();
     if (!valid_ || !isChannelSupported(storedChannel_)) {
@@ -21,27 +22,13 @@ bool TimerChannelSettings::isChannelSupported(uint8_t channel) const {
 }
 
 void TimerChannelSettings::load() {
-    valid_ = false;
     storedChannel_ = Defaults::DEFAULT_CHANNEL;
-    uint8_t magic = 0;
-    EEPROM.get(ADDR_MAGIC, magic);
-    if (magic != MAGIC) {
-        return;
-    }
-    uint8_t version = 0;
-    EEPROM.get(ADDR_VER, version);
-    if (version != VERSION) {
-        return;
-    }
-    EEPROM.get(ADDR_VALUE, storedChannel_);
-    valid_ = true;
+    valid_ = store_->get(ConfigKey::Channel, storedChannel_);
 }
 
-void TimerChannelSettings::write() {
-    EEPROM.put(ADDR_MAGIC, MAGIC);
-    EEPROM.put(ADDR_VER, VERSION);
-    EEPROM.put(ADDR_VALUE, storedChannel_);
-    EEPROM.commit();
+void TimerChannelSettings::write(ConfigLog::Batch* batch) {
+    if (batch) batch->stage(ConfigKey::Channel, storedChannel_);
+    else store_->put(ConfigKey::Channel, storedChannel_);
 }
 
 bool TimerChannelSettings::setChannel(uint8_t channel) {
@@ -53,7 +40,7 @@ bool TimerChannelSettings::setChannel(uint8_t channel) {
     return changed;
 }
 
-bool TimerChannelSettings::storeChannel(uint8_t channel) {
+bool TimerChannelSettings::storeChannel(uint8_t channel, ConfigLog::Batch* batch) {
     if (!isChannelSupported(channel)) {
         return false;
     }
@@ -62,7 +49,7 @@ bool TimerChannelSettings::storeChannel(uint8_t channel) {
     }
     storedChannel_ = channel;
     valid_ = true;
-    write();
+    write(batch);
     return true;
 }
 
@@ -0,0 +1,37 @@
+// TimerGroupSettings.cpp
+// Persists this timer's group memberships and its reply slot for group broadcasts.
+#include "config/TimerGroupSettings.h"
+#include "config/ConfigKeys.h"
+
+void TimerGroupSettings::begin(ConfigLog::Store& configStore) {
+    store_ = &configStore;
+    groupMask_ = 0;
+    slot_ = SLOT_NONE;
+    uint8_t stored[2];
+    if (!store_->get(ConfigKey::Groups, stored)) {
+        return; // not a member of any group until the remote assigns one
+    }
+    groupMask_ = stored[0];
+    slot_ = stored[1];
+}
+
+bool TimerGroupSettings::store(uint8_t groupMask, uint8_t slot) {
+    if (groupMask == groupMask_ && slot == slot_) {
+        return false;
+    }
+    groupMask_ = groupMask;
+    slot_ = slot;
+    write();
+    return true;
+}
+
+void TimerGroupSettings::resetToDefault() {
+    groupMask_ = 0;
+    slot_ = SLOT_NONE;
+    write();
+}
+
+void TimerGroupSettings::write() {
+    const uint8_t stored[2] = {groupMask_, slot_};
+    store_->put(ConfigKey::Groups, stored);
+}
@@ -0,0 +1,22 @@
+// TimerGroupSettings.h
+// Persists this timer's group memberships and its reply slot for group broadcasts.
+#pragma once
+#include <Arduino.h>
+#include "ConfigLog.h"
+
+class TimerGroupSettings {
+public:
+    static constexpr uint8_t SLOT_NONE = 0xFF; // no slot assigned -> randomised reply window
+    void begin(ConfigLog::Store& configStore);
+    uint8_t getGroupMask() const { return groupMask_; }
+    uint8_t getSlot() const { return slot_; }
+    // mask == 0 addresses every timer regardless of membership
+    bool isMember(uint8_t mask) const { return mask == 0 || (groupMask_ & mask) != 0; }
+    bool store(uint8_t groupMask, uint8_t slot);
+    void resetToDefault();
+private:
+    void write();
+    ConfigLog::Store* store_ = nullptr;
+    uint8_t groupMask_ = 0;
+    uint8_t slot_ = SLOT_NONE;
+};
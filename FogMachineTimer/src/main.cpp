@@ -1,7 +1,6 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <esp_now.h>
-#include <EEPROM.h>
 #include "Defaults.h"
 
 // main.cpp
@@ -11,37 +10,86 @@
 #include "config/DeviceConfig.h"
 #include "comm/EspNowComm.h"
 #include "config/TimerChannelSettings.h"
+#include "config/TimerGroupSettings.h"
+#include "config/OutputSettings.h"
+#include "config/PatternStore.h"
+#include "config/LegacyEeprom.h"
+#include "ConfigLog.h"
+#include "ConfigLogFlusher.h"
 
 #define FOG_OUTPUT_PIN D3
 
-TimerController timer(FOG_OUTPUT_PIN);
+// Output 0 is the fog relay; the rest are auxiliary relays (pump, heater enable, fan)
+static const uint8_t OUTPUT_PINS[Defaults::MAX_OUTPUTS] = { FOG_OUTPUT_PIN, D1, D2, D10 };
+
+TimerController timer(OUTPUT_PINS, Defaults::MAX_OUTPUTS);
+ConfigLog::Store configStore;
 DeviceConfig config;
 TimerChannelSettings channelSettings;
-EspNowComm comm(timer, config, channelSettings);
+TimerGroupSettings groupSettings;
+OutputSettings outputSettings;
+PatternStore patternStore;
+ConfigLog::Flusher configFlusher;
+EspNowComm comm(timer, config, channelSettings, groupSettings, outputSettings, patternStore, configStore);
 
-static void wipeTimerEeprom() {
-  for (int i = 0; i < 256; ++i) {
-    EEPROM.write(i, 0);
-  }
-  EEPROM.commit();
+static void wipeTimerConfig() {
+  configStore.format();
 }
 
 void setup() {
   Serial.begin(115200);
-  EEPROM.begin(256);
-  channelSettings.begin(&wipeTimerEeprom);
-  config.begin();
-  pinMode(FOG_OUTPUT_PIN, OUTPUT);
-  // Ensure output is OFF on startup (do not blink, this pin controls the fog relay)
-  digitalWrite(FOG_OUTPUT_PIN, LOW);
+  ConfigLog::FlashRegion region;
+  if (!ConfigLog::openPartition(region) || !configStore.begin(region)) {
+    Serial.println("[SLAVE] No config log partition, settings will not persist");
+  } else if (importLegacyEeprom(configStore)) {
+    Serial.println("[SLAVE] Imported settings from legacy EEPROM");
+  }
+  channelSettings.begin(configStore, &wipeTimerConfig);
+  config.begin(configStore);
+  groupSettings.begin(configStore);
+  outputSettings.begin(configStore);
+  patternStore.begin(configStore);
+  // From here on saves made by radio handlers only touch RAM; a background task writes them
+  if (configStore.ready() && !configFlusher.begin(configStore, Defaults::CONFIG_FLUSH_QUIET_MS, Defaults::CONFIG_FLUSH_MAX_DELAY_MS)) {
+    Serial.println("[SLAVE] Config flusher not started, saves write flash directly");
+  }
+  // Ensure outputs are OFF on startup (do not blink, these pins control relays)
+  for (uint8_t pin : OUTPUT_PINS) {
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+  }
   timer.begin(config.getTon(), config.getToff());
+  for (uint8_t output = 1; output < timer.getOutputCount(); ++output) {
+    timer.setTimes(outputSettings.getTon(output), outputSettings.getToff(output), output);
+  }
+  // Stored step programs run locally from boot, no remote needed
+  for (uint8_t output = 0; output < timer.getOutputCount(); ++output) {
+    uint8_t code[PatternProgram::MAX_BYTES];
+    size_t len = 0;
+    if (patternStore.load(output, code, len)) timer.setPattern(output, code, len);
+  }
+  // A warm reset (brownout from the relay coil, watchdog) continues the cycle instead of
+  // starting a fresh OFF period
+  const uint8_t resumed = timer.resumePhases();
+  if (resumed) Serial.printf("[SLAVE] Resumed cycle phase from RTC memory (outputs 0x%02X)\n", resumed);
+  // Tickless loop: the edge alarm and radio RX wake loop() through a task notification
+  timer.setWakeTask(xTaskGetCurrentTaskHandle());
+  comm.setWakeTask(xTaskGetCurrentTaskHandle());
   comm.begin();
   Serial.println("FogMachineTimer started.");
 }
 
 void loop() {
   unsigned long now = millis();
+  // Relay edges are switched by the controller's esp_timer alarm; update() only
+  // books the last edge and arms the next one, so loop latency does not move edges.
   timer.update(now);
   comm.loop();
-  delay(10);
+  // Block until the next deadline (retry, scheduled reply, re-alignment) or an event;
+  // with nothing pending the CPU stays idle instead of polling every 10 ms.
+  uint32_t waitMs = timer.msUntilNextUpdate();
+  const uint32_t commMs = comm.msUntilNextWork();
+  if (commMs < waitMs) waitMs = commMs;
+  if (waitMs > Defaults::LOOP_IDLE_MAX_MS) waitMs = Defaults::LOOP_IDLE_MAX_MS;
+  if (waitMs) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
 }
@@ -13,7 +13,19 @@ enum class ProtocolCmd : uint8_t {
     CALIBRATE_BATTERY = 8,
     TOGGLE_STATE = 9,
     FACTORY_RESET = 10,
-    SET_CHANNEL = 11
+    SET_CHANNEL = 11,
+    SYNC_PHASE = 12,      // PhaseSyncMsg: join/leave a phase-locked group (epoch + offset)
+    SYNC_CLOCK = 13,      // PhaseSyncMsg: broadcast clock beacon carrying the remote timebase
+    SET_GROUP = 14,       // GroupMsg: store group memberships + reply slot on the timer
+    GROUP_CMD = 15,       // GroupMsg: broadcast command executed by every addressed member
+    GROUP_ACK = 16,       // GroupMsg: member -> remote confirmation of a GROUP_CMD
+    STATUS_SWEEP = 17,    // StatusSweepMsg: broadcast poll, listed timers reply with STATUS in their slot
+    CONFIGURE = 18,       // ConfigureMsg: name/timer/channel applied atomically, one STATUS reply
+    OUTPUT_CMD = 19,      // OutputMsg: command addressed to one relay output of a multi-output timer
+    OUTPUT_STATUS = 20,   // OutputMsg: timer -> remote state of one output (reply to OUTPUT_CMD/PATTERN)
+    PATTERN = 21,         // PatternMsg: load/clear/restart/trigger the step program of one output
+    CUE = 22,             // CueMsg: queue a timestamped action (remote timebase) or clear the queue
+    PULSE = 23            // PulseMsg: pulse-train backend for one output (SSR drive); reply is OUTPUT_STATUS
 };
 
 enum class ProtocolStatus : uint8_t {
@@ -35,9 +47,149 @@ struct __attribute__((packed)) ProtocolMsg {
     int8_t rssiAtTimer;   // RSSI measured at timer for last packet from remote
     uint16_t calibAdc[3]; // battery calibration ADC points
     uint8_t channel;      // preferred ESP-NOW channel for coordination
-    uint8_t reserved[3];  // pad to maintain alignment
+    uint8_t flags;        // ProtocolFlags (was reserved padding: older builds send 0)
+    uint8_t groupMask;    // STATUS with ProtocolFlags::GroupInfo: stored group memberships
+    uint8_t groupSlot;    // STATUS with ProtocolFlags::GroupInfo: stored reply slot (0xFF = unassigned)
+};
+
+// Compact frame for fleet phase locking. Distinguished from ProtocolMsg by its
+// size; cmd stays the first byte so both share the same dispatch.
+struct __attribute__((packed)) PhaseSyncMsg {
+    uint8_t cmd;            // ProtocolCmd::SYNC_PHASE or SYNC_CLOCK
+    uint8_t flags;          // PhaseSyncFlags
+    uint16_t reserved;
+    uint32_t remoteMs;      // SYNC_CLOCK: remote millis() at transmit time
+    uint32_t epochMs;       // SYNC_PHASE: group epoch in remote timebase (ON edge at epoch+offset)
+    uint32_t phaseOffsetMs; // SYNC_PHASE: this timer's delay after the epoch
+};
+
+// Group addressing frame. One broadcast GROUP_CMD replaces N unicasts; members
+// answer with GROUP_ACK in their reply slot and the remote unicasts stragglers.
+struct __attribute__((packed)) GroupMsg {
+    uint8_t cmd;            // ProtocolCmd::SET_GROUP, GROUP_CMD or GROUP_ACK
+    uint8_t groupMask;      // SET_GROUP: memberships; GROUP_CMD: target groups (0 = all timers)
+    uint8_t seq;            // GROUP_CMD/GROUP_ACK: transaction id for de-dup and ACK matching
+    uint8_t op;             // GROUP_CMD: inner ProtocolCmd (SET_TIMER, OVERRIDE_OUTPUT, RESET_STATE, TOGGLE_STATE)
+    float ton;              // GROUP_CMD SET_TIMER / GROUP_ACK: applied values
+    float toff;
+    uint8_t outputOverride; // GROUP_CMD OVERRIDE_OUTPUT / GROUP_ACK: output state
+    uint8_t slot;           // SET_GROUP: assigned reply slot; GROUP_ACK: responder slot
+    uint8_t slotMs;         // GROUP_CMD: reply slot width in ms
+    uint8_t status;         // GROUP_ACK: ProtocolStatus
+};
+
+// Slotted status poll. Timer i in macTail answers with STATUS i*slotMs after receipt,
+// so a whole fleet reports within one predictable window without collisions.
+// Sent with only `count` entries on air (STATUS_SWEEP_HEADER_BYTES + 3*count).
+struct __attribute__((packed)) StatusSweepMsg {
+    static constexpr uint8_t kMaxEntries = 48;
+    uint8_t cmd;                      // ProtocolCmd::STATUS_SWEEP
+    uint8_t seq;
+    uint8_t slotMs;                   // reply slot width in ms
+    uint8_t count;                    // valid entries in macTail
+    uint8_t macTail[kMaxEntries][3];  // last three MAC bytes; slot = entry position
+};
+constexpr size_t STATUS_SWEEP_HEADER_BYTES = 4;
+
+// Transactional configuration frame. The timer validates every op in `ops` first,
+// applies them together in one atomic config commit and answers with a single STATUS.
+struct __attribute__((packed)) ConfigureMsg {
+    uint8_t cmd;            // ProtocolCmd::CONFIGURE
+    uint8_t ops;            // ConfigureOps bits present in this frame
+    uint8_t channel;        // ConfigureOps::Channel: new stored channel (always persisted)
+    uint8_t reserved;
+    float ton;              // ConfigureOps::Timer
+    float toff;
+    char name[10];          // ConfigureOps::Name (9 + NUL)
+};
+
+// Per-output addressing for timers with several relays. Output 0 is the fog relay
+// (the one ProtocolMsg/STATUS describe); 1.. are auxiliary outputs with their own cycle.
+struct __attribute__((packed)) OutputMsg {
+    uint8_t cmd;            // ProtocolCmd::OUTPUT_CMD or OUTPUT_STATUS
+    uint8_t output;         // output index
+    uint8_t op;             // OUTPUT_CMD: inner ProtocolCmd (SET_TIMER, OVERRIDE_OUTPUT, RESET_STATE, TOGGLE_STATE, STATUS = query)
+    uint8_t outputCount;    // OUTPUT_STATUS: outputs on this timer
+    float ton;              // OUTPUT_CMD SET_TIMER / OUTPUT_STATUS: seconds
+    float toff;
+    float elapsed;          // OUTPUT_STATUS: seconds in the current state
+    uint8_t outputOn;       // OUTPUT_CMD OVERRIDE_OUTPUT: desired; OUTPUT_STATUS: current level
+    uint8_t overrideActive; // OUTPUT_STATUS
+    uint8_t status;         // OUTPUT_STATUS: ProtocolStatus of the command
+    uint8_t flags;          // OUTPUT_STATUS: OutputFlags
+};
+
+// Step program for one output (lib/PatternProgram bytecode). LOAD persists the program
+// on the timer, which then runs it locally; the reply is an OUTPUT_STATUS.
+struct __attribute__((packed)) PatternMsg {
+    uint8_t cmd;            // ProtocolCmd::PATTERN
+    uint8_t output;         // output index
+    uint8_t op;             // PatternOps
+    uint8_t length;         // LOAD: bytes used in code
+    uint8_t code[31];       // PatternProgram::MAX_BYTES
+};
+
+// Timestamped cue. The timer queues it and its edge alarm executes it at atMs in the
+// remote timebase (kept by SYNC_CLOCK beacons), so a retried frame still lands on time.
+struct __attribute__((packed)) CueMsg {
+    uint8_t cmd;            // ProtocolCmd::CUE
+    uint8_t op;             // CueOps
+    uint8_t output;         // Add: output index
+    uint8_t action;         // Add: CueActions
+    uint16_t id;            // Add: remote-assigned; a retried cue with the same id is ignored
+    uint16_t durationMs;    // CueActions::Hit: ON time
+    uint32_t atMs;          // Add: remote millis() at which to execute
+};
+
+// Pulse train for SSR outputs: while the output is ON the timer's RMT peripheral replays
+// durUs (alternating high/low from high, microseconds) in a loop. count 0 = plain GPIO.
+struct __attribute__((packed)) PulseMsg {
+    uint8_t cmd;            // ProtocolCmd::PULSE
+    uint8_t output;         // output index
+    uint8_t count;          // durations used, even; at most 94 (one RMT memory block)
+    uint8_t reserved;
+    uint16_t durUs[94];     // each 1..32767
 };
 
 namespace ProtocolFlags {
-    constexpr uint8_t ChannelPersist = 0x01;
+    constexpr uint8_t ChannelPersist = 0x01; // SET_CHANNEL: store the channel
+    constexpr uint8_t PhaseLocked = 0x02;    // STATUS: the fog output follows a phase group
+    constexpr uint8_t GroupInfo = 0x04;      // STATUS: groupMask/groupSlot are filled in
+}
+
+namespace ConfigureOps {
+    constexpr uint8_t Name = 0x01;
+    constexpr uint8_t Timer = 0x02;
+    constexpr uint8_t Channel = 0x04;
+    constexpr uint8_t All = Name | Timer | Channel;
+}
+
+namespace OutputFlags {
+    constexpr uint8_t Pattern = 0x01;  // output runs a step program instead of its ON/OFF cycle
+    constexpr uint8_t Holding = 0x02;  // program waits in HOLD for a trigger
+    constexpr uint8_t Pulse = 0x04;    // ON phases are a pulse train (PULSE)
+}
+
+namespace PatternOps {
+    constexpr uint8_t Load = 1;     // validate, persist and start
+    constexpr uint8_t Clear = 2;    // forget the program, back to the ON/OFF cycle
+    constexpr uint8_t Restart = 3;
+    constexpr uint8_t Trigger = 4;  // release a HOLD step
+}
+
+namespace CueOps {
+    constexpr uint8_t Add = 1;
+    constexpr uint8_t Clear = 2;     // drop every queued cue
+}
+
+namespace CueActions {
+    constexpr uint8_t On = 1;        // override ON
+    constexpr uint8_t Off = 2;       // release; a fresh OFF phase starts
+    constexpr uint8_t Hit = 3;       // ON for durationMs, then Off
+    constexpr uint8_t Reset = 4;     // restart the cycle / program
+    constexpr uint8_t Trigger = 5;   // release a program HOLD
+}
+
+namespace PhaseSyncFlags {
+    constexpr uint8_t Enable = 0x01; // SYNC_PHASE: set = lock to epoch, clear = free-run
 }
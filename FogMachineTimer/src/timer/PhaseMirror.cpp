@@ -0,0 +1,72 @@
+// PhaseMirror.cpp
+// Mirrors each output's cycle phase in RTC memory so a warm reset resumes mid-cycle.
+#include "timer/PhaseMirror.h"
+#include <esp_attr.h>
+#include <stddef.h>
+#include <esp_system.h>
+#include <sys/time.h>
+
+namespace {
+constexpr uint32_t MIRROR_MAGIC = 0x46504D31; // "FPM1"
+
+struct MirrorImage {
+    uint32_t magic;
+    uint8_t validMask; // bit i = slot i holds a phase
+    uint8_t reserved[3];
+    PhaseMirror::Phase slots[Defaults::MAX_OUTPUTS];
+    uint32_t checksum;
+};
+
+RTC_NOINIT_ATTR MirrorImage image;
+
+// FNV-1a over everything before the checksum
+uint32_t checksumOf(const MirrorImage& m) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&m);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(MirrorImage, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void seal() {
+    image.checksum = checksumOf(image);
+}
+}
+
+int64_t PhaseMirror::wallMicros() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return static_cast<int64_t>(tv.tv_sec) * 1000000LL + tv.tv_usec;
+}
+
+bool PhaseMirror::begin() {
+    const esp_reset_reason_t reason = esp_reset_reason();
+    const bool warm = reason != ESP_RST_POWERON && reason != ESP_RST_UNKNOWN;
+    if (warm && image.magic == MIRROR_MAGIC && image.checksum == checksumOf(image)) {
+        return image.validMask != 0;
+    }
+    memset(&image, 0, sizeof(image));
+    image.magic = MIRROR_MAGIC;
+    seal();
+    return false;
+}
+
+bool PhaseMirror::load(uint8_t output, Phase& out) const {
+    if (output >= Defaults::MAX_OUTPUTS || !(image.validMask & (1u << output))) return false;
+    out = image.slots[output];
+    return true;
+}
+
+void PhaseMirror::store(uint8_t output, const Phase& phase) {
+    if (output >= Defaults::MAX_OUTPUTS) return;
+    image.slots[output] = phase;
+    image.validMask |= static_cast<uint8_t>(1u << output);
+    seal();
+}
+
+void PhaseMirror::clear(uint8_t output) {
+    if (output >= Defaults::MAX_OUTPUTS || !(image.validMask & (1u << output))) return;
+    image.validMask &= static_cast<uint8_t>(~(1u << output));
+    seal();
+}
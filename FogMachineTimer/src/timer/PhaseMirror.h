@@ -0,0 +1,25 @@
+// PhaseMirror.h
+// Mirrors each output's cycle phase in RTC memory so a warm reset resumes mid-cycle.
+#pragma once
+#include <Arduino.h>
+#include "Defaults.h"
+
+// RTC slow memory keeps its contents through software, watchdog and brownout resets
+// (not power-on). Phase starts are stamped on the gettimeofday() clock, which IDF carries
+// across those resets from the RTC timer, so the time spent down is accounted for.
+class PhaseMirror {
+public:
+    struct Phase {
+        int64_t startWallUs; // wallMicros() when the current phase began
+        uint64_t onUs;       // durations the phase belongs to; a changed config is not resumed
+        uint64_t offUs;
+        bool cycleOn;
+        bool overridden;
+    };
+    static int64_t wallMicros();
+    // Once at boot: keeps the mirror only after a warm reset with an intact checksum
+    bool begin();
+    bool load(uint8_t output, Phase& out) const;
+    void store(uint8_t output, const Phase& phase);
+    void clear(uint8_t output);
+};
@@ -0,0 +1,77 @@
+// PulseOutput.cpp
+// RMT backend for relay outputs that drive SSRs with fast pulse trains.
+#include "timer/PulseOutput.h"
+
+namespace {
+// 80 MHz APB / 80 = 1 us per RMT tick, so a 15-bit item duration spans up to 32.767 ms
+constexpr uint8_t RMT_CLK_DIV = 80;
+uint8_t usedChannels = 0; // bit i = RMT TX channel i owned by some PulseOutput
+}
+
+bool PulseOutput::isValidTrain(const uint16_t* dur, uint8_t n) {
+    if (!dur || n == 0 || (n & 1) || n > MAX_DURATIONS) return false;
+    for (uint8_t i = 0; i < n; ++i) {
+        if (dur[i] == 0 || dur[i] > MAX_DURATION_US) return false;
+    }
+    return true;
+}
+
+bool PulseOutput::attach(uint8_t outPin, const uint16_t* dur, uint8_t n) {
+    if (!isValidTrain(dur, n)) return false;
+    if (channel >= 0 && outPin != pin) detach(false);
+    if (channel < 0) {
+        int8_t free = -1;
+        for (uint8_t ch = 0; ch < MAX_CHANNELS; ++ch) {
+            if (!(usedChannels & (1u << ch))) {
+                free = static_cast<int8_t>(ch);
+                break;
+            }
+        }
+        if (free < 0) return false;
+        rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX(static_cast<gpio_num_t>(outPin), static_cast<rmt_channel_t>(free));
+        cfg.clk_div = RMT_CLK_DIV;
+        cfg.tx_config.loop_en = true;
+        cfg.tx_config.carrier_en = false;
+        cfg.tx_config.idle_output_en = true;
+        cfg.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+        if (rmt_config(&cfg) != ESP_OK) return false;
+        usedChannels |= static_cast<uint8_t>(1u << free);
+        channel = free;
+        pin = outPin;
+    } else {
+        rmt_tx_stop(static_cast<rmt_channel_t>(channel));
+    }
+    running = false;
+    count = n;
+    memcpy(durUs, dur, n * sizeof(uint16_t));
+    // One item per high/low pair plus the zero end marker the loop wraps on
+    rmt_item32_t items[MAX_DURATIONS / 2 + 1] = {};
+    for (uint8_t i = 0; i < n / 2; ++i) {
+        items[i].level0 = 1;
+        items[i].duration0 = dur[2 * i];
+        items[i].level1 = 0;
+        items[i].duration1 = dur[2 * i + 1];
+    }
+    rmt_fill_tx_items(static_cast<rmt_channel_t>(channel), items, n / 2 + 1, 0);
+    return true;
+}
+
+void PulseOutput::detach(bool level) {
+    if (channel < 0) return;
+    rmt_tx_stop(static_cast<rmt_channel_t>(channel));
+    usedChannels &= static_cast<uint8_t>(~(1u << channel));
+    channel = -1;
+    count = 0;
+    running = false;
+    // Hand the pin back from the RMT signal to plain GPIO
+    pinMatrixOutDetach(pin, false, false);
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, level ? HIGH : LOW);
+}
+
+void PulseOutput::write(bool on) {
+    if (channel < 0 || on == running) return;
+    running = on;
+    if (on) rmt_tx_start(static_cast<rmt_channel_t>(channel), true); // from the first pulse
+    else rmt_tx_stop(static_cast<rmt_channel_t>(channel));
+}
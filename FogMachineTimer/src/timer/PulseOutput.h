@@ -0,0 +1,37 @@
+// PulseOutput.h
+// RMT backend for relay outputs that drive SSRs with fast pulse trains.
+#pragma once
+#include <Arduino.h>
+#include <driver/rmt.h>
+#include <soc/soc_caps.h>
+
+// While the output is ON the RMT peripheral replays a precomputed high/low sequence
+// from its own memory block in loop mode: microsecond edges, no CPU work per pulse.
+// OFF stops the channel and leaves the pin at its LOW idle level. An output without a
+// train, or without a free TX channel, stays a plain GPIO.
+class PulseOutput {
+public:
+    // ESP32-C3: two TX channels, one 48-word block each (one word kept for the end marker)
+    static constexpr uint8_t MAX_CHANNELS = 2;
+    static constexpr uint8_t MAX_DURATIONS = 2 * (SOC_RMT_MEM_WORDS_PER_CHANNEL - 1);
+    static constexpr uint16_t MAX_DURATION_US = 32767;
+
+    // durUs alternates high/low starting with high; count is even and each entry 1..MAX_DURATION_US
+    static bool isValidTrain(const uint16_t* durUs, uint8_t count);
+    // Returns false (and leaves the pin on GPIO) for a bad train or when no channel is free
+    bool attach(uint8_t pin, const uint16_t* durUs, uint8_t count);
+    // Back to GPIO at the given level
+    void detach(bool level);
+    bool attached() const { return channel >= 0; }
+    uint8_t length() const { return count; }
+    const uint16_t* durations() const { return durUs; }
+    // Start/stop the train. Called from the esp_timer task and loop(); both only touch
+    // the channel's start/stop registers.
+    void write(bool on);
+private:
+    int8_t channel = -1;
+    uint8_t pin = 0;
+    uint8_t count = 0;
+    uint16_t durUs[MAX_DURATIONS] = {};
+    bool running = false;
+};
@@ -1,95 +1,641 @@
 // TimerController.cpp
 // Implements the fog machine timer logic.
 #include "TimerController.h"
+#include "protocol/Protocol.h"
 
-TimerController::TimerController(uint8_t outputPin)
-    : pin(outputPin), ton(0.1f), toff(10.0f), outputOverride(false), outputState(false), lastSwitch(0), currentStateSeconds(0) {}
+namespace {
+// Clock corrections larger than this re-align the output immediately; smaller
+// ones only move the next scheduled edge so a beacon never causes a relay glitch.
+constexpr int32_t PHASE_REALIGN_THRESHOLD_MS = 500;
+// Cues further ahead than this are rejected as a bad timestamp rather than queued
+constexpr uint32_t CUE_HORIZON_MS = 24UL * 60UL * 60UL * 1000UL;
+// A mirrored phase older than this is treated as stale rather than resumed
+constexpr int64_t MAX_RESUME_GAP_US = 24LL * 60LL * 60LL * 1000000LL;
+
+uint32_t secondsToMs(float seconds) {
+    return seconds > 0.0f ? static_cast<uint32_t>(seconds * 1000.0f + 0.5f) : 0;
+}
+
+// Rounded once per setTimes(); the float never enters edge arithmetic again
+uint64_t secondsToUs(float seconds) {
+    return seconds > 0.0f ? static_cast<uint64_t>(static_cast<double>(seconds) * 1000000.0 + 0.5) : 0;
+}
+
+uint8_t latenessBucket(uint32_t lateUs) {
+    if (lateUs < 16) return 0;
+    const uint8_t width = static_cast<uint8_t>(32 - __builtin_clz(lateUs)); // 16..31 -> 5
+    const uint8_t bucket = static_cast<uint8_t>(width - 4);
+    return bucket < TimerController::LATENESS_BUCKETS ? bucket : TimerController::LATENESS_BUCKETS - 1;
+}
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(esp_timer_get_time());
+}
+
+// Start of millisecond `ms` (32-bit millis() timeline) on the 64-bit esp_timer timeline
+uint64_t usAtMillis(unsigned long ms, uint64_t nowUs) {
+    int32_t back = static_cast<int32_t>(static_cast<uint32_t>(nowUs / 1000) - static_cast<uint32_t>(ms));
+    return static_cast<uint64_t>(static_cast<int64_t>(nowUs / 1000) - back) * 1000;
+}
+}
+
+TimerController::TimerController(const uint8_t* outputPins, uint8_t count)
+    : outputCount(count < MAX_OUTPUTS ? count : MAX_OUTPUTS) {
+    for (uint8_t i = 0; i < MAX_OUTPUTS; ++i) {
+        cycles[i].output().pin = i < outputCount ? outputPins[i] : 0;
+        cycles[i].output().pulse = &pulses[i];
+        ton[i] = 0.0f;
+        toff[i] = 0.0f;
+        nextEdgeMs[i] = 0;
+        edgeAtUs[i] = 0;
+    }
+    ton[0] = 0.1f;
+    toff[0] = 10.0f;
+}
 
 void TimerController::begin(float tonSeconds, float toffSeconds) {
-    ton = tonSeconds;
-    toff = toffSeconds;
-    outputOverride = false;
-    outputState = false;
-    lastSwitch = millis();
-    currentStateSeconds = 0;
-    pinMode(pin, OUTPUT);
-    digitalWrite(pin, LOW);
+    ton[0] = tonSeconds;
+    toff[0] = toffSeconds;
+    const uint64_t nowUs = nowMicros();
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        pinMode(cycles[i].output().pin, OUTPUT);
+        cycles[i].begin(nowUs, secondsToUs(ton[i]), secondsToUs(toff[i])); // starts OFF, drives LOW
+    }
+    if (!edgeTimer) {
+        esp_timer_create_args_t args = {};
+        args.callback = &TimerController::onEdgeTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "fog_edge";
+        if (esp_timer_create(&args, &edgeTimer) != ESP_OK) {
+            edgeTimer = nullptr; // fall back to polling from update()
+        }
+    }
 }
 
 void TimerController::update(unsigned long now) {
-    if (outputOverride) {
-        bool prev = outputState;
-        outputState = true;
-        digitalWrite(pin, HIGH);
-        if (outputState != prev) stateChangedFlag = true;
-        return;
+    if (!edgeTimer) fireDueEdges();
+    // The edges themselves were switched by the alarm; here we only record them and arm the next ones
+    const uint8_t fired = takeFiredEdges(0xFF);
+    if (cueFired) takeFiredCues();
+    const uint64_t nowUs = nowMicros();
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        updateOutput(i, now, nowUs, (fired & outputBit(i)) != 0);
+    }
+    mirrorPhases(nowUs);
+}
+
+uint32_t TimerController::msUntilNextUpdate() const {
+    if (!edgeTimer) return Defaults::LOOP_DELAY_MS; // no alarm: update() switches the edges itself
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        const uint8_t outBit = outputBit(i);
+        const Cycle& cycle = cycles[i];
+        if ((edgeArmedMask & outBit) || cycle.overridden()) continue; // the alarm wakes us, or nothing is due
+        if ((patternMask & outBit) && ((holdMask | doneMask) & outBit)) continue; // waits for a trigger
+        if (!(patternMask & outBit) && cycle.onTicks() == 0 && !cycle.cycleOn()) continue; // idle
+        return Defaults::LOOP_DELAY_MS; // re-aligning to the phase group, or a manual toggle running out
+    }
+    return UINT32_MAX;
+}
+
+uint8_t TimerController::resumePhases() {
+    if (!phaseMirror.begin()) return 0; // cold boot, or the RTC image did not survive
+    const int64_t wallNow = PhaseMirror::wallMicros();
+    const uint64_t nowUs = nowMicros();
+    uint8_t resumed = 0;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        Cycle& cycle = cycles[i];
+        PhaseMirror::Phase phase;
+        if ((patternMask & outputBit(i)) || cycle.onTicks() == 0 || !phaseMirror.load(i, phase)) continue;
+        if (phase.onUs != cycle.onTicks() || phase.offUs != cycle.offTicks()) continue;
+        const int64_t sinceUs = wallNow - phase.startWallUs;
+        if (sinceUs < 0 || sinceUs > MAX_RESUME_GAP_US) continue; // clock went backwards or a stale image
+        cancelEdge(i);
+        // Same phase start on this boot's timeline; advance() skips the periods missed
+        // while down in closed form, so the next edge lands where it would have
+        cycle.restart(nowUs - static_cast<uint64_t>(sinceUs), phase.cycleOn);
+        if (phase.overridden) cycle.setOverride(true);
+        cycle.advance(nowUs);
+        markChanged(i);
+        resumed |= outputBit(i);
     }
-    float elapsed = (now - lastSwitch) / 1000.0f;
-    currentStateSeconds = elapsed;
-    if (outputState) {
-        if (elapsed >= ton) {
-            outputState = false; stateChangedFlag = true;
-            lastSwitch = now;
-            digitalWrite(pin, LOW);
+    return resumed;
+}
+
+void TimerController::mirrorPhases(uint64_t nowUs) {
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        const uint8_t outBit = outputBit(i);
+        const Cycle& cycle = cycles[i];
+        if ((patternMask & outBit) || cycle.onTicks() == 0) {
+            if (mirroredMask & outBit) phaseMirror.clear(i);
+            mirroredMask &= ~outBit;
+            continue;
         }
-    } else {
-        if (elapsed >= toff) {
-            outputState = true; stateChangedFlag = true;
-            lastSwitch = now;
-            digitalWrite(pin, HIGH);
+        const PhaseMirror::Phase& last = mirrored[i];
+        if ((mirroredMask & outBit) && mirroredEdgeUs[i] == cycle.lastEdge() && last.cycleOn == cycle.cycleOn() &&
+            last.overridden == cycle.overridden() && last.onUs == cycle.onTicks() && last.offUs == cycle.offTicks()) {
+            continue;
+        }
+        PhaseMirror::Phase phase = {};
+        phase.startWallUs = PhaseMirror::wallMicros() - static_cast<int64_t>(nowUs - cycle.lastEdge());
+        phase.onUs = cycle.onTicks();
+        phase.offUs = cycle.offTicks();
+        phase.cycleOn = cycle.cycleOn();
+        phase.overridden = cycle.overridden();
+        phaseMirror.store(i, phase);
+        mirrored[i] = phase;
+        mirroredEdgeUs[i] = cycle.lastEdge();
+        mirroredMask |= outBit;
+    }
+}
+
+void TimerController::updateOutput(uint8_t output, unsigned long now, uint64_t nowUs, bool fired) {
+    Cycle& cycle = cycles[output];
+    const uint8_t outBit = outputBit(output);
+    if (cycle.overridden()) {
+        cancelEdge(output);
+        alignedMask &= ~outBit;
+        return;
+    }
+    if (patternMask & outBit) {
+        if (fired) {
+            stepPattern(output, edgeAtUs[output], nowUs);
+        } else if (!(edgeArmedMask & outBit) && !((holdMask | doneMask) & outBit)) {
+            startPattern(output, nowUs); // new program, or resuming after an override/reset
         }
+    } else if (cycle.onTicks() == 0) {
+        // Idle output: nothing to schedule, only let a manual toggle run out
+        cancelEdge(output);
+        if (cycle.cycleOn() && cycle.advance(nowUs)) markChanged(output);
+    } else if ((lockedMask & outBit) && clockValid) {
+        updatePhaseLocked(output, now, nowUs, fired);
+    } else if (!(edgeArmedMask & outBit)) {
+        armFreeRun(output, nowUs);
     }
 }
 
-void TimerController::setTimes(float tonSeconds, float toffSeconds) {
-    ton = tonSeconds;
-    toff = toffSeconds;
+void TimerController::armFreeRun(uint8_t output, uint64_t nowUs) {
+    Cycle& cycle = cycles[output];
+    // Stalled past the due edge (or durations shortened): the engine jumps straight to
+    // where the schedule says we are now and switches at most once.
+    if (cycle.advance(nowUs)) markChanged(output);
+    scheduleEdge(output, cycle.nextEdge(), !cycle.cycleOn());
 }
 
-void TimerController::overrideOutput(bool on) {
-    bool prev = outputState;
-    outputOverride = on;
-    digitalWrite(pin, on ? HIGH : LOW);
-    outputState = on;
-    if (outputState != prev) stateChangedFlag = true;
+void TimerController::setTimes(float tonSeconds, float toffSeconds, uint8_t output) {
+    if (!isValidOutput(output)) return;
+    if (!(patternMask & outputBit(output))) cancelEdge(output); // re-armed with the new durations on the next update()
+    ton[output] = tonSeconds;
+    toff[output] = toffSeconds;
+    cycles[output].setDurations(secondsToUs(tonSeconds), secondsToUs(toffSeconds));
+    alignedMask &= ~outputBit(output);
 }
 
-void TimerController::resetState() {
-    bool prev = outputState;
-    outputState = false;
-    lastSwitch = millis();
-    digitalWrite(pin, LOW);
-    if (outputState != prev) stateChangedFlag = true;
+void TimerController::overrideOutput(bool on, uint8_t output) {
+    if (!isValidOutput(output)) return;
+    Cycle& cycle = cycles[output];
+    cancelEdge(output);
+    bool prev = cycle.isOn();
+    if (on) {
+        cycle.setOverride(true);
+    } else if (prev) {
+        cycle.reset(nowMicros()); // "off" means off now: release and start a fresh OFF phase
+    }
+    if (cycle.isOn() != prev) markChanged(output);
+    alignedMask &= ~outputBit(output);
+    holdMask &= ~outputBit(output); // a program restarts once the override is released
+    doneMask &= ~outputBit(output);
+}
+
+void TimerController::resetState(uint8_t output) {
+    if (!isValidOutput(output)) return;
+    // Manual cycle control takes this output out of its phase group; a program restarts
+    dropPhaseLock(output);
+    holdMask &= ~outputBit(output);
+    doneMask &= ~outputBit(output);
+    cancelEdge(output);
+    if (cycles[output].isOn()) markChanged(output);
+    cycles[output].reset(nowMicros());
 }
 
-void TimerController::toggleAndReset() {
+void TimerController::toggleAndReset(uint8_t output) {
+    if (!isValidOutput(output)) return;
+    if (patternMask & outputBit(output)) {
+        triggerPattern(output); // toggle is the "go" for a program waiting in HOLD
+        return;
+    }
     // Invert current state, reset timer baseline, resume normal cycling (no permanent override)
-    outputOverride = false; // ensure override not latched
-    outputState = !outputState; stateChangedFlag = true;
-    lastSwitch = millis();
-    digitalWrite(pin, outputState ? HIGH : LOW);
+    dropPhaseLock(output);
+    cancelEdge(output);
+    cycles[output].toggle(nowMicros());
+    markChanged(output);
 }
 
-bool TimerController::isOutputOn() const {
-    return outputState;
+bool TimerController::isOutputOn(uint8_t output) const {
+    return isValidOutput(output) && cycles[output].isOn();
 }
 
-float TimerController::getTon() const {
-    return ton;
+float TimerController::getTon(uint8_t output) const {
+    return isValidOutput(output) ? ton[output] : 0.0f;
 }
 
-float TimerController::getToff() const {
-    return toff;
+float TimerController::getToff(uint8_t output) const {
+    return isValidOutput(output) ? toff[output] : 0.0f;
 }
 
-float TimerController::getCurrentStateSeconds() const {
-    return currentStateSeconds;
+float TimerController::getCurrentStateSeconds(uint8_t output) const {
+    // Computed on request: update() may sleep for a whole phase in the tickless loop
+    return isValidOutput(output) ? cycles[output].elapsed(nowMicros()) / 1000000.0f : 0.0f;
 }
 
 bool TimerController::consumeStateChanged() {
     bool v = stateChangedFlag; stateChangedFlag = false; return v;
 }
 
-bool TimerController::isOverrideActive() const {
-    return outputOverride;
+bool TimerController::isOverrideActive(uint8_t output) const {
+    return isValidOutput(output) && cycles[output].overridden();
+}
+
+void TimerController::setPhaseLock(uint32_t epochMs, uint32_t offsetMs) {
+    phaseEpochMs = epochMs;
+    phaseOffsetMs = offsetMs;
+    lockedMask = static_cast<uint8_t>(outputBit(outputCount) - 1);
+    alignedMask = 0;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        if (!(patternMask & outputBit(i))) cancelEdge(i); // programs keep their own timeline
+    }
+}
+
+void TimerController::clearPhaseLock() {
+    // The engines' phase starts are kept current while locked, so free-running resumes in phase
+    lockedMask = 0;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        if (!(patternMask & outputBit(i))) cancelEdge(i);
+    }
+}
+
+void TimerController::dropPhaseLock(uint8_t output) {
+    if (!(lockedMask & outputBit(output))) return;
+    lockedMask &= ~outputBit(output);
+    markChanged(output); // the STATUS push tells the remote this timer left the group
+}
+
+void TimerController::syncClock(uint32_t remoteMs, unsigned long localNow) {
+    int32_t offset = static_cast<int32_t>(remoteMs - static_cast<uint32_t>(localNow));
+    int32_t delta = offset - clockOffsetMs;
+    if (!clockValid || delta > PHASE_REALIGN_THRESHOLD_MS || delta < -PHASE_REALIGN_THRESHOLD_MS) {
+        alignedMask = 0;
+    }
+    if (clockValid && delta != 0 && cueCount > cueFired) {
+        // Queued cues follow the corrected timebase (a uniform shift keeps their order)
+        if (edgeTimer) esp_timer_stop(edgeTimer);
+        for (uint8_t i = cueFired; i < cueCount; ++i) {
+            cueAtUs[i] = static_cast<uint64_t>(static_cast<int64_t>(cueAtUs[i]) - static_cast<int64_t>(delta) * 1000);
+        }
+        armAlarm();
+    }
+    clockOffsetMs = offset;
+    clockValid = true;
+}
+
+uint32_t TimerController::phasePosition(unsigned long now, uint32_t periodMs) const {
+    uint32_t remoteNow = static_cast<uint32_t>(now) + static_cast<uint32_t>(clockOffsetMs);
+    int32_t since = static_cast<int32_t>(remoteNow - phaseEpochMs - phaseOffsetMs);
+    if (since >= 0) return static_cast<uint32_t>(since) % periodMs;
+    uint32_t back = static_cast<uint32_t>(-static_cast<int64_t>(since)) % periodMs;
+    return back ? periodMs - back : 0;
+}
+
+void TimerController::updatePhaseLocked(uint8_t output, unsigned long now, uint64_t nowUs, bool fired) {
+    Cycle& cycle = cycles[output];
+    const uint8_t outBit = outputBit(output);
+    uint32_t tonMs = secondsToMs(ton[output]);
+    uint32_t periodMs = tonMs + secondsToMs(toff[output]);
+    if (periodMs == 0) return;
+    uint32_t pos = phasePosition(now, periodMs);
+    unsigned long& nextEdge = nextEdgeMs[output];
+    if (!(alignedMask & outBit)) {
+        // Hard align: take the state the group timeline dictates right now
+        cancelEdge(output);
+        bool on = pos < tonMs;
+        if (cycle.markEdge(usAtMillis(now - (on ? pos : pos - tonMs), nowUs), on)) markChanged(output);
+        nextEdge = now + (on ? tonMs - pos : periodMs - pos);
+        alignedMask |= outBit;
+        scheduleEdge(output, usAtMillis(nextEdge, nowUs), !on);
+    } else if (fired) {
+        const bool on = cycle.cycleOn();
+        // Next edge comes from the timeline, so clock corrections only stretch or
+        // shorten the upcoming state instead of flipping the output back.
+        uint32_t windowStart = on ? 0 : tonMs;
+        uint32_t windowEnd = on ? tonMs : periodMs;
+        if (pos >= windowStart && pos < windowEnd) {
+            nextEdge = now + (windowEnd - pos);
+        } else {
+            uint32_t early = (windowStart + periodMs - pos) % periodMs;
+            uint32_t late = (pos + periodMs - windowEnd) % periodMs;
+            if (early <= late) nextEdge = now + early + (windowEnd - windowStart);
+            else alignedMask &= ~outBit;
+        }
+        if (alignedMask & outBit) scheduleEdge(output, usAtMillis(nextEdge, nowUs), !on);
+    } else if (!(edgeArmedMask & outBit)) {
+        scheduleEdge(output, usAtMillis(nextEdge, nowUs), !cycle.cycleOn());
+    }
+}
+
+bool TimerController::setPattern(uint8_t output, const uint8_t* code, size_t len) {
+    if (!isValidOutput(output) || !patterns[output].load(code, len)) return false;
+    const uint8_t outBit = outputBit(output);
+    cancelEdge(output);
+    patternMask |= outBit;
+    holdMask &= ~outBit;
+    doneMask &= ~outBit; // started by the next update()
+    return true;
+}
+
+void TimerController::clearPattern(uint8_t output) {
+    if (!isValidOutput(output)) return;
+    const uint8_t outBit = outputBit(output);
+    if (!(patternMask & outBit)) return;
+    cancelEdge(output);
+    patternMask &= ~outBit;
+    holdMask &= ~outBit;
+    doneMask &= ~outBit;
+    patterns[output].clear();
+    if (cycles[output].isOn()) markChanged(output);
+    cycles[output].reset(nowMicros()); // back to the ON/OFF cycle, starting OFF
+}
+
+void TimerController::triggerPattern(uint8_t output) {
+    if (!isValidOutput(output) || !(holdMask & outputBit(output))) return;
+    holdMask &= ~outputBit(output);
+    const uint64_t nowUs = nowMicros();
+    patternNext[output] = patterns[output].next();
+    stepPattern(output, nowUs, nowUs);
+}
+
+void TimerController::startPattern(uint8_t output, uint64_t nowUs) {
+    cancelEdge(output);
+    patterns[output].restart();
+    patternNext[output] = patterns[output].next();
+    stepPattern(output, nowUs, nowUs);
+}
+
+void TimerController::stepPattern(uint8_t output, uint64_t atUs, uint64_t nowUs) {
+    using PatternProgram::Segment;
+    PatternProgram::Runner& runner = patterns[output];
+    Segment seg = patternNext[output];
+    // Segments that ended while loop() was stalled are skipped, not replayed, so the
+    // program stays on its own timeline and switches at most once here
+    for (uint8_t i = 0; i < PatternProgram::MAX_STEPS && seg.kind == Segment::Timed &&
+                        atUs + seg.ms * 1000ULL <= nowUs; ++i) {
+        atUs += seg.ms * 1000ULL;
+        seg = runner.next();
+    }
+    if (cycles[output].markEdge(atUs, seg.on)) markChanged(output); // Done ends OFF
+    if (seg.kind == Segment::Done) {
+        doneMask |= outputBit(output);
+        return;
+    }
+    if (seg.kind == Segment::Hold) {
+        holdMask |= outputBit(output);
+        return;
+    }
+    patternNext[output] = runner.next();
+    scheduleEdge(output, atUs + seg.ms * 1000ULL, patternNext[output].on);
+}
+
+bool TimerController::setPulseTrain(uint8_t output, const uint16_t* durUs, uint8_t count) {
+    if (!isValidOutput(output)) return false;
+    // The alarm must not switch this output while its backend changes
+    if (edgeTimer) esp_timer_stop(edgeTimer);
+    PulseOutput& pulse = pulses[output];
+    const bool on = cycles[output].isOn();
+    bool ok = true;
+    if (count == 0) {
+        pulse.detach(on);
+    } else {
+        ok = pulse.attach(cycles[output].output().pin, durUs, count);
+        if (ok) pulse.write(on);
+    }
+    armAlarm();
+    return ok;
+}
+
+TimerController::CueResult TimerController::scheduleCue(uint16_t id, uint8_t output, uint8_t action,
+                                                        uint32_t atRemoteMs, uint16_t durationMs, unsigned long now) {
+    if (!isValidOutput(output) || action < CueActions::On || action > CueActions::Trigger ||
+        (action == CueActions::Hit && durationMs == 0)) {
+        return CueResult::Invalid;
+    }
+    if (!clockValid) return CueResult::NoClock;
+    for (uint8_t i = 0; i < cueCount; ++i) {
+        if (cueId[i] == id) return CueResult::Duplicate;
+    }
+    for (uint16_t recent : recentCueIds) {
+        if (recent == id && id != 0) return CueResult::Duplicate;
+    }
+    const uint32_t remoteNow = static_cast<uint32_t>(now) + static_cast<uint32_t>(clockOffsetMs);
+    const uint32_t ahead = atRemoteMs - remoteNow;
+    if (static_cast<int32_t>(ahead) < 0) return CueResult::Late;
+    if (ahead > CUE_HORIZON_MS) return CueResult::Invalid;
+    const uint8_t needed = action == CueActions::Hit ? 2 : 1;
+    if (cueCount + needed > MAX_CUES) return CueResult::Full;
+    const uint64_t atUs = usAtMillis(now + ahead, nowMicros());
+    if (edgeTimer) esp_timer_stop(edgeTimer);
+    insertCue(atUs, id, output, action == CueActions::Hit ? CueActions::On : action);
+    if (action == CueActions::Hit) insertCue(atUs + durationMs * 1000ULL, id, output, CueActions::Off);
+    armAlarm();
+    return CueResult::Queued;
+}
+
+void TimerController::clearCues() {
+    if (edgeTimer) esp_timer_stop(edgeTimer);
+    armDeferred = true;
+    takeFiredCues(); // already executed on the pin; finish them
+    cueCount = 0;
+    armDeferred = false;
+    armAlarm();
+}
+
+bool TimerController::insertCue(uint64_t atUs, uint16_t id, uint8_t output, uint8_t action) {
+    // Caller holds the alarm stopped. Equal times keep arrival order.
+    uint8_t pos = cueCount;
+    while (pos > cueFired && cueAtUs[pos - 1] > atUs) {
+        cueAtUs[pos] = cueAtUs[pos - 1];
+        cueId[pos] = cueId[pos - 1];
+        cueOutput[pos] = cueOutput[pos - 1];
+        cueAction[pos] = cueAction[pos - 1];
+        --pos;
+    }
+    cueAtUs[pos] = atUs;
+    cueId[pos] = id;
+    cueOutput[pos] = output;
+    cueAction[pos] = action;
+    ++cueCount;
+    return true;
+}
+
+void TimerController::takeFiredCues() {
+    if (edgeTimer) esp_timer_stop(edgeTimer);
+    // The actions below schedule edges; the alarm stays stopped until the queue is compacted
+    const bool deferred = armDeferred;
+    armDeferred = true;
+    const uint8_t fired = cueFired;
+    // The relay was already switched at the cue time; bring the schedule in line with it
+    for (uint8_t i = 0; i < fired; ++i) {
+        const uint8_t output = cueOutput[i];
+        switch (cueAction[i]) {
+            case CueActions::On: overrideOutput(true, output); break;
+            case CueActions::Off: overrideOutput(false, output); break;
+            case CueActions::Reset: resetState(output); break;
+            case CueActions::Trigger: triggerPattern(output); break;
+        }
+        if (recentCueIds[(recentCueNext + 7) % 8] != cueId[i]) {
+            recentCueIds[recentCueNext] = cueId[i];
+            recentCueNext = (recentCueNext + 1) % 8;
+        }
+    }
+    for (uint8_t i = fired; i < cueCount; ++i) {
+        cueAtUs[i - fired] = cueAtUs[i];
+        cueId[i - fired] = cueId[i];
+        cueOutput[i - fired] = cueOutput[i];
+        cueAction[i - fired] = cueAction[i];
+    }
+    cueCount -= fired;
+    cueFired = 0;
+    armDeferred = deferred;
+    armAlarm();
+}
+
+void TimerController::onEdgeTimer(void* arg) {
+    TimerController* self = static_cast<TimerController*>(arg);
+    self->fireDueEdges();
+    // The loop sleeps until told: book the switched edges and arm the next ones
+    if (self->wakeTask && (self->edgeFiredMask || self->cueFired)) xTaskNotifyGive(self->wakeTask);
+}
+
+void TimerController::fireDueEdges() {
+    // Runs in the esp_timer task, which preempts loop() and completes before it resumes.
+    // Every output whose edge is due is switched in this one dispatch.
+    const uint64_t nowUs = nowMicros();
+    // Entries are read under the lock the loop publishes them with, never half-written
+    uint64_t atUs[MAX_OUTPUTS];
+    portENTER_CRITICAL(&edgeLock);
+    const uint8_t pending = edgeArmedMask & ~edgeFiredMask;
+    const uint8_t levels = edgeLevelMask;
+    for (uint8_t i = 0; i < outputCount; ++i) atUs[i] = edgeAtUs[i];
+    portEXIT_CRITICAL(&edgeLock);
+    uint8_t fired = 0;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        const uint8_t outBit = outputBit(i);
+        if ((pending & outBit) && atUs[i] <= nowUs) {
+            cycles[i].output().write((levels & outBit) != 0);
+            recordEdge(i, (levels & outBit) != 0, false, atUs[i]);
+            fired |= outBit;
+        }
+    }
+    if (fired) {
+        portENTER_CRITICAL(&edgeLock);
+        edgeFiredMask |= fired;
+        portEXIT_CRITICAL(&edgeLock);
+    }
+    // Cues after edges, so a cue wins over a cycle edge due at the same moment
+    uint8_t cue = cueFired;
+    while (cue < cueCount && cueAtUs[cue] <= nowUs) {
+        RelayPin& relay = cycles[cueOutput[cue]].output();
+        switch (cueAction[cue]) {
+            case CueActions::On:
+                relay.write(true);
+                recordEdge(cueOutput[cue], true, true, cueAtUs[cue]);
+                break;
+            case CueActions::Off:
+            case CueActions::Reset:
+                relay.write(false);
+                recordEdge(cueOutput[cue], false, true, cueAtUs[cue]);
+                break;
+            default: break; // Trigger: the program's first step is applied by update()
+        }
+        ++cue;
+    }
+    cueFired = cue;
+    armAlarm();
+}
+
+void TimerController::recordEdge(uint8_t output, bool on, bool cue, uint64_t scheduledUs) {
+    const uint64_t actualUs = nowMicros();
+    const uint64_t late = actualUs > scheduledUs ? actualUs - scheduledUs : 0;
+    const uint32_t lateUs = late > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(late);
+    portENTER_CRITICAL(&edgeLock);
+    ++edgeTiming.count;
+    if (lateUs > edgeTiming.maxLateUs) edgeTiming.maxLateUs = lateUs;
+    ++edgeTiming.histogram[latenessBucket(lateUs)];
+    edgeTiming.recent[edgeTiming.next] = EdgeRecord{scheduledUs, lateUs, output, on, cue};
+    edgeTiming.next = static_cast<uint8_t>((edgeTiming.next + 1) % EDGE_HISTORY);
+    portEXIT_CRITICAL(&edgeLock);
+}
+
+void TimerController::getEdgeTiming(EdgeTiming& out, bool reset) {
+    portENTER_CRITICAL(&edgeLock);
+    out = edgeTiming;
+    if (reset) edgeTiming = EdgeTiming{};
+    portEXIT_CRITICAL(&edgeLock);
+}
+
+void TimerController::armAlarm() {
+    if (!edgeTimer || armDeferred) return;
+    esp_timer_stop(edgeTimer);
+    uint64_t atUs = cueFired < cueCount ? cueAtUs[cueFired] : UINT64_MAX;
+    portENTER_CRITICAL(&edgeLock);
+    const uint8_t pending = edgeArmedMask & ~edgeFiredMask;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        if ((pending & outputBit(i)) && edgeAtUs[i] < atUs) atUs = edgeAtUs[i];
+    }
+    portEXIT_CRITICAL(&edgeLock);
+    if (atUs == UINT64_MAX) return;
+    int64_t delayUs = static_cast<int64_t>(atUs - nowMicros());
+    esp_timer_start_once(edgeTimer, delayUs > 0 ? static_cast<uint64_t>(delayUs) : 0);
+}
+
+void TimerController::scheduleEdge(uint8_t output, uint64_t atUs, bool level) {
+    const uint8_t outBit = outputBit(output);
+    cancelEdge(output);
+    // Time, level and armed bit are published together, so the alarm never sees a half-set entry
+    portENTER_CRITICAL(&edgeLock);
+    edgeAtUs[output] = atUs;
+    if (level) edgeLevelMask |= outBit;
+    else edgeLevelMask &= ~outBit;
+    edgeArmedMask |= outBit;
+    portEXIT_CRITICAL(&edgeLock);
+    armAlarm();
+}
+
+void TimerController::cancelEdge(uint8_t output) {
+    const uint8_t outBit = outputBit(output);
+    if (!(edgeArmedMask & outBit)) return;
+    // Disarmed and checked in one step: the alarm either switched the pin already, and the
+    // edge is accounted for here, or it will skip the entry
+    portENTER_CRITICAL(&edgeLock);
+    edgeArmedMask &= ~outBit;
+    const bool fired = (edgeFiredMask & outBit) != 0;
+    edgeFiredMask &= ~outBit;
+    portEXIT_CRITICAL(&edgeLock);
+    if (fired) {
+        cycles[output].markEdge(edgeAtUs[output], (edgeLevelMask & outBit) != 0);
+        markChanged(output);
+    }
+}
+
+uint8_t TimerController::takeFiredEdges(uint8_t mask) {
+    portENTER_CRITICAL(&edgeLock);
+    const uint8_t fired = edgeFiredMask & mask;
+    edgeFiredMask &= ~fired;
+    edgeArmedMask &= ~fired;
+    portEXIT_CRITICAL(&edgeLock);
+    if (!fired) return 0;
+    for (uint8_t i = 0; i < outputCount; ++i) {
+        const uint8_t outBit = outputBit(i);
+        if (fired & outBit) cycles[i].markEdge(edgeAtUs[i], (edgeLevelMask & outBit) != 0); // pin already switched
+    }
+    if (fired & outputBit(0)) markChanged(0);
+    return fired;
 }
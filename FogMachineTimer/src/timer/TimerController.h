@@ -2,28 +2,174 @@
 // Implements the fog machine timer logic: manages ON/OFF cycles and output control.
 #pragma once
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "CycleEngine.h"
+#include "PatternProgram.h"
+#include "Defaults.h"
+#include "timer/PulseOutput.h"
+#include "timer/PhaseMirror.h"
 
+// Drives up to MAX_OUTPUTS relays, each with its own ON/OFF cycle. Output 0 is the
+// fog relay; the single-output API below addresses it by default.
+// Relay edges are switched from one esp_timer armed for the earliest pending edge of
+// any output; update() from loop() only does bookkeeping and re-arms after each edge.
 class TimerController {
 public:
-    TimerController(uint8_t outputPin);
+    static constexpr uint8_t MAX_OUTPUTS = Defaults::MAX_OUTPUTS;
+    TimerController(const uint8_t* outputPins, uint8_t count);
+    // Output 0 starts with the given times; the others stay idle until setTimes()
     void begin(float tonSeconds, float toffSeconds);
     void update(unsigned long now);
-    void setTimes(float tonSeconds, float toffSeconds);
-    void overrideOutput(bool on);
-    void resetState();
-    void toggleAndReset();
-        bool consumeStateChanged();
-    bool isOutputOn() const;
-    float getTon() const;
-    float getToff() const;
-    float getCurrentStateSeconds() const;
-    bool isOverrideActive() const;
+    // After a warm reset, continue each cycling output in the phase mirrored to RTC memory,
+    // counting the time spent down. Call once the stored times are applied; returns the
+    // resumed outputs (bit i = output i). Step programs restart instead.
+    uint8_t resumePhases();
+    // Tickless loop support: the edge alarm notifies this task once it switched something,
+    // and msUntilNextUpdate() says how long update() can wait otherwise (UINT32_MAX = until notified).
+    void setWakeTask(TaskHandle_t task) { wakeTask = task; }
+    uint32_t msUntilNextUpdate() const;
+    uint8_t getOutputCount() const { return outputCount; }
+    bool isValidOutput(uint8_t output) const { return output < outputCount; }
+    // ton == 0 keeps an output idle (OFF) apart from manual toggles/overrides
+    void setTimes(float tonSeconds, float toffSeconds, uint8_t output = 0);
+    void overrideOutput(bool on, uint8_t output = 0);
+    void resetState(uint8_t output = 0);
+    void toggleAndReset(uint8_t output = 0);
+    bool consumeStateChanged(); // fog output only (level or phase lock): it drives the STATUS push
+    bool isOutputOn(uint8_t output = 0) const;
+    float getTon(uint8_t output = 0) const;
+    float getToff(uint8_t output = 0) const;
+    float getCurrentStateSeconds(uint8_t output = 0) const;
+    bool isOverrideActive(uint8_t output = 0) const;
+    // Fleet phase lock: edges follow the remote's timebase instead of the free-running schedule.
+    // ON edges land on epochMs + phaseOffsetMs + k*(ton+toff) in remote millis(), per output.
+    void setPhaseLock(uint32_t epochMs, uint32_t phaseOffsetMs);
+    void clearPhaseLock();
+    void syncClock(uint32_t remoteMs, unsigned long localNow);
+    bool isPhaseLocked(uint8_t output = 0) const { return (lockedMask & outputBit(output)) != 0; }
+    // Step programs (lib/PatternProgram) replace an output's ON/OFF cycle until cleared.
+    // The edge after the current segment is always precomputed and armed in the alarm.
+    bool setPattern(uint8_t output, const uint8_t* code, size_t len);
+    void clearPattern(uint8_t output);
+    void triggerPattern(uint8_t output); // releases a HOLD step
+    bool isPatternActive(uint8_t output) const { return (patternMask & outputBit(output)) != 0; }
+    bool isPatternHolding(uint8_t output) const { return (holdMask & outputBit(output)) != 0; }
+    // Timestamped cues (CueActions) in the remote timebase; the edge alarm switches the
+    // relay at the cue time and update() applies the rest of the action afterwards.
+    enum class CueResult : uint8_t { Queued, Duplicate, NoClock, Late, Full, Invalid };
+    static constexpr uint8_t MAX_CUES = 16;
+    CueResult scheduleCue(uint16_t id, uint8_t output, uint8_t action, uint32_t atRemoteMs,
+                          uint16_t durationMs, unsigned long now);
+    void clearCues();
+    uint8_t getPendingCues() const { return cueCount; }
+    // Output backend: with a pulse train (PulseOutput durations) the output's ON phases
+    // replay it from the RMT peripheral instead of holding the pin HIGH; count 0 = GPIO.
+    bool setPulseTrain(uint8_t output, const uint16_t* durUs, uint8_t count);
+    bool isPulseOutput(uint8_t output) const { return isValidOutput(output) && pulses[output].attached(); }
+    // Edge timing instrumentation: each switch made by the alarm is timestamped right after
+    // the pin write and compared with its scheduled time.
+    static constexpr uint8_t EDGE_HISTORY = 8;
+    static constexpr uint8_t LATENESS_BUCKETS = 10; // 0: < 16 us, k: [8 << k, 16 << k) us, last open-ended
+    struct EdgeRecord {
+        uint64_t scheduledUs;
+        uint32_t lateUs;
+        uint8_t output;
+        bool on;
+        bool cue;
+    };
+    struct EdgeTiming {
+        uint32_t count;
+        uint32_t maxLateUs;
+        uint32_t histogram[LATENESS_BUCKETS];
+        EdgeRecord recent[EDGE_HISTORY]; // ring, recent[next] is the oldest once full
+        uint8_t next;
+    };
+    void getEdgeTiming(EdgeTiming& out, bool reset = false);
 private:
-    uint8_t pin;
-    float ton, toff;
-    bool outputOverride;
-    bool outputState;
-    unsigned long lastSwitch;
-    float currentStateSeconds;
-        bool stateChangedFlag=false;
+    // Every level change (engine, alarm, cues) goes through here
+    struct RelayPin {
+        uint8_t pin = 0;
+        PulseOutput* pulse = nullptr;
+        void write(bool on) {
+            if (pulse && pulse->attached()) pulse->write(on);
+            else digitalWrite(pin, on ? HIGH : LOW);
+        }
+    };
+    using Cycle = CycleEngine::Engine<uint64_t, RelayPin>;
+    static constexpr uint8_t outputBit(uint8_t output) { return static_cast<uint8_t>(1u << output); }
+
+    // Per-output schedule, one column per field (bit i of a mask = output i).
+    // Each cycle is the shared fixed-point engine on the esp_timer timebase (microseconds);
+    // edges are scheduled from the previous *scheduled* edge, never from observed time.
+    uint8_t outputCount;
+    Cycle cycles[MAX_OUTPUTS];
+    PulseOutput pulses[MAX_OUTPUTS];
+    float ton[MAX_OUTPUTS];  // as configured, for STATUS; the engine holds the rounded microseconds
+    float toff[MAX_OUTPUTS];
+    unsigned long nextEdgeMs[MAX_OUTPUTS]; // phase-locked: next edge on the local millis() timeline
+    uint8_t lockedMask = 0;
+    uint8_t alignedMask = 0;
+    bool stateChangedFlag = false;
+    void markChanged(uint8_t output) { if (output == 0) stateChangedFlag = true; }
+    // Phase lock clock (remote time = local millis() + clockOffsetMs)
+    bool clockValid = false;
+    int32_t clockOffsetMs = 0;
+    uint32_t phaseEpochMs = 0;
+    uint32_t phaseOffsetMs = 0;
+    // Pattern state: patternNext is the segment that starts when the armed edge fires
+    PatternProgram::Runner patterns[MAX_OUTPUTS];
+    PatternProgram::Segment patternNext[MAX_OUTPUTS];
+    uint8_t patternMask = 0;
+    uint8_t holdMask = 0;
+    uint8_t doneMask = 0;
+    void startPattern(uint8_t output, uint64_t nowUs);
+    void stepPattern(uint8_t output, uint64_t atUs, uint64_t nowUs);
+    void updateOutput(uint8_t output, unsigned long now, uint64_t nowUs, bool fired);
+    void armFreeRun(uint8_t output, uint64_t nowUs);
+    void updatePhaseLocked(uint8_t output, unsigned long now, uint64_t nowUs, bool fired);
+    uint32_t phasePosition(unsigned long now, uint32_t periodMs) const;
+    void dropPhaseLock(uint8_t output);
+
+    // Edge queue shared by all outputs. Every public mutator runs on the loop task (EspNowComm
+    // hands received frames to loop() instead of handling them on the Wi-Fi task), so the loop
+    // is the only writer of the time/level/armed columns; it writes them under edgeLock and the
+    // alarm reads them under it. The alarm only switches pins and sets fired bits (polled from
+    // update() if no esp_timer).
+    esp_timer_handle_t edgeTimer = nullptr;
+    portMUX_TYPE edgeLock = portMUX_INITIALIZER_UNLOCKED;
+    uint64_t edgeAtUs[MAX_OUTPUTS];
+    uint8_t edgeArmedMask = 0;
+    uint8_t edgeLevelMask = 0;
+    volatile uint8_t edgeFiredMask = 0;
+    // Cue queue, ordered by time. Entries [0, cueFired) were executed by the alarm and
+    // wait for update(); the loop only reorders or removes entries with the alarm stopped.
+    uint64_t cueAtUs[MAX_CUES];
+    uint16_t cueId[MAX_CUES];
+    uint8_t cueOutput[MAX_CUES];
+    uint8_t cueAction[MAX_CUES];
+    uint8_t cueCount = 0;
+    volatile uint8_t cueFired = 0;
+    uint16_t recentCueIds[8] = {}; // executed ids, so a late retry is not queued again
+    uint8_t recentCueNext = 0;
+    bool insertCue(uint64_t atUs, uint16_t id, uint8_t output, uint8_t action);
+    void takeFiredCues();
+    // RTC copy of each output's phase, rewritten only when an edge or override changes it
+    PhaseMirror phaseMirror;
+    uint64_t mirroredEdgeUs[MAX_OUTPUTS] = {};
+    PhaseMirror::Phase mirrored[MAX_OUTPUTS] = {};
+    uint8_t mirroredMask = 0;
+    void mirrorPhases(uint64_t nowUs);
+    EdgeTiming edgeTiming = {}; // written by the alarm under edgeLock
+    void recordEdge(uint8_t output, bool on, bool cue, uint64_t scheduledUs);
+    TaskHandle_t wakeTask = nullptr;
+    static void onEdgeTimer(void* arg);
+    void fireDueEdges();
+    // While set, armAlarm() leaves the alarm stopped; the caller arms once its edit is done
+    bool armDeferred = false;
+    void armAlarm();
+    void scheduleEdge(uint8_t output, uint64_t atUs, bool level);
+    void cancelEdge(uint8_t output);
+    uint8_t takeFiredEdges(uint8_t mask);
 };
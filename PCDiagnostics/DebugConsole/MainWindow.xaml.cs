@@ -121,6 +121,10 @@ public partial class MainWindow : Window
     private async void GetTimerStatsButton_OnClick(object sender, RoutedEventArgs e) =>
         await ExecuteCommandAsync(DebugProtocol.Command.GetTimerStats, Array.Empty<byte>(), "GetTimerStats");
 
+    private async void GetEdgeTimingButton_OnClick(object sender, RoutedEventArgs e) =>
+        await ExecuteCommandAsync(DebugProtocol.Command.GetEdgeTiming,
+            new[] { ResetEdgeTimingCheck.IsChecked == true ? (byte)1 : (byte)0 }, "GetEdgeTiming");
+
     private async void SetChannelButton_OnClick(object sender, RoutedEventArgs e)
     {
         if (!byte.TryParse(ChannelInput.Text, out byte channel) || channel < 1 || channel > 13)
@@ -425,6 +429,9 @@ public partial class MainWindow : Window
             case DebugProtocol.Command.GetTimerStats:
                 HandleTimerStats(packet);
                 break;
+            case DebugProtocol.Command.GetEdgeTiming:
+                HandleEdgeTiming(packet);
+                break;
             case DebugProtocol.Command.GetRssi:
                 HandleRssiReport(packet);
                 break;
@@ -522,6 +529,38 @@ public partial class MainWindow : Window
         UpdateTimerControlState();
     }
 
+    private void HandleEdgeTiming(DebugProtocol.Packet packet)
+    {
+        var header = ExtractStruct<DebugProtocol.EdgeTimingPayload>(packet);
+        if (header == null) return;
+        var timing = header.Value;
+        byte[] payload = CopyPayload(packet);
+        var sb = new StringBuilder();
+        sb.Append($"edges={timing.EdgeCount} max late={timing.MaxLateUs} us\n");
+        unsafe
+        {
+            for (int i = 0; i < DebugProtocol.EdgeTimingBuckets; i++)
+            {
+                string range = i == 0 ? "<16us"
+                    : i == DebugProtocol.EdgeTimingBuckets - 1 ? $">={FormatMicros(8 << i)}"
+                    : $"{FormatMicros(8 << i)}-{FormatMicros(16 << i)}";
+                sb.Append($"{range}: {timing.Histogram[i]}  ");
+            }
+        }
+        int headerSize = Marshal.SizeOf<DebugProtocol.EdgeTimingPayload>();
+        int entries = Math.Min(timing.EntryCount, DebugProtocol.EdgeTimingMaxEntries);
+        for (int i = 0; i < entries && headerSize + (i + 1) * DebugProtocol.EdgeTimingEntrySize <= payload.Length; i++)
+        {
+            var entry = MemoryMarshal.Read<DebugProtocol.EdgeTimingEntry>(payload.AsSpan(headerSize + i * DebugProtocol.EdgeTimingEntrySize));
+            string edge = (entry.Flags & DebugProtocol.EdgeFlagOn) != 0 ? "ON" : "OFF";
+            string source = (entry.Flags & DebugProtocol.EdgeFlagCue) != 0 ? " cue" : string.Empty;
+            sb.Append($"\nout{entry.Output} {edge}{source} @{entry.ScheduledMs} ms late {entry.LateUs} us");
+        }
+        EdgeTimingText.Text = sb.ToString();
+    }
+
+    private static string FormatMicros(int us) => us >= 1000 ? $"{us / 1000}ms" : $"{us}us";
+
     private void HandleRssiReport(DebugProtocol.Packet packet)
     {
         byte[] payload = CopyPayload(packet);
@@ -38,7 +38,15 @@ public static class DebugProtocol
         UnpairDevice = 17,
         RenameDevice = 18,
         SetTimerValues = 19,
-        SetTimerOutput = 20
+        SetTimerOutput = 20,
+        SetGroupMembership = 21,
+        GroupCommand = 22,
+        ConfigureDevice = 23,
+        OutputCommand = 24,
+        PatternCommand = 25,
+        ScheduleCue = 26,
+        PulseTrain = 27,
+        GetEdgeTiming = 28
     }
 
     public enum Status : byte
@@ -122,6 +130,32 @@ public static class DebugProtocol
         public SerialLinkSummary SerialLink;
     }
 
+    public const int EdgeTimingBuckets = 10; // bucket 0: < 16 us, bucket k: [8 << k, 16 << k) us, last open-ended
+    public const int EdgeTimingEntrySize = 8; // bytes per EdgeTimingEntry
+    public const int EdgeTimingMaxEntries = 8;
+    public const byte EdgeFlagOn = 0x01;
+    public const byte EdgeFlagCue = 0x02;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct EdgeTimingEntry
+    {
+        public uint ScheduledMs;
+        public ushort LateUs;
+        public byte Output;
+        public byte Flags;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public unsafe struct EdgeTimingPayload
+    {
+        public uint EdgeCount;
+        public uint MaxLateUs;
+        public fixed ushort Histogram[EdgeTimingBuckets];
+        public byte EntryCount;
+        private fixed byte _reserved[3];
+        // Entries follow immediately in payload (EdgeTimingEntrySize * EdgeTimingMaxEntries bytes, newest first)
+    }
+
     public const int InventoryEntrySize = 20; // bytes per DeviceInventoryEntry
     public const int InventoryMaxEntries = 4;
 
@@ -203,6 +237,14 @@ public static class DebugProtocol
         Command.RenameDevice => "RenameDevice",
         Command.SetTimerValues => "SetTimerValues",
         Command.SetTimerOutput => "SetTimerOutput",
+        Command.SetGroupMembership => "SetGroupMembership",
+        Command.GroupCommand => "GroupCommand",
+        Command.ConfigureDevice => "ConfigureDevice",
+        Command.OutputCommand => "OutputCommand",
+        Command.PatternCommand => "PatternCommand",
+        Command.ScheduleCue => "ScheduleCue",
+        Command.PulseTrain => "PulseTrain",
+        Command.GetEdgeTiming => "GetEdgeTiming",
         _ => command.ToString()
     };
 
@@ -0,0 +1,597 @@
+#include "ConfigLog.h"
+
+#include <string.h>
+
+namespace ConfigLog {
+
+namespace {
+
+constexpr uint32_t SECTOR_MAGIC = 0x474C4643; // "CFLG"
+constexpr uint8_t FLAG_TOMBSTONE = 0x01;
+constexpr uint8_t ERASED_BYTE = 0xFF;
+
+struct SectorHeader {
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t seqCheck; // ~seq, so a header torn while opening the sector reads as invalid
+};
+
+struct RecordHeader {
+    uint8_t key;
+    uint8_t len;
+    uint8_t flags;
+    uint8_t follow; // records of the same commit after this one
+    uint32_t crc;
+};
+
+static_assert(sizeof(SectorHeader) == 12, "SectorHeader layout");
+static_assert(sizeof(RecordHeader) == 8, "RecordHeader layout");
+
+uint32_t padded(uint8_t len) {
+    return (static_cast<uint32_t>(len) + 3u) & ~3u;
+}
+
+uint32_t recordBytes(uint8_t len) {
+    return sizeof(RecordHeader) + padded(len);
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t recordCrc(const RecordHeader& hdr, const uint8_t* value) {
+    const uint32_t crc = crc32(0, reinterpret_cast<const uint8_t*>(&hdr), 4);
+    return crc32(crc, value, hdr.len);
+}
+
+bool isErased(const void* data, size_t len) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        if (bytes[i] != ERASED_BYTE) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool Batch::add(uint8_t key, const void* value, size_t len, uint8_t flags) {
+    if (len > MAX_VALUE_BYTES || (len && !value)) return false;
+    int slot = find(key);
+    if (slot < 0) {
+        if (count == CAPACITY) return false;
+        slot = count++;
+    }
+    recs[slot] = Record{key, static_cast<uint8_t>(len), flags};
+    if (len) memcpy(data[slot], value, len);
+    return true;
+}
+
+bool Batch::stage(uint8_t key, const void* value, size_t len) {
+    return add(key, value, len, 0);
+}
+
+bool Batch::stageErase(uint8_t key) {
+    return add(key, nullptr, 0, FLAG_TOMBSTONE);
+}
+
+int Batch::find(uint8_t key) const {
+    for (uint8_t i = 0; i < count; ++i) {
+        if (recs[i].key == key) return i;
+    }
+    return -1;
+}
+
+void Batch::removeAt(uint8_t slot) {
+    --count;
+    if (slot == count) return;
+    recs[slot] = recs[count];
+    memcpy(data[slot], data[count], MAX_VALUE_BYTES);
+}
+
+bool Store::begin(const FlashRegion& flash) {
+    std::lock_guard<std::mutex> writer(writeMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        mounted = false;
+        overlay.clear();
+        flushing.clear();
+        stats = Stats{};
+    }
+    if (!flash.read || !flash.write || !flash.erase || flash.sectorCount < MIN_SECTORS ||
+        flash.sectorCount > MAX_SECTORS || flash.sectorSize < 512 || (flash.sectorSize & 3u)) {
+        return false;
+    }
+    region = flash;
+    bool ok = true;
+    for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+        uint8_t used = 0;
+        if (!scan(used)) return false;
+        if (used == 0) {
+            ok = formatWriter();
+            break;
+        }
+        // The sector after the head must stay erased for advance(); a power cut during
+        // compaction leaves it holding records that have not all been copied forward yet.
+        const uint8_t spare = static_cast<uint8_t>((head + 1) % region.sectorCount);
+        if (seqOf[spare] == 0 || compact(spare)) break;
+        // A torn copy closed the head early. Commits wait for compaction to finish, so the
+        // head holds only copies whose originals are still in the spare: drop it and replay.
+        if (!eraseSector(head)) break;
+    }
+    // If recovery failed, reads still work and commits fail until format()
+    std::lock_guard<std::mutex> lock(mutex);
+    mounted = ok;
+    return ok;
+}
+
+bool Store::ready() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return mounted;
+}
+
+bool Store::scan(uint8_t& used) {
+    for (uint8_t key = 0; key < MAX_KEYS; ++key) {
+        index[key] = NO_RECORD;
+        lengths[key] = 0;
+    }
+    uint8_t order[MAX_SECTORS];
+    used = 0;
+    for (uint8_t sector = 0; sector < region.sectorCount; ++sector) {
+        SectorHeader hdr;
+        seqOf[sector] = 0;
+        if (!region.read(region.ctx, sector * region.sectorSize, &hdr, sizeof(hdr))) return false;
+        if (hdr.magic == SECTOR_MAGIC && hdr.seq != 0 && hdr.seqCheck == ~hdr.seq) {
+            seqOf[sector] = hdr.seq;
+            // Keep replay order by sequence, oldest first
+            uint8_t at = used++;
+            while (at > 0 && seqOf[order[at - 1]] > hdr.seq) {
+                order[at] = order[at - 1];
+                --at;
+            }
+            order[at] = sector;
+        } else if (!sectorErased(sector) && !eraseSector(sector)) {
+            return false; // power cut during an erase or foreign data
+        }
+    }
+    for (uint8_t i = 0; i < used; ++i) {
+        head = order[i];
+        replaySector(head); // the last call leaves writeOff at the head's tail
+    }
+    if (used) nextSeq = seqOf[head] + 1;
+    return true;
+}
+void Store::replaySector(uint8_t sector) {
+    struct Pending {
+        uint8_t key;
+        uint8_t len;
+        uint8_t flags;
+        uint32_t at;
+    };
+    Pending group[MAX_BATCH];
+    uint8_t grouped = 0;
+    uint8_t expectFollow = 0;
+    const uint32_t end = (static_cast<uint32_t>(sector) + 1) * region.sectorSize;
+    uint32_t off = sector * region.sectorSize + sizeof(SectorHeader);
+    while (off + sizeof(RecordHeader) <= end) {
+        RecordHeader hdr;
+        uint8_t value[MAX_VALUE_BYTES];
+        if (!region.read(region.ctx, off, &hdr, sizeof(hdr))) {
+            off = end;
+            break;
+        }
+        if (isErased(&hdr, sizeof(hdr))) break;
+        if (hdr.key >= MAX_KEYS || hdr.len > MAX_VALUE_BYTES || hdr.follow >= MAX_BATCH ||
+            off + recordBytes(hdr.len) > end ||
+            !region.read(region.ctx, off + sizeof(hdr), value, hdr.len) ||
+            recordCrc(hdr, value) != hdr.crc) {
+            off = end; // torn record: nothing is appended behind it
+            break;
+        }
+        if (grouped && hdr.follow != expectFollow) {
+            grouped = 0; // an earlier commit never finished
+        }
+        group[grouped++] = Pending{hdr.key, hdr.len, hdr.flags, off};
+        expectFollow = static_cast<uint8_t>(hdr.follow - 1);
+        if (hdr.follow == 0) {
+            for (uint8_t i = 0; i < grouped; ++i) {
+                const bool gone = (group[i].flags & FLAG_TOMBSTONE) != 0;
+                index[group[i].key] = gone ? NO_RECORD : group[i].at;
+                lengths[group[i].key] = gone ? 0 : group[i].len;
+            }
+            grouped = 0;
+        }
+        off += recordBytes(hdr.len);
+    }
+    // Appending right behind an unfinished commit could complete it by accident
+    writeOff = grouped ? end : off;
+}
+
+bool Store::sectorErased(uint8_t sector) const {
+    uint8_t chunk[64];
+    const uint32_t base = sector * region.sectorSize;
+    for (uint32_t off = 0; off < region.sectorSize; off += sizeof(chunk)) {
+        const size_t n = region.sectorSize - off < sizeof(chunk) ? region.sectorSize - off : sizeof(chunk);
+        if (!region.read(region.ctx, base + off, chunk, n) || !isErased(chunk, n)) return false;
+    }
+    return true;
+}
+
+bool Store::eraseSector(uint8_t sector) {
+    if (!region.erase(region.ctx, sector)) return false;
+    seqOf[sector] = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.erases++;
+    return true;
+}
+
+bool Store::openSector(uint8_t sector) {
+    const SectorHeader hdr{SECTOR_MAGIC, nextSeq, ~nextSeq};
+    if (!region.write(region.ctx, sector * region.sectorSize, &hdr, sizeof(hdr))) return false;
+    seqOf[sector] = nextSeq++;
+    head = sector;
+    writeOff = sector * region.sectorSize + sizeof(SectorHeader);
+    return true;
+}
+
+bool Store::advance() {
+    const uint8_t next = static_cast<uint8_t>((head + 1) % region.sectorCount);
+    if (seqOf[next] != 0 || !openSector(next)) return false;
+    const uint8_t oldest = static_cast<uint8_t>((next + 1) % region.sectorCount);
+    return seqOf[oldest] == 0 || compact(oldest);
+}
+
+bool Store::compact(uint8_t sector) {
+    for (uint8_t key = 0; key < MAX_KEYS; ++key) {
+        if (index[key] == NO_RECORD || sectorOf(index[key]) != sector) continue;
+        uint8_t value[MAX_VALUE_BYTES];
+        uint32_t at = 0;
+        if (writeOff + recordBytes(lengths[key]) > headEnd() ||
+            !region.read(region.ctx, index[key] + sizeof(RecordHeader), value, lengths[key]) ||
+            !append(key, value, lengths[key], 0, 0, at)) {
+            return false;
+        }
+        // Readers move to the copy before the erase below can pull the original away
+        std::lock_guard<std::mutex> lock(mutex);
+        index[key] = at;
+    }
+    return eraseSector(sector);
+}
+
+bool Store::append(uint8_t key, const void* data, uint8_t len, uint8_t flags, uint8_t follow, uint32_t& at) {
+    uint8_t buf[sizeof(RecordHeader) + MAX_VALUE_BYTES + 3];
+    RecordHeader hdr{key, len, flags, follow, 0};
+    memset(buf, ERASED_BYTE, sizeof(buf));
+    memcpy(buf + sizeof(hdr), data, len);
+    hdr.crc = recordCrc(hdr, buf + sizeof(hdr));
+    memcpy(buf, &hdr, sizeof(hdr));
+    const uint32_t bytes = recordBytes(len);
+    if (!region.write(region.ctx, writeOff, buf, bytes)) {
+        writeOff = headEnd(); // the tail is unknown now; continue in the next sector
+        return false;
+    }
+    at = writeOff;
+    writeOff += bytes;
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.appends++;
+    return true;
+}
+
+const Batch* Store::pending(uint8_t key, int& slot) const {
+    slot = overlay.find(key);
+    if (slot >= 0) return &overlay;
+    slot = flushing.find(key);
+    return slot >= 0 ? &flushing : nullptr;
+}
+
+bool Store::empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!mounted) return true;
+    for (uint8_t key = 0; key < MAX_KEYS; ++key) {
+        int d = 0;
+        const Batch* p = pending(key, d);
+        if (p ? !(p->recs[d].flags & FLAG_TOMBSTONE) : index[key] != NO_RECORD) return false;
+    }
+    return true;
+}
+
+bool Store::contains(uint8_t key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!mounted || key >= MAX_KEYS) return false;
+    int d = 0;
+    const Batch* p = pending(key, d);
+    return p ? !(p->recs[d].flags & FLAG_TOMBSTONE) : index[key] != NO_RECORD;
+}
+
+size_t Store::size(uint8_t key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!mounted || key >= MAX_KEYS) return 0;
+    int d = 0;
+    const Batch* p = pending(key, d);
+    if (p) return p->recs[d].len; // 0 for a tombstone
+    return index[key] == NO_RECORD ? 0 : lengths[key];
+}
+
+size_t Store::read(uint8_t key, void* out, size_t cap) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!mounted || key >= MAX_KEYS) return 0;
+    int d = 0;
+    if (const Batch* p = pending(key, d)) {
+        const size_t n = cap < p->recs[d].len ? cap : p->recs[d].len;
+        if (n) memcpy(out, p->data[d], n);
+        return p->recs[d].len;
+    }
+    if (index[key] == NO_RECORD) return 0;
+    const size_t n = cap < lengths[key] ? cap : lengths[key];
+    if (n && !region.read(region.ctx, index[key] + sizeof(RecordHeader), out, n)) return 0;
+    return lengths[key];
+}
+
+bool Store::matchesFlash(const Record& rec, const uint8_t* data) const {
+    if (rec.flags & FLAG_TOMBSTONE) return index[rec.key] == NO_RECORD;
+    if (index[rec.key] == NO_RECORD || lengths[rec.key] != rec.len) return false;
+    uint8_t current[MAX_VALUE_BYTES];
+    return rec.len == 0 || (region.read(region.ctx, index[rec.key] + sizeof(RecordHeader), current, rec.len) &&
+                            memcmp(current, data, rec.len) == 0);
+}
+
+bool Store::matchesStored(const Record& rec, const uint8_t* data) const {
+    const int f = flushing.find(rec.key);
+    if (f < 0) return matchesFlash(rec, data);
+    return flushing.recs[f].flags == rec.flags && flushing.recs[f].len == rec.len &&
+           (rec.len == 0 || memcmp(flushing.data[f], data, rec.len) == 0);
+}
+
+void Store::countFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.failures++;
+}
+
+bool Store::put(uint8_t key, const void* data, size_t len) {
+    if (len > MAX_VALUE_BYTES || (len && !data)) {
+        countFailure();
+        return false;
+    }
+    const Record rec{key, static_cast<uint8_t>(len), 0};
+    Values value;
+    if (len) memcpy(value, data, len);
+    return commitRecords(&rec, &value, 1);
+}
+
+bool Store::erase(uint8_t key) {
+    const Record rec{key, 0, FLAG_TOMBSTONE};
+    Values none; // a tombstone carries no value
+    return commitRecords(&rec, &none, 1);
+}
+
+bool Store::commit(Batch& batch) {
+    const bool ok = batch.empty() || commitRecords(batch.recs, batch.data, batch.count);
+    batch.clear();
+    return ok;
+}
+
+bool Store::commitRecords(const Record* recs, const Values* data, uint8_t count) {
+    for (uint8_t i = 0; i < count; ++i) {
+        if (recs[i].key >= MAX_KEYS) {
+            countFailure();
+            return false;
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!mounted) {
+            stats.failures++;
+            return false;
+        }
+        // Write-back only touches RAM, so it never waits for a flush in progress
+        if (writeBack) return deferLocked(recs, data, count, lock);
+    }
+    std::unique_lock<std::mutex> writer(writeMutex);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (writeBack) { // switched on while this waited for the writer lock
+            writer.unlock();
+            return deferLocked(recs, data, count, lock);
+        }
+        if (!mounted) {
+            stats.failures++;
+            return false;
+        }
+    }
+    // Without write-back the overlays are empty, so flash holds the current values
+    uint32_t keep = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (!matchesFlash(recs[i], data[i])) keep |= 1u << i;
+    }
+    if (keep == 0) return true; // rewriting the current values would only burn flash
+    if (!writeBatch(recs, data, count, keep)) {
+        countFailure();
+        return false;
+    }
+    return true;
+}
+
+bool Store::deferLocked(const Record* recs, const Values* data, uint8_t count, std::unique_lock<std::mutex>& lock) {
+    for (bool waited = false;; waited = true) {
+        uint8_t added = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (overlay.find(recs[i].key) < 0 && !matchesStored(recs[i], data[i])) ++added;
+        }
+        if (overlay.size() + added <= MAX_BATCH) break;
+        // The overlay is written as one group, so it can hold no more than one batch
+        if (waited) {
+            stats.failures++; // the flush failed and the overlay is still full
+            return false;
+        }
+        if (!dirtyHook) {
+            // No flusher task: this caller is the only writer anyway
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> writer(writeMutex);
+                flushWriter();
+            }
+            lock.lock();
+            continue;
+        }
+        // Flash is never written from the committing task: ask the flusher to take the
+        // overlay over now and wait for it (or for the flush to fail)
+        const uint32_t failuresBefore = stats.failures;
+        dirtyHook(dirtyCtx, true);
+        overlayTaken.wait(lock, [&] { return overlay.empty() || stats.failures != failuresBefore; });
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        const int d = overlay.find(recs[i].key);
+        if (matchesStored(recs[i], data[i])) {
+            // Set back to the stored value before the flush: nothing left to write
+            if (d >= 0) overlay.removeAt(static_cast<uint8_t>(d));
+            continue;
+        }
+        overlay.add(recs[i].key, data[i], recs[i].len, recs[i].flags);
+    }
+    stats.deferred++;
+    if (dirtyHook) dirtyHook(dirtyCtx, false);
+    return true;
+}
+
+bool Store::flush() {
+    std::lock_guard<std::mutex> writer(writeMutex);
+    return flushWriter();
+}
+
+bool Store::flushWriter() {
+    // The first round retries a group an earlier flush failed to write, if any; the
+    // second picks up commits that arrived while the first one was being written
+    for (uint8_t round = 0; round < 2; ++round) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (flushing.empty()) {
+                if (overlay.empty()) return true;
+                if (!mounted) {
+                    stats.failures++;
+                    overlayTaken.notify_all();
+                    return false;
+                }
+                // Take the overlay over, so commits made during the write start a new one
+                flushing = overlay;
+                overlay.clear();
+                overlayTaken.notify_all();
+            }
+        }
+        const uint32_t all = (1u << flushing.size()) - 1;
+        if (!writeBatch(flushing.recs, flushing.data, flushing.size(), all)) {
+            // `flushing` stays: reads keep the newer values and the next flush retries it
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.failures++;
+            overlayTaken.notify_all();
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        flushing.clear();
+    }
+    return true;
+}
+
+bool Store::hasDirty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !overlay.empty() || !flushing.empty();
+}
+
+void Store::setWriteBack(bool enable, DirtyHook onDirty, void* ctx) {
+    std::lock_guard<std::mutex> writer(writeMutex);
+    for (;;) {
+        // On a flash error stay in write-back, so the overlay never shadows a later commit
+        if (!enable && !flushWriter()) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!enable && (!overlay.empty() || !flushing.empty())) continue; // a commit landed meanwhile
+        writeBack = enable;
+        dirtyHook = enable ? onDirty : nullptr;
+        dirtyCtx = enable ? ctx : nullptr;
+        return;
+    }
+}
+
+bool Store::writeBatch(const Record* recs, const Values* data, uint8_t count, uint32_t keep) {
+    // Finish a compaction an earlier flash error interrupted before adding anything new
+    const uint8_t spare = static_cast<uint8_t>((head + 1) % region.sectorCount);
+    if (seqOf[spare] != 0 && !compact(spare)) return false;
+    uint32_t need = 0;
+    uint8_t left = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (!(keep & (1u << i))) continue;
+        need += recordBytes(recs[i].len);
+        ++left;
+    }
+    // A commit never straddles sectors, so its records replay together or not at all
+    for (uint8_t tries = 0; writeOff + need > headEnd(); ++tries) {
+        if (tries == region.sectorCount || !advance()) return false;
+    }
+    uint32_t at[MAX_BATCH];
+    for (uint8_t i = 0; i < count; ++i) {
+        if (!(keep & (1u << i))) continue;
+        if (!append(recs[i].key, data[i], recs[i].len, recs[i].flags, --left, at[i])) return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint8_t i = 0; i < count; ++i) {
+        if (!(keep & (1u << i))) continue;
+        const bool gone = (recs[i].flags & FLAG_TOMBSTONE) != 0;
+        index[recs[i].key] = gone ? NO_RECORD : at[i];
+        lengths[recs[i].key] = gone ? 0 : recs[i].len;
+    }
+    stats.commits++;
+    return true;
+}
+
+bool Store::format() {
+    std::lock_guard<std::mutex> writer(writeMutex);
+    if (!region.erase) return false;
+    const bool ok = formatWriter();
+    std::lock_guard<std::mutex> lock(mutex);
+    mounted = ok;
+    return ok;
+}
+
+bool Store::formatWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        overlay.clear();
+        flushing.clear();
+        for (uint8_t key = 0; key < MAX_KEYS; ++key) {
+            index[key] = NO_RECORD;
+            lengths[key] = 0;
+        }
+        overlayTaken.notify_all(); // a commit waiting for room finds it
+    }
+    for (uint8_t sector = 0; sector < region.sectorCount; ++sector) {
+        if (seqOf[sector] != 0 && !eraseSector(sector)) return false;
+    }
+    // Continue from the first sector past the old head so erases keep rotating
+    nextSeq = 1;
+    return openSector(static_cast<uint8_t>((head + 1) % region.sectorCount));
+}
+
+size_t Store::readRaw(uint32_t offset, void* out, size_t len) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t total = region.sectorSize * region.sectorCount;
+    if (!mounted || offset >= total) return 0;
+    if (len > total - offset) len = total - offset;
+    return region.read(region.ctx, offset, out, len) ? len : 0;
+}
+
+Stats Store::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats out = stats;
+    uint32_t live = 0;
+    for (uint8_t key = 0; key < MAX_KEYS; ++key) {
+        if (index[key] != NO_RECORD) live += recordBytes(lengths[key]);
+    }
+    out.liveBytes = static_cast<uint16_t>(live);
+    return out;
+}
+
+} // namespace ConfigLog
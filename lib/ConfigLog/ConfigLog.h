@@ -0,0 +1,197 @@
+// ConfigLog.h
+// Append-only key/value store for persisted settings, laid over a few flash sectors.
+// No Arduino dependency, so the log can be replayed against RamFlash on a host.
+//
+// Each sector starts with {magic, seq, ~seq}; records follow back to back, 4-byte aligned:
+//
+//   key | len | flags | follow | crc32(key..follow, value) | value (len bytes, padded)
+//
+// Updating a key appends a record and moves its RAM index slot, so a put costs one small
+// flash write instead of rewriting a whole EEPROM image. Records committed together carry
+// `follow` = number of records of the same commit still to come; replay applies a group
+// only once its last record (follow 0) checks out, so a torn commit leaves no trace.
+// When the head sector fills, the log moves on to the spare sector and the oldest sector's
+// live records are copied forward before it is erased, which spreads erases over the ring.
+// In write-back mode commits land in a RAM overlay and a background flush() writes them.
+// Callers collect multi-record commits in their own Batch.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+
+namespace ConfigLog {
+
+// Flash backend. offset is relative to the region; erase works on whole sectors and
+// writes may only clear bits, like NOR flash.
+struct FlashRegion {
+    void* ctx = nullptr;
+    uint32_t sectorSize = 0;
+    uint8_t sectorCount = 0;
+    bool (*read)(void* ctx, uint32_t offset, void* dst, size_t len) = nullptr;
+    bool (*write)(void* ctx, uint32_t offset, const void* src, size_t len) = nullptr;
+    bool (*erase)(void* ctx, uint32_t sector) = nullptr;
+};
+
+// Data partition holding the log on the devices (see partitions.csv)
+static constexpr const char* PARTITION_LABEL = "cfglog";
+// Wraps the data partition with that label; false when the partition table lacks it
+bool openPartition(FlashRegion& out, const char* label = PARTITION_LABEL);
+
+struct Stats {
+    uint32_t appends = 0;    // records written, including copies made by compaction
+    uint32_t commits = 0;
+    uint32_t erases = 0;     // sectors erased since begin()
+    uint32_t failures = 0;   // commits rejected or lost to a flash error
+    uint32_t deferred = 0;   // commits absorbed by the write-back overlay
+    uint16_t liveBytes = 0;  // flash bytes held by current values
+};
+
+// Records that Store::commit() writes as one atomic group. Each caller fills its own batch
+// (usually a local), so settings staged on different tasks never land in each other's group.
+// Staging a key twice keeps the last value.
+class Batch {
+public:
+    static constexpr uint8_t CAPACITY = 24;
+    static constexpr uint8_t MAX_VALUE_BYTES = 48;
+
+    // False when the value is too long or the batch is full
+    bool stage(uint8_t key, const void* data, size_t len);
+    bool stageErase(uint8_t key);
+    template <typename T>
+    bool stage(uint8_t key, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value, "Pass the value, not a pointer to it");
+        return stage(key, &value, sizeof(T));
+    }
+    bool empty() const { return count == 0; }
+    uint8_t size() const { return count; }
+    void clear() { count = 0; }
+
+private:
+    friend class Store;
+    struct Record {
+        uint8_t key;
+        uint8_t len;
+        uint8_t flags;
+    };
+    Record recs[CAPACITY];
+    uint8_t data[CAPACITY][MAX_VALUE_BYTES];
+    uint8_t count = 0;
+
+    bool add(uint8_t key, const void* value, size_t len, uint8_t flags);
+    int find(uint8_t key) const;
+    void removeAt(uint8_t slot);
+};
+
+class Store {
+public:
+    static constexpr uint8_t MAX_KEYS = 160;
+    static constexpr uint8_t MAX_VALUE_BYTES = Batch::MAX_VALUE_BYTES;
+    static constexpr uint8_t MAX_BATCH = Batch::CAPACITY; // records in one atomic commit
+    static constexpr uint8_t MIN_SECTORS = 3;    // head, spare, and one to compact from
+    static constexpr uint8_t MAX_SECTORS = 16;
+
+    // Mounts the region, formatting it when it holds no log. Finishes an interrupted
+    // compaction and erases half-erased sectors left by a power cut.
+    bool begin(const FlashRegion& region);
+    bool ready() const;
+    bool empty() const;
+
+    // O(1) lookups through the RAM index
+    bool contains(uint8_t key) const;
+    size_t size(uint8_t key) const; // 0 when absent
+    // Copies up to cap bytes of the value; returns the stored length (0 when absent)
+    size_t read(uint8_t key, void* out, size_t cap) const;
+    // Fills out only when the stored value has exactly sizeof(T) bytes
+    template <typename T>
+    bool get(uint8_t key, T& out) const {
+        static_assert(std::is_trivially_copyable<T>::value, "Value must be trivially copyable");
+        return size(key) == sizeof(T) && read(key, &out, sizeof(T)) == sizeof(T);
+    }
+
+    // commit() writes the batch as one atomic group and empties it; records that repeat the
+    // current value (or erase an absent key) write nothing. put/erase commit a single record.
+    bool commit(Batch& batch);
+    bool put(uint8_t key, const void* data, size_t len);
+    bool erase(uint8_t key);
+    template <typename T>
+    bool put(uint8_t key, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value, "Pass the value, not a pointer to it");
+        return put(key, &value, sizeof(T));
+    }
+
+    // Write-back: while enabled, commit() only merges the batch into a RAM overlay that
+    // reads see at once, then calls onDirty (from the committing task). flush() writes the
+    // whole overlay as one atomic group, so batches touching the same key coalesce into one
+    // record and a key set back to its stored value writes nothing. Flash is written without
+    // the state lock held, so commits and reads carry on while a flush runs. A commit that
+    // does not fit the overlay calls onDirty with full = true and waits for the flush to take
+    // the overlay over; without a hook it flushes itself. Disabling flushes.
+    using DirtyHook = void (*)(void* ctx, bool full);
+    void setWriteBack(bool enable, DirtyHook onDirty = nullptr, void* ctx = nullptr);
+    bool flush();
+    bool hasDirty() const;
+
+    // Drops every key, including unflushed ones (factory reset)
+    bool format();
+
+    // Raw region bytes for diagnostics
+    uint32_t regionSize() const { return region.sectorSize * region.sectorCount; }
+    size_t readRaw(uint32_t offset, void* out, size_t len) const;
+    Stats getStats() const;
+
+private:
+    static constexpr uint32_t NO_RECORD = 0xFFFFFFFF;
+    using Record = Batch::Record;
+    using Values = uint8_t[MAX_VALUE_BYTES];
+
+    FlashRegion region;
+    // `mutex` guards the index, the overlays, stats and flags and is never held across flash
+    // writes or erases. `writeMutex` serialises the flash writers (commit without write-back,
+    // flush, format) and guards the log position; take it before `mutex`. Only writers change
+    // the index, so a writer may read it without `mutex`, and it erases a sector only after
+    // publishing the new location of every key the sector held.
+    mutable std::mutex mutex;
+    std::mutex writeMutex;
+    std::condition_variable overlayTaken;
+    bool mounted = false;
+    uint32_t index[MAX_KEYS] = {};  // region offset of each key's newest record
+    uint8_t lengths[MAX_KEYS] = {};
+    uint32_t seqOf[MAX_SECTORS] = {}; // per sector; 0 = erased
+    uint8_t head = 0;
+    uint32_t writeOff = 0;         // region offset of the next record
+    uint32_t nextSeq = 1;
+    bool writeBack = false;
+    DirtyHook dirtyHook = nullptr;
+    void* dirtyCtx = nullptr;
+    Batch overlay;                 // write-back commits, newer than `flushing`
+    Batch flushing;                // taken from the overlay by flush(), newer than the index
+    Stats stats;
+
+    bool commitRecords(const Record* recs, const Values* data, uint8_t count);
+    // Under `mutex`
+    const Batch* pending(uint8_t key, int& slot) const;
+    bool matchesStored(const Record& rec, const uint8_t* data) const; // flushing, else flash
+    bool deferLocked(const Record* recs, const Values* data, uint8_t count, std::unique_lock<std::mutex>& lock);
+    void countFailure();
+    // Writer side: `writeMutex` held, `mutex` free
+    bool commitThrough(const Record* recs, const Values* data, uint8_t count);
+    bool flushWriter();
+    bool writeBatch(const Record* recs, const Values* data, uint8_t count, uint32_t keep);
+    bool matchesFlash(const Record& rec, const uint8_t* data) const;
+    bool formatWriter();
+    bool scan(uint8_t& used);
+    void replaySector(uint8_t sector);
+    bool sectorErased(uint8_t sector) const;
+    bool eraseSector(uint8_t sector);
+    bool openSector(uint8_t sector);
+    bool advance();
+    bool compact(uint8_t sector);
+    uint32_t headEnd() const { return (static_cast<uint32_t>(head) + 1) * region.sectorSize; }
+    bool append(uint8_t key, const void* data, uint8_t len, uint8_t flags, uint8_t follow, uint32_t& at);
+    uint8_t sectorOf(uint32_t offset) const { return static_cast<uint8_t>(offset / region.sectorSize); }
+};
+
+} // namespace ConfigLog
@@ -0,0 +1,110 @@
+// ConfigLogFlusher.cpp
+// Writes a Store's write-back overlay from a low-priority FreeRTOS task (ESP builds only).
+#include "ConfigLogFlusher.h"
+
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+namespace ConfigLog {
+
+namespace {
+
+constexpr uint32_t TASK_STACK_BYTES = 3072;
+constexpr UBaseType_t TASK_PRIORITY = tskIDLE_PRIORITY + 1; // below loop() and the WiFi task
+constexpr uint32_t NOTIFY_DIRTY = 1u << 0;
+constexpr uint32_t NOTIFY_FULL = 1u << 1; // a commit is waiting for room in the overlay
+Store* shutdownStore = nullptr;
+
+uint32_t nowMs() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+} // namespace
+
+bool Flusher::begin(Store& store, uint32_t quietMs, uint32_t maxDelayMs) {
+    store_ = &store;
+    quietMs_ = quietMs;
+    maxDelayMs_ = maxDelayMs;
+    if (!store.ready() || shutdownStore) return false;
+    TaskHandle_t task = nullptr;
+    if (xTaskCreate(&Flusher::taskEntry, "cfgflush", TASK_STACK_BYTES, this, TASK_PRIORITY, &task) != pdPASS) {
+        return false;
+    }
+    task_ = task;
+    shutdownStore = &store;
+    esp_register_shutdown_handler(&Flusher::onShutdown);
+    store.setWriteBack(true, &Flusher::onDirty, this);
+    return true;
+}
+
+void Flusher::taskEntry(void* arg) {
+    static_cast<Flusher*>(arg)->run();
+}
+
+void Flusher::onDirty(void* ctx, bool full) {
+    xTaskNotify(static_cast<TaskHandle_t>(static_cast<Flusher*>(ctx)->task_), full ? NOTIFY_FULL : NOTIFY_DIRTY, eSetBits);
+}
+
+void Flusher::onShutdown() {
+    shutdownStore->flush();
+}
+
+void Flusher::run() {
+    bool dirty = false;
+    bool full = false;
+    uint32_t firstChangeMs = 0;
+    uint32_t lastChangeMs = 0;
+    for (;;) {
+        TickType_t wait = portMAX_DELAY;
+        if (full) {
+            // The committing task is blocked until the overlay is taken over: no quiet window.
+            // On a flash error it gives up, and the next window retries.
+            full = false;
+            if (store_->flush()) dirty = false;
+            continue;
+        }
+        if (dirty) {
+            const uint32_t now = nowMs();
+            const uint32_t quietAt = lastChangeMs + quietMs_;
+            const uint32_t deadline = firstChangeMs + maxDelayMs_;
+            const uint32_t dueAt = static_cast<int32_t>(quietAt - deadline) < 0 ? quietAt : deadline;
+            const int32_t left = static_cast<int32_t>(dueAt - now);
+            if (left <= 0) {
+                if (store_->flush()) {
+                    dirty = false;
+                } else {
+                    // Flash error (counted in Stats::failures): keep the overlay, retry after another window
+                    firstChangeMs = lastChangeMs = now;
+                }
+                continue;
+            }
+            wait = pdMS_TO_TICKS(left);
+        }
+        // A commit that lands while flush() runs leaves a notification, so it is not lost
+        uint32_t bits = 0;
+        if (xTaskNotifyWait(0, UINT32_MAX, &bits, wait) == pdTRUE) {
+            const uint32_t now = nowMs();
+            if (!dirty) firstChangeMs = now;
+            dirty = true;
+            lastChangeMs = now;
+            full = (bits & NOTIFY_FULL) != 0;
+        }
+    }
+}
+
+} // namespace ConfigLog
+
+#else
+
+namespace ConfigLog {
+
+bool Flusher::begin(Store&, uint32_t, uint32_t) {
+    return false; // no task on host builds; call Store::flush() directly
+}
+
+} // namespace ConfigLog
+
+#endif
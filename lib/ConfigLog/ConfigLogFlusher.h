@@ -0,0 +1,30 @@
+// ConfigLogFlusher.h
+// Writes a Store's write-back overlay from a low-priority FreeRTOS task (ESP builds only).
+#pragma once
+#include "ConfigLog.h"
+
+namespace ConfigLog {
+
+// Settings get saved from the ESP-NOW receive path; a flash write or sector erase there
+// holds up the WiFi task and the ACK the peer waits for. Once started, commits only update
+// RAM and the task writes them after quietMs without a new change, or at the latest maxDelayMs
+// after the first unflushed one, which bounds what a power cut can lose. A commit that finds the
+// overlay full gets it flushed at once. The Store lock is not held during the flash write, so
+// the receive path never waits on it. esp_restart() flushes through a shutdown handler. One
+// flusher per firmware.
+class Flusher {
+public:
+    // False (commits stay synchronous) when the store is not mounted or the task won't start
+    bool begin(Store& store, uint32_t quietMs, uint32_t maxDelayMs);
+private:
+    static void taskEntry(void* arg);
+    static void onDirty(void* ctx, bool full);
+    static void onShutdown();
+    void run();
+    Store* store_ = nullptr;
+    void* task_ = nullptr; // TaskHandle_t
+    uint32_t quietMs_ = 0;
+    uint32_t maxDelayMs_ = 0;
+};
+
+} // namespace ConfigLog
@@ -0,0 +1,58 @@
+// ConfigLogPartition.cpp
+// FlashRegion over an ESP-IDF data partition. Host builds use RamFlash instead.
+#include "ConfigLog.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_partition.h>
+
+namespace ConfigLog {
+
+namespace {
+
+constexpr uint32_t FLASH_SECTOR_BYTES = 4096;
+
+const esp_partition_t* partitionOf(void* ctx) {
+    return static_cast<const esp_partition_t*>(ctx);
+}
+
+bool partitionRead(void* ctx, uint32_t offset, void* dst, size_t len) {
+    return esp_partition_read(partitionOf(ctx), offset, dst, len) == ESP_OK;
+}
+
+bool partitionWrite(void* ctx, uint32_t offset, const void* src, size_t len) {
+    return esp_partition_write(partitionOf(ctx), offset, src, len) == ESP_OK;
+}
+
+bool partitionErase(void* ctx, uint32_t sector) {
+    return esp_partition_erase_range(partitionOf(ctx), sector * FLASH_SECTOR_BYTES, FLASH_SECTOR_BYTES) == ESP_OK;
+}
+
+} // namespace
+
+bool openPartition(FlashRegion& out, const char* label) {
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) return false;
+    const uint32_t sectors = part->size / FLASH_SECTOR_BYTES;
+    if (sectors < Store::MIN_SECTORS || sectors > Store::MAX_SECTORS) return false;
+    out.ctx = const_cast<esp_partition_t*>(part);
+    out.sectorSize = FLASH_SECTOR_BYTES;
+    out.sectorCount = static_cast<uint8_t>(sectors);
+    out.read = &partitionRead;
+    out.write = &partitionWrite;
+    out.erase = &partitionErase;
+    return true;
+}
+
+} // namespace ConfigLog
+
+#else
+
+namespace ConfigLog {
+
+bool openPartition(FlashRegion&, const char*) {
+    return false;
+}
+
+} // namespace ConfigLog
+
+#endif
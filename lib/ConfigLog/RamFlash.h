@@ -0,0 +1,78 @@
+// RamFlash.h
+// Host-side flash simulation for ConfigLog: erase sets bytes to 0xFF, writes can only
+// clear bits, and a write budget cuts the power part way through a record.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "ConfigLog.h"
+
+namespace ConfigLog {
+
+class RamFlash {
+public:
+    RamFlash(uint32_t sectorSize, uint8_t sectorCount)
+        : sectorSize_(sectorSize), sectorCount_(sectorCount),
+          bytes_(static_cast<size_t>(sectorSize) * sectorCount, 0xFF), erases_(sectorCount, 0) {}
+
+    FlashRegion region() {
+        FlashRegion r;
+        r.ctx = this;
+        r.sectorSize = sectorSize_;
+        r.sectorCount = sectorCount_;
+        r.read = &RamFlash::readFn;
+        r.write = &RamFlash::writeFn;
+        r.erase = &RamFlash::eraseFn;
+        return r;
+    }
+
+    // After budget more bytes, writes stop landing and fail (SIZE_MAX = never)
+    void cutPowerAfter(size_t budget) { budget_ = budget; }
+    void restorePower() { budget_ = SIZE_MAX; }
+    uint32_t eraseCount(uint8_t sector) const { return sector < sectorCount_ ? erases_[sector] : 0; }
+    std::vector<uint8_t>& bytes() { return bytes_; }
+
+private:
+    uint32_t sectorSize_;
+    uint8_t sectorCount_;
+    std::vector<uint8_t> bytes_;
+    std::vector<uint32_t> erases_;
+    size_t budget_ = SIZE_MAX;
+
+    bool inRange(uint32_t offset, size_t len) const {
+        return offset <= bytes_.size() && len <= bytes_.size() - offset;
+    }
+
+    static bool readFn(void* ctx, uint32_t offset, void* dst, size_t len) {
+        RamFlash* self = static_cast<RamFlash*>(ctx);
+        if (!self->inRange(offset, len)) return false;
+        const uint8_t* src = self->bytes_.data() + offset;
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        for (size_t i = 0; i < len; ++i) out[i] = src[i];
+        return true;
+    }
+
+    static bool writeFn(void* ctx, uint32_t offset, const void* src, size_t len) {
+        RamFlash* self = static_cast<RamFlash*>(ctx);
+        if (!self->inRange(offset, len)) return false;
+        const uint8_t* in = static_cast<const uint8_t*>(src);
+        for (size_t i = 0; i < len; ++i) {
+            if (self->budget_ == 0) return false;
+            if (self->budget_ != SIZE_MAX) --self->budget_;
+            self->bytes_[offset + i] &= in[i];
+        }
+        return true;
+    }
+
+    static bool eraseFn(void* ctx, uint32_t sector) {
+        RamFlash* self = static_cast<RamFlash*>(ctx);
+        if (sector >= self->sectorCount_ || self->budget_ == 0) return false;
+        const size_t base = static_cast<size_t>(sector) * self->sectorSize_;
+        for (size_t i = 0; i < self->sectorSize_; ++i) self->bytes_[base + i] = 0xFF;
+        self->erases_[sector]++;
+        return true;
+    }
+};
+
+} // namespace ConfigLog
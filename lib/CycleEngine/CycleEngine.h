@@ -0,0 +1,135 @@
+// CycleEngine.h
+// Header-only ON/OFF cycle engine shared by the standalone timer (src/core) and
+// FogMachineTimer. No Arduino dependency, so it builds and benchmarks on a host.
+//
+// Tick is an unsigned integer type (e.g. uint32_t millis(), uint64_t esp_timer us);
+// wrap-around is handled by only ever comparing differences. Output is a policy with
+// `void write(bool on)`, called whenever the effective output level changes.
+#pragma once
+
+#include <stdint.h>
+#include <limits>
+#include <type_traits>
+
+namespace CycleEngine {
+
+// For callers that drive the pin themselves from isOn()
+struct NullOutput {
+    void write(bool) {}
+};
+
+template <typename Tick, typename Output = NullOutput>
+class Engine {
+    static_assert(std::is_unsigned<Tick>::value, "Tick must be an unsigned integer type");
+public:
+    Engine() = default;
+    explicit Engine(const Output& out) : out_(out) {}
+
+    Output& output() { return out_; }
+
+    // Start an OFF phase at `now`
+    void begin(Tick now, Tick onTicks, Tick offTicks) {
+        on_ = onTicks;
+        off_ = offTicks;
+        primed_ = false;
+        restart(now, false);
+    }
+
+    // New durations apply to the current phase; its start is kept, so the next
+    // advance() either extends it or catches up in closed form.
+    void setDurations(Tick onTicks, Tick offTicks) {
+        on_ = onTicks;
+        off_ = offTicks;
+    }
+
+    // Begin a fresh phase in the given state at `now`; clears any override
+    void restart(Tick now, bool on) {
+        override_ = false;
+        cycleOn_ = on;
+        anchor_ = now;
+        apply();
+    }
+    void reset(Tick now) { restart(now, false); }
+    void toggle(Tick now) { restart(now, !isOn()); }
+
+    // Force the output ON while set; the cycle keeps its schedule underneath, so
+    // releasing returns to whatever state the timeline says.
+    void setOverride(bool forceOn) {
+        override_ = forceOn;
+        apply();
+    }
+
+    // Record an edge that was switched elsewhere (e.g. from a hardware alarm)
+    // at its scheduled tick, so later edges stay on the same grid.
+    bool markEdge(Tick at, bool on) {
+        anchor_ = at;
+        cycleOn_ = on;
+        return apply();
+    }
+
+    // Bring the cycle up to `now` in O(1): whole periods are skipped and at most one
+    // transition is applied, however long the caller stalled. Returns true if the
+    // effective output changed.
+    bool advance(Tick now) {
+        const Tick since = static_cast<Tick>(now - anchor_);
+        if (since > HALF_RANGE) return false; // `now` is before the current phase started
+        const Tick dur = cycleOn_ ? on_ : off_;
+        if (since < dur) return false;
+        const Tick period = static_cast<Tick>(on_ + off_);
+        if (period == 0) { // degenerate 0/0 cycle: one flip per call
+            cycleOn_ = !cycleOn_;
+            anchor_ = now;
+            return apply();
+        }
+        const Tick late = static_cast<Tick>(since - dur); // ticks since the due edge
+        const Tick rem = static_cast<Tick>(late % period);
+        Tick base = static_cast<Tick>(anchor_ + dur + (late - rem));
+        bool state = !cycleOn_;
+        const Tick stateDur = state ? on_ : off_;
+        if (rem >= stateDur) { // also past the edge back
+            base = static_cast<Tick>(base + stateDur);
+            state = !state;
+        }
+        cycleOn_ = state;
+        anchor_ = base;
+        return apply();
+    }
+
+    // Tick at which the current phase ends (only meaningful without override)
+    Tick nextEdge() const { return static_cast<Tick>(anchor_ + (cycleOn_ ? on_ : off_)); }
+    // Ticks spent in the current phase (0 if `now` is before its scheduled start)
+    Tick elapsed(Tick now) const {
+        const Tick d = static_cast<Tick>(now - anchor_);
+        return d > HALF_RANGE ? 0 : d;
+    }
+
+    bool isOn() const { return override_ || cycleOn_; }
+    bool cycleOn() const { return cycleOn_; }
+    bool overridden() const { return override_; }
+    Tick lastEdge() const { return anchor_; }
+    Tick onTicks() const { return on_; }
+    Tick offTicks() const { return off_; }
+
+private:
+    static constexpr Tick HALF_RANGE = std::numeric_limits<Tick>::max() / 2;
+
+    bool apply() {
+        const bool level = isOn();
+        if (primed_ && level == written_) return false;
+        primed_ = true;
+        written_ = level;
+        out_.write(level);
+        return true;
+    }
+
+    Output out_{};
+    Tick on_ = 0;
+    Tick off_ = 0;
+    Tick anchor_ = 0;
+    bool cycleOn_ = false;
+    bool override_ = false;
+    bool written_ = false;
+    bool primed_ = false;
+};
+
+} // namespace CycleEngine
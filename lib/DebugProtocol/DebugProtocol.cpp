@@ -51,6 +51,14 @@ const char* commandToString(Command cmd) {
         case Command::RenameDevice: return "RenameDevice";
         case Command::SetTimerValues: return "SetTimerValues";
         case Command::SetTimerOutput: return "SetTimerOutput";
+        case Command::SetGroupMembership: return "SetGroupMembership";
+        case Command::GroupCommand: return "GroupCommand";
+        case Command::ConfigureDevice: return "ConfigureDevice";
+        case Command::OutputCommand: return "OutputCommand";
+        case Command::PatternCommand: return "PatternCommand";
+        case Command::ScheduleCue: return "ScheduleCue";
+        case Command::PulseTrain: return "PulseTrain";
+        case Command::GetEdgeTiming: return "GetEdgeTiming";
         default: return "Unknown";
     }
 }
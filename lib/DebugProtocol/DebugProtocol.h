@@ -46,7 +46,15 @@ enum class Command : uint8_t {
     UnpairDevice = 17,
     RenameDevice = 18,
     SetTimerValues = 19,
-    SetTimerOutput = 20
+    SetTimerOutput = 20,
+    SetGroupMembership = 21,
+    GroupCommand = 22,
+    ConfigureDevice = 23,
+    OutputCommand = 24,
+    PatternCommand = 25,
+    ScheduleCue = 26,
+    PulseTrain = 27,
+    GetEdgeTiming = 28
 };
 
 enum class Status : uint8_t {
@@ -153,6 +161,31 @@ struct DiscoveredDevicesPayload {
     DiscoveredDeviceEntry entries[kMaxEntries] = {};
 };
 
+struct EdgeTimingEntry {
+    uint32_t scheduledMs = 0; // scheduled edge, esp_timer timeline in ms (low 32 bits)
+    uint16_t lateUs = 0;      // actual - scheduled, saturated at 65535
+    uint8_t output = 0;
+    uint8_t flags = 0;        // EdgeTimingFlags
+};
+
+namespace EdgeTimingFlags {
+    constexpr uint8_t On = 0x01;  // edge switched the output ON
+    constexpr uint8_t Cue = 0x02; // edge came from a cue rather than the cycle/program
+}
+
+// Timer relay edges: lateness of the actual switch against its schedule
+struct EdgeTimingPayload {
+    uint32_t edgeCount = 0;   // since boot or the last reset
+    uint32_t maxLateUs = 0;
+    static constexpr uint8_t kBuckets = 10;
+    // Bucket 0: < 16 us, bucket k: [8 << k, 16 << k) us, last bucket open-ended (>= 4 ms)
+    uint16_t histogram[kBuckets] = {};
+    uint8_t entryCount = 0;
+    uint8_t reserved[3] = {0};
+    static constexpr uint8_t kMaxEntries = 8;
+    EdgeTimingEntry entries[kMaxEntries] = {}; // newest first
+};
+
 bool isValid(const Packet& packet);
 void clearData(Packet& packet);
 bool setData(Packet& packet, const void* payload, size_t len);
@@ -0,0 +1,162 @@
+#include "PageBlit.h"
+
+namespace PageBlit {
+
+namespace {
+
+// Columns of the classic 5x7 font Adafruit GFX uses by default, bit 0 on top
+struct GlyphCols {
+    char c;
+    uint8_t cols[5];
+};
+constexpr GlyphCols GLYPHS[] = {
+    {' ', {0x00, 0x00, 0x00, 0x00, 0x00}},
+    {'-', {0x08, 0x08, 0x08, 0x08, 0x08}},
+    {'.', {0x00, 0x60, 0x60, 0x00, 0x00}},
+    {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}},
+    {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x72, 0x49, 0x49, 0x49, 0x46}},
+    {'3', {0x21, 0x41, 0x49, 0x4D, 0x33}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}},
+    {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x31}},
+    {'7', {0x41, 0x21, 0x11, 0x09, 0x07}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}},
+    {'9', {0x46, 0x49, 0x49, 0x29, 0x1E}},
+};
+
+// Each bit of a nibble doubled, for text size 2
+constexpr uint8_t DOUBLE_NIBBLE[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+const uint8_t* glyphCols(char c) {
+    for (const auto& g : GLYPHS) {
+        if (g.c == c) return g.cols;
+    }
+    return nullptr;
+}
+
+uint32_t rowRange(int from, int to) { // bits [from, to)
+    if (to <= from) return 0;
+    return ((1u << (to - from)) - 1u) << from;
+}
+
+} // namespace
+
+void column(const Frame& f, int x, int y, uint32_t bits, int h, Mode mode) {
+    if (x < 0 || x >= f.width || h <= 0 || h > 24) return;
+    uint32_t mask = (1u << h) - 1u;
+    bits &= mask;
+    if (y < 0) {
+        if (-y >= h) return;
+        bits >>= -y;
+        mask >>= -y;
+        y = 0;
+    }
+    const int pages = f.height / 8;
+    int page = y >> 3;
+    const int shift = y & 7;
+    mask <<= shift;
+    bits <<= shift;
+    for (; mask && page < pages; ++page, mask >>= 8, bits >>= 8) {
+        const uint8_t m = static_cast<uint8_t>(mask);
+        if (!m) continue;
+        uint8_t& dst = f.buf[page * f.width + x];
+        const uint8_t b = static_cast<uint8_t>(bits) & m;
+        dst = (mode == Mode::Opaque) ? static_cast<uint8_t>((dst & ~m) | b) : static_cast<uint8_t>(dst | b);
+    }
+}
+
+void fill(const Frame& f, int x, int y, int w, int h, bool white) {
+    // Split tall fills into 24-pixel bands to stay within one column write
+    for (int top = y; top < y + h; top += 24) {
+        const int band = (y + h - top) < 24 ? (y + h - top) : 24;
+        const uint32_t bits = white ? rowRange(0, band) : 0;
+        for (int c = 0; c < w; ++c) column(f, x + c, top, bits, band, Mode::Opaque);
+    }
+}
+
+void rowIcon(const Frame& f, int x, int y, const uint8_t* rows, int w, int h, Mode mode) {
+    if (h > 24) h = 24;
+    for (int c = 0; c < w; ++c) {
+        const int bit = w - 1 - c;
+        if (bit >= 8) { // beyond a row byte: blank column
+            if (mode == Mode::Opaque) column(f, x + c, y, 0, h, mode);
+            continue;
+        }
+        uint32_t col = 0;
+        for (int r = 0; r < h; ++r) {
+            if (rows[r] & (1u << bit)) col |= 1u << r;
+        }
+        column(f, x + c, y, col, h, mode);
+    }
+}
+
+bool glyph(const Frame& f, int x, int y, char c, uint8_t scale, bool invert) {
+    const uint8_t* cols = glyphCols(c);
+    if (!cols || scale < 1 || scale > 2) return false;
+    const int h = 8 * scale;
+    for (int i = 0; i < 6; ++i) {
+        const uint8_t line = (i < 5) ? cols[i] : 0; // sixth column is the gap
+        uint32_t bits = line;
+        if (scale == 2) bits = DOUBLE_NIBBLE[line & 0x0F] | (static_cast<uint32_t>(DOUBLE_NIBBLE[line >> 4]) << 8);
+        if (invert) bits = ~bits;
+        for (int s = 0; s < scale; ++s) column(f, x + i * scale + s, y, bits, h, Mode::Opaque);
+    }
+    return true;
+}
+
+void segmentDigit(const Frame& f, int x, int y, uint8_t digit, int w, int h, int thick, bool invert) {
+    // Segment bits a..g = 0..6, as on a common 7-segment decoder
+    static constexpr uint8_t SEGMENTS[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+    if (h > 24) h = 24;
+    const uint8_t seg = digit < 10 ? SEGMENTS[digit] : 0;
+    const int mid = (h - thick) / 2;
+    const uint32_t top = (seg & 0x01) ? rowRange(0, thick) : 0;                 // a
+    const uint32_t middle = (seg & 0x40) ? rowRange(mid, mid + thick) : 0;      // g
+    const uint32_t bottom = (seg & 0x08) ? rowRange(h - thick, h) : 0;          // d
+    const uint32_t upper = rowRange(1, mid + 1);                                // b, f span
+    const uint32_t lower = rowRange(mid + thick - 1, h - 1);                    // c, e span
+    for (int c = 0; c < w; ++c) {
+        uint32_t bits = 0;
+        const bool left = c < thick;
+        const bool right = c >= w - thick;
+        if (!left && !right) bits = top | middle | bottom;
+        if (left) bits |= ((seg & 0x20) ? upper : 0) | ((seg & 0x10) ? lower : 0);    // f, e
+        if (right) bits |= ((seg & 0x02) ? upper : 0) | ((seg & 0x04) ? lower : 0);   // b, c
+        if (invert) bits = ~bits;
+        column(f, x + c, y, bits, h, Mode::Opaque);
+    }
+}
+
+bool timerDigits(const Frame& f, int x, int y, const char* digits, int count, int pointAfter, int digitW, int invertIndex) {
+    bool ok = true;
+    for (int i = 0; i < count; ++i) {
+        const bool inv = (i == invertIndex);
+        ok &= glyph(f, x, y, digits[i], 2, inv);
+        if (i == pointAfter) {
+            glyph(f, x + 12, y, '.', 2, inv); // where GFX print() leaves the cursor
+            x += digitW;
+        }
+        x += digitW;
+    }
+    return ok;
+}
+
+void timerSegments(const Frame& f, int x, int y, const char* digits, int count, int pointAfter, int digitW, int invertIndex) {
+    for (int i = 0; i < count; ++i) {
+        const bool inv = (i == invertIndex);
+        segmentDigit(f, x, y, static_cast<uint8_t>(digits[i] - '0'), digitW - 1, 16, 2, inv);
+        if (i == pointAfter) {
+            x += digitW;
+            fill(f, x, y, digitW, 16, inv);
+            fill(f, x + 4, y + 14, 2, 2, !inv);
+        }
+        x += digitW;
+    }
+}
+
+} // namespace PageBlit
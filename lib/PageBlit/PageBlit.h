@@ -0,0 +1,49 @@
+// PageBlit.h
+// Direct drawing into an SSD1306 page-major framebuffer: byte [page * width + x] holds 8
+// vertical pixels, bit 0 on top. A glyph or icon goes in one column at a time with a shift
+// and a mask per page, instead of one Adafruit GFX call per font pixel (or per 2x2 block at
+// text size 2). No Arduino dependency, so it can be checked against GFX output on a host.
+// Coordinates are panel coordinates; callers fall back to GFX when the display is rotated.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace PageBlit {
+
+struct Frame {
+    uint8_t* buf;
+    int16_t width;
+    int16_t height; // multiple of 8
+};
+
+enum class Mode : uint8_t {
+    Opaque, // unset bits clear the pixel, like text drawn with a background colour
+    Set,    // only set bits are drawn, like drawPixel per set bit
+};
+
+// One column of h <= 24 pixels at (x, y); bit 0 of bits is the top pixel. Clipped to the frame.
+void column(const Frame& f, int x, int y, uint32_t bits, int h, Mode mode);
+void fill(const Frame& f, int x, int y, int w, int h, bool white);
+
+// Row-major icon, one byte per row, column c taken from bit (w - 1 - c): the layout the
+// standalone firmware's WiFi icons use
+void rowIcon(const Frame& f, int x, int y, const uint8_t* rows, int w, int h, Mode mode);
+
+// Pixel-identical to GFX print() at text size 1 or 2 with a background colour: fills the
+// 6*scale x 8*scale cell. Covers the characters timer rows need ('0'-'9', '.', '-', ':', ' ');
+// returns false for anything else so the caller can use GFX.
+bool glyph(const Frame& f, int x, int y, char c, uint8_t scale, bool invert = false);
+
+// Seven-segment digit filling a w x h box (h <= 24) on black, segments thick pixels wide
+void segmentDigit(const Frame& f, int x, int y, uint8_t digit, int w, int h, int thick, bool invert = false);
+
+// A timer value laid out like the firmwares' timer rows: count size-2 cells digitW apart,
+// drawn left to right so each cell covers the previous one's gap column, and a '.' cell after
+// index pointAfter. The cell at invertIndex (-1 = none), and a point right after it, are
+// inverted. Same pixels as the GFX loop; false if a character has no glyph.
+bool timerDigits(const Frame& f, int x, int y, const char* digits, int count, int pointAfter, int digitW, int invertIndex = -1);
+// The same row as 16-pixel seven-segment digits with a dot in the point cell
+void timerSegments(const Frame& f, int x, int y, const char* digits, int count, int pointAfter, int digitW, int invertIndex = -1);
+
+} // namespace PageBlit
@@ -0,0 +1,259 @@
+#include "PatternProgram.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace PatternProgram {
+
+namespace {
+
+constexpr uint16_t SECONDS_FLAG = 0x8000;
+constexpr uint32_t MAX_TICKS_MS = 0x7FFF * 10UL;
+
+// Operand bytes following each opcode
+int operandBytes(uint8_t op) {
+    switch (static_cast<Op>(op)) {
+        case Op::End: return 0;
+        case Op::On: return 2;
+        case Op::Off: return 2;
+        case Op::Repeat: return 1;
+        case Op::Next: return 0;
+        case Op::Ramp: return 7;
+        case Op::Hold: return 1;
+    }
+    return -1;
+}
+
+uint16_t read16(const uint8_t* code, size_t at) {
+    return static_cast<uint16_t>(code[at] | (code[at + 1] << 8));
+}
+
+struct Emitter {
+    uint8_t* out;
+    size_t capacity;
+    size_t len;
+    bool put(uint8_t b) {
+        if (len >= capacity) return false;
+        out[len++] = b;
+        return true;
+    }
+    bool put16(uint16_t v) { return put(static_cast<uint8_t>(v & 0xFF)) && put(static_cast<uint8_t>(v >> 8)); }
+};
+
+const char* nextToken(const char* p, char* token, size_t cap) {
+    while (*p && (isspace(static_cast<unsigned char>(*p)) || *p == ',' || *p == ';')) ++p;
+    size_t n = 0;
+    while (*p && !isspace(static_cast<unsigned char>(*p)) && *p != ',' && *p != ';') {
+        if (n + 1 < cap) token[n++] = static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+        ++p;
+    }
+    token[n] = '\0';
+    return p;
+}
+
+bool parseSeconds(const char* token, uint16_t& dur) {
+    char* end = nullptr;
+    float seconds = strtof(token, &end);
+    if (!token[0] || *end != '\0' || !(seconds >= 0.0f) || seconds > 32767.0f) return false;
+    dur = encodeDuration(static_cast<uint32_t>(seconds * 1000.0f + 0.5f));
+    return true;
+}
+
+bool parseCount(const char* token, uint8_t& count) {
+    char* end = nullptr;
+    long v = strtol(token, &end, 10);
+    if (!token[0] || *end != '\0' || v < 0 || v > 255) return false;
+    count = static_cast<uint8_t>(v);
+    return true;
+}
+
+} // namespace
+
+uint16_t encodeDuration(uint32_t ms) {
+    // Keep 10 ms resolution while it fits; longer gaps round to whole seconds
+    if (ms <= MAX_TICKS_MS) return static_cast<uint16_t>((ms + 5) / 10);
+    uint32_t seconds = (ms + 500) / 1000;
+    if (seconds > 0x7FFF) seconds = 0x7FFF;
+    return static_cast<uint16_t>(SECONDS_FLAG | seconds);
+}
+
+uint32_t decodeDuration(uint16_t dur) {
+    if (dur & SECONDS_FLAG) return static_cast<uint32_t>(dur & 0x7FFF) * 1000UL;
+    return static_cast<uint32_t>(dur) * 10UL;
+}
+
+bool validate(const uint8_t* code, size_t len) {
+    if (!code || len == 0 || len > MAX_BYTES) return false;
+    bool spendsTime[MAX_DEPTH + 1] = {};
+    uint8_t depth = 0;
+    size_t pc = 0;
+    while (pc < len) {
+        const uint8_t op = code[pc];
+        const int operands = operandBytes(op);
+        if (operands < 0 || pc + 1 + operands > len) return false;
+        switch (static_cast<Op>(op)) {
+            case Op::On:
+            case Op::Off:
+                if (decodeDuration(read16(code, pc + 1)) > 0) spendsTime[depth] = true;
+                break;
+            case Op::Ramp:
+                if (code[pc + 7] == 0) break; // no pulses: a no-op
+                if (decodeDuration(read16(code, pc + 1)) == 0 && decodeDuration(read16(code, pc + 3)) == 0 &&
+                    decodeDuration(read16(code, pc + 5)) == 0) {
+                    return false; // 2 * count zero-length steps
+                }
+                spendsTime[depth] = true;
+                break;
+            case Op::Hold:
+                spendsTime[depth] = true;
+                break;
+            case Op::Repeat:
+                if (depth >= MAX_DEPTH) return false;
+                ++depth;
+                spendsTime[depth] = false;
+                break;
+            case Op::Next:
+                if (depth == 0) return false;
+                if (!spendsTime[depth]) return false;
+                spendsTime[depth - 1] = spendsTime[depth - 1] || spendsTime[depth];
+                --depth;
+                break;
+            case Op::End:
+                break;
+        }
+        pc += 1 + operands;
+    }
+    return depth == 0;
+}
+
+bool compile(const char* source, uint8_t* out, size_t capacity, size_t* outLen) {
+    if (!source || !out) return false;
+    Emitter e{out, capacity < MAX_BYTES ? capacity : MAX_BYTES, 0};
+    char token[16];
+    const char* p = source;
+    for (;;) {
+        p = nextToken(p, token, sizeof(token));
+        if (!token[0]) break;
+        bool ok = false;
+        if (!strcmp(token, "on") || !strcmp(token, "off")) {
+            const bool on = token[1] == 'n';
+            uint16_t dur = 0;
+            p = nextToken(p, token, sizeof(token));
+            ok = parseSeconds(token, dur) && e.put(static_cast<uint8_t>(on ? Op::On : Op::Off)) && e.put16(dur);
+        } else if (!strcmp(token, "repeat")) {
+            uint8_t count = 0;
+            p = nextToken(p, token, sizeof(token));
+            ok = parseCount(token, count) && e.put(static_cast<uint8_t>(Op::Repeat)) && e.put(count);
+        } else if (!strcmp(token, "next")) {
+            ok = e.put(static_cast<uint8_t>(Op::Next));
+        } else if (!strcmp(token, "ramp")) {
+            uint16_t durs[3] = {};
+            uint8_t count = 0;
+            ok = e.put(static_cast<uint8_t>(Op::Ramp));
+            for (int i = 0; ok && i < 3; ++i) {
+                p = nextToken(p, token, sizeof(token));
+                ok = parseSeconds(token, durs[i]) && e.put16(durs[i]);
+            }
+            if (ok) {
+                p = nextToken(p, token, sizeof(token));
+                ok = parseCount(token, count) && e.put(count);
+            }
+        } else if (!strcmp(token, "hold")) {
+            p = nextToken(p, token, sizeof(token));
+            const bool on = !strcmp(token, "on");
+            ok = (on || !strcmp(token, "off")) && e.put(static_cast<uint8_t>(Op::Hold)) && e.put(on ? 1 : 0);
+        } else if (!strcmp(token, "end")) {
+            ok = e.put(static_cast<uint8_t>(Op::End));
+        }
+        if (!ok) return false;
+    }
+    if (!validate(out, e.len)) return false;
+    if (outLen) *outLen = e.len;
+    return true;
+}
+
+bool Runner::load(const uint8_t* code, size_t len) {
+    if (!validate(code, len)) return false;
+    memcpy(code_, code, len);
+    len_ = static_cast<uint8_t>(len);
+    restart();
+    return true;
+}
+
+void Runner::clear() {
+    len_ = 0;
+    restart();
+}
+
+void Runner::restart() {
+    pc_ = 0;
+    depth_ = 0;
+    rampStep_ = 0;
+}
+
+Segment Runner::next() {
+    Segment seg;
+    for (uint8_t steps = 0; steps < MAX_STEPS; ++steps) {
+        if (pc_ >= len_) return seg; // falling off the end == END
+        const Op op = static_cast<Op>(code_[pc_]);
+        switch (op) {
+            case Op::End:
+                return seg;
+            case Op::On:
+            case Op::Off:
+                seg.on = op == Op::On;
+                seg.ms = decodeDuration(read16(pc_ + 1));
+                pc_ += 3;
+                if (seg.ms == 0) continue;
+                seg.kind = Segment::Timed;
+                return seg;
+            case Op::Repeat:
+                stack_[depth_].bodyPc = static_cast<uint8_t>(pc_ + 2);
+                stack_[depth_].remaining = code_[pc_ + 1];
+                ++depth_;
+                pc_ += 2;
+                continue;
+            case Op::Next: {
+                Frame& frame = stack_[depth_ - 1];
+                if (frame.remaining == 0 || --frame.remaining > 0) {
+                    pc_ = frame.bodyPc;
+                } else {
+                    --depth_;
+                    ++pc_;
+                }
+                continue;
+            }
+            case Op::Ramp: {
+                const uint8_t count = code_[pc_ + 7];
+                if (rampStep_ >= 2 * count) {
+                    rampStep_ = 0;
+                    pc_ += 8;
+                    continue;
+                }
+                const uint8_t pulse = static_cast<uint8_t>(rampStep_ / 2);
+                seg.on = (rampStep_ & 1) == 0;
+                if (seg.on) {
+                    seg.ms = decodeDuration(read16(pc_ + 1));
+                } else {
+                    const int32_t from = static_cast<int32_t>(decodeDuration(read16(pc_ + 3)));
+                    const int32_t to = static_cast<int32_t>(decodeDuration(read16(pc_ + 5)));
+                    seg.ms = static_cast<uint32_t>(count > 1 ? from + (to - from) * pulse / (count - 1) : from);
+                }
+                ++rampStep_;
+                if (seg.ms == 0) continue;
+                seg.kind = Segment::Timed;
+                return seg;
+            }
+            case Op::Hold:
+                seg.kind = Segment::Hold;
+                seg.on = code_[pc_ + 1] != 0;
+                pc_ += 2;
+                return seg;
+        }
+        return seg; // unknown opcode (not reachable for validated code)
+    }
+    return Segment(); // stuck: stop rather than spin
+}
+
+} // namespace PatternProgram
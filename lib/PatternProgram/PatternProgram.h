@@ -0,0 +1,79 @@
+// PatternProgram.h
+// Compact fog program bytecode shared by the remote/PC (compiler) and the timer
+// (interpreter). No Arduino dependency, so programs can be compiled and replayed on a host.
+//
+// A program is at most MAX_BYTES bytes and fits one radio frame and one EEPROM slot.
+// Durations are 16-bit: bit 15 clear = 10 ms units (up to 327.67 s), set = whole seconds.
+//
+//   END                          program done, output OFF
+//   ON  dur | OFF dur            hold the level for dur
+//   REPEAT n ... NEXT            run the body n times (n = 0: forever), nested up to MAX_DEPTH
+//   RAMP on from to count        count pulses of `on`, OFF gaps sliding linearly from..to
+//   HOLD level                   hold the level until the program is triggered
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace PatternProgram {
+
+static constexpr size_t MAX_BYTES = 31;
+static constexpr uint8_t MAX_DEPTH = 4;
+// Instructions a single next() may execute before the program is treated as stuck
+static constexpr uint8_t MAX_STEPS = 64;
+
+enum class Op : uint8_t {
+    End = 0x00,
+    On = 0x01,
+    Off = 0x02,
+    Repeat = 0x03,
+    Next = 0x04,
+    Ramp = 0x05,
+    Hold = 0x06
+};
+
+uint16_t encodeDuration(uint32_t ms);
+uint32_t decodeDuration(uint16_t dur);
+
+// Structural check: known opcodes, complete operands, balanced REPEAT/NEXT within
+// MAX_DEPTH, and every loop body and RAMP spends time. A finite loop of zero-length steps
+// would otherwise run into MAX_STEPS and end the program early on the timer.
+bool validate(const uint8_t* code, size_t len);
+
+// Text form, e.g. "repeat 3 on 0.2 off 0.3 next off 10" (seconds; "hold on|off";
+// "ramp <on> <offFrom> <offTo> <count>"). Returns false on a syntax error or overflow.
+bool compile(const char* source, uint8_t* out, size_t capacity, size_t* outLen);
+
+struct Segment {
+    enum Kind : uint8_t { Timed, Hold, Done };
+    Kind kind = Done;
+    bool on = false;
+    uint32_t ms = 0; // Timed only
+};
+
+// Walks a validated program one segment at a time; fixed storage, no allocation.
+class Runner {
+public:
+    bool load(const uint8_t* code, size_t len); // copies; false if validate() fails
+    void clear();
+    void restart();
+    bool loaded() const { return len_ != 0; }
+    const uint8_t* code() const { return code_; }
+    uint8_t length() const { return len_; }
+    // Next segment in program order; zero-length segments are skipped
+    Segment next();
+private:
+    struct Frame {
+        uint8_t bodyPc;
+        uint8_t remaining; // 0 = forever
+    };
+    uint16_t read16(uint8_t at) const { return static_cast<uint16_t>(code_[at] | (code_[at + 1] << 8)); }
+    uint8_t code_[MAX_BYTES] = {};
+    uint8_t len_ = 0;
+    uint8_t pc_ = 0;
+    Frame stack_[MAX_DEPTH] = {};
+    uint8_t depth_ = 0;
+    uint16_t rampStep_ = 0; // RAMP at pc_: pulses and gaps emitted so far (2 per pulse, up to 510)
+};
+
+} // namespace PatternProgram
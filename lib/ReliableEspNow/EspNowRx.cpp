@@ -0,0 +1,115 @@
+#include "EspNowRx.h"
+
+// ESP builds only; host tests use the headers and fake the radio
+#ifdef ESP_PLATFORM
+
+#include <cstring>
+#include <esp_idf_version.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define ESPNOW_RX_HAS_INFO 1
+#else
+#define ESPNOW_RX_HAS_INFO 0
+#endif
+
+namespace ReliableEspNow {
+
+namespace {
+
+RxCallback rxCallback = nullptr;
+
+#if ESPNOW_RX_HAS_INFO
+
+void onRecv(const esp_now_recv_info_t* info, const uint8_t* data, int len) {
+    if (!rxCallback || !info) return;
+    const int8_t rssi = info->rx_ctrl ? static_cast<int8_t>(info->rx_ctrl->rssi) : 0;
+    rxCallback(info->src_addr, data, len, rssi);
+}
+
+#else
+
+// Latest RSSI per sender. The sniffer and the receive callback both run on the Wi-Fi task,
+// so a slot is never read while half written and needs no lock.
+struct RssiSlot {
+    uint8_t mac[6];
+    int8_t rssi;
+};
+constexpr uint8_t RSSI_SLOTS = 8;
+RssiSlot rssiSlots[RSSI_SLOTS] = {};
+uint8_t nextRssiSlot = 0;
+// Set from the caller's task; slots go stale while the sniffer is off, so they are ignored
+volatile bool sniffing = false;
+
+constexpr uint8_t FC_ACTION = 0xD0;           // frame control byte: management, subtype action
+constexpr uint8_t CATEGORY_VENDOR = 127;
+constexpr uint8_t ESPRESSIF_OUI[3] = {0x18, 0xFE, 0x34};
+constexpr size_t MIN_ACTION_LEN = 28;         // 24-byte header, category, OUI
+
+void sniffer(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (type != WIFI_PKT_MGMT || !buf) return;
+    const wifi_promiscuous_pkt_t* pkt = static_cast<const wifi_promiscuous_pkt_t*>(buf);
+    const uint8_t* frame = pkt->payload;
+    // Beacons and probes make up most of the management traffic; drop them on the first byte
+    if (frame[0] != FC_ACTION || pkt->rx_ctrl.sig_len < MIN_ACTION_LEN) return;
+    if (frame[24] != CATEGORY_VENDOR || memcmp(frame + 25, ESPRESSIF_OUI, sizeof(ESPRESSIF_OUI)) != 0) return;
+    const uint8_t* src = frame + 10; // addr2
+    RssiSlot* slot = nullptr;
+    for (auto& s : rssiSlots) {
+        if (memcmp(s.mac, src, 6) == 0) { slot = &s; break; }
+    }
+    if (!slot) {
+        slot = &rssiSlots[nextRssiSlot];
+        nextRssiSlot = static_cast<uint8_t>((nextRssiSlot + 1) % RSSI_SLOTS);
+        memcpy(slot->mac, src, 6);
+    }
+    slot->rssi = static_cast<int8_t>(pkt->rx_ctrl.rssi);
+}
+
+void onRecv(const uint8_t* mac, const uint8_t* data, int len) {
+    if (!rxCallback || !mac) return;
+    int8_t rssi = 0;
+    if (sniffing) {
+        for (const auto& s : rssiSlots) {
+            if (memcmp(s.mac, mac, 6) == 0) { rssi = s.rssi; break; }
+        }
+    }
+    rxCallback(mac, data, len, rssi);
+}
+
+#endif
+
+} // namespace
+
+bool registerReceive(RxCallback cb) {
+    rxCallback = cb;
+#if !ESPNOW_RX_HAS_INFO
+    // Only management frames reach the sniffer; data and control traffic never wakes it
+    wifi_promiscuous_filter_t filter = {};
+    filter.filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT;
+    esp_wifi_set_promiscuous_filter(&filter);
+    esp_wifi_set_promiscuous_rx_cb(&sniffer);
+#endif
+    return esp_now_register_recv_cb(&onRecv) == ESP_OK;
+}
+
+void captureRssi(bool on) {
+#if !ESPNOW_RX_HAS_INFO
+    if (on == sniffing) return;
+    // Slots from an earlier capture may be far out of date; a sender's next frame refills its slot
+    if (on) memset(rssiSlots, 0, sizeof(rssiSlots));
+    sniffing = on;
+    esp_wifi_set_promiscuous(on);
+#else
+    (void)on;
+#endif
+}
+
+bool rssiFromRecvInfo() {
+    return ESPNOW_RX_HAS_INFO != 0;
+}
+
+} // namespace ReliableEspNow
+
+#endif
@@ -0,0 +1,24 @@
+// EspNowRx.h
+// ESP-NOW receive hook that hands each frame's RSSI to the handler.
+// IDF 5 cores pass esp_now_recv_info_t, whose rx_ctrl carries the RSSI, so the radio stays
+// out of promiscuous mode. Older cores only pass the sender MAC; there a sniffer filtered to
+// management frames keeps the RSSI of each sender's latest ESP-NOW action frame, and the
+// receive callback picks it up by MAC. The sniffer runs only while captureRssi(true).
+#pragma once
+
+#include <stdint.h>
+
+namespace ReliableEspNow {
+
+// rssi is 0 when it could not be measured
+using RxCallback = void (*)(const uint8_t* mac, const uint8_t* data, int len, int8_t rssi);
+
+// Installs cb as the ESP-NOW receive callback; call after esp_now_init()
+bool registerReceive(RxCallback cb);
+// Starts or stops the sniffer on older cores; while it is stopped rssi is 0. A no-op when
+// RSSI comes from the receive info, which is always measured.
+void captureRssi(bool on);
+// True when RSSI comes from the receive info instead of the sniffer
+bool rssiFromRecvInfo();
+
+} // namespace ReliableEspNow
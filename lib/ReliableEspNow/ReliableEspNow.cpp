@@ -1,5 +1,8 @@
 #include "ReliableEspNow.h"
 
+// ESP builds only; host tests use the headers and fake the radio
+#ifdef ESP_PLATFORM
+
 #include <algorithm>
 #include <esp_now.h>
 
@@ -44,6 +47,16 @@ void Link::loop() {
     }
 }
 
+uint32_t Link::msUntilNextDeadline(uint32_t now) const {
+    uint32_t wait = UINT32_MAX;
+    for (const PendingTx& tx : pending) {
+        const uint32_t elapsed = now - tx.lastSendMs;
+        const uint32_t left = elapsed >= tx.cfg.retryIntervalMs ? 0 : tx.cfg.retryIntervalMs - elapsed;
+        if (left < wait) wait = left;
+    }
+    return wait;
+}
+
 bool Link::queuePacket(const uint8_t* mac, const void* payload, size_t len, const ReliableProtocol::SendConfig& cfg) {
     if (!mac) return false;
     const size_t maxPayloadBytes = maxPayload();
@@ -262,3 +275,5 @@ void Link::resetStats() {
 }
 
 } // namespace ReliableEspNow
+
+#endif
@@ -21,6 +21,8 @@ class Link {
 public:
     void begin();
     void loop();
+    // Milliseconds until loop() has a retry or timeout to process (UINT32_MAX = nothing pending)
+    uint32_t msUntilNextDeadline(uint32_t now) const;
 
     void setReceiveHandler(ReceiveHandler handler) { receiveHandler = handler; }
     void setAckCallback(AckCallback cb) { ackCallback = cb; }
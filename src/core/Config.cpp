@@ -1,23 +1,26 @@
 #include "Config.h"
+#include "ConfigKeys.h"
 
-bool Config::begin(size_t eepromSize) {
-    if (eepromSize < 80) eepromSize = 80; // ensure enough space for extended layout
-    EEPROM.begin(eepromSize);
+bool Config::begin(ConfigLog::Store& configStore) {
+    store = &configStore;
     load();
     return true;
 }
 
 void Config::load() {
-    EEPROM.get(EEPROM_ADDR, vals.offTime);
-    EEPROM.get(EEPROM_ADDR + sizeof(uint32_t), vals.onTime);
-    EEPROM.get(EEPROM_ADDR_SAVER, vals.screensaverDelaySec);
-    int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
-    // Layout extension: [saver(2)] [wifiEnabled(1)] [ssid(32)] [pass(32)] [apAlwaysOn(1)]
-    EEPROM.get(wifiBase, vals.wifiEnabled);
+    vals = Values{};
+    uint32_t timers[2] = {vals.offTime, vals.onTime};
+    store->get(ConfigKey::Timers, timers);
+    vals.offTime = timers[0];
+    vals.onTime = timers[1];
+    store->get(ConfigKey::Saver, vals.screensaverDelaySec);
+    store->get(ConfigKey::WifiEnabled, vals.wifiEnabled);
     if (vals.wifiEnabled > 1) vals.wifiEnabled = 1;
-    EEPROM.get(wifiBase+1, vals.staSsid);
-    EEPROM.get(wifiBase+1+32, vals.staPass);
-    EEPROM.get(wifiBase+1+32+32, vals.apAlwaysOn);
+    store->get(ConfigKey::StaSsid, vals.staSsid);
+    store->get(ConfigKey::StaPass, vals.staPass);
+    vals.staSsid[sizeof(vals.staSsid)-1] = '\0';
+    vals.staPass[sizeof(vals.staPass)-1] = '\0';
+    store->get(ConfigKey::ApAlwaysOn, vals.apAlwaysOn);
     if (vals.apAlwaysOn>1) vals.apAlwaysOn=0;
     if (vals.offTime < Defaults::TIMER_MIN || vals.offTime > Defaults::TIMER_MAX) vals.offTime = 100;
     if (vals.onTime  < Defaults::TIMER_MIN || vals.onTime  > Defaults::TIMER_MAX) vals.onTime  = 100;
@@ -30,58 +33,54 @@ void Config::saveTimersIfChanged(uint32_t off, uint32_t on, bool changed) {
     if (!changed) return;
     vals.offTime = off;
     vals.onTime = on;
-    EEPROM.put(EEPROM_ADDR, vals.offTime);
-    EEPROM.put(EEPROM_ADDR + sizeof(uint32_t), vals.onTime);
-    EEPROM.commit();
+    uint32_t timers[2] = {vals.offTime, vals.onTime};
+    store->put(ConfigKey::Timers, timers);
 }
 
 void Config::saveScreensaverIfChanged(uint16_t saver) {
     if (saver == lastSavedSaverDelay) return;
     vals.screensaverDelaySec = saver;
-    EEPROM.put(EEPROM_ADDR_SAVER, vals.screensaverDelaySec);
-    EEPROM.commit();
+    store->put(ConfigKey::Saver, vals.screensaverDelaySec);
     lastSavedSaverDelay = saver;
 }
 
 void Config::saveWiFiEnabled(uint8_t en) {
     if (en>1) en=1; if (en==lastSavedWifiEnabled) return;
-    vals.wifiEnabled = en; int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
-    EEPROM.put(wifiBase, vals.wifiEnabled);
-    EEPROM.commit();
+    vals.wifiEnabled = en;
+    store->put(ConfigKey::WifiEnabled, vals.wifiEnabled);
     lastSavedWifiEnabled = en;
 }
 
 void Config::saveStaCreds(const char* ssid, const char* pass) {
-    int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
     if (ssid) { strncpy(vals.staSsid, ssid, sizeof(vals.staSsid)-1); vals.staSsid[sizeof(vals.staSsid)-1]='\0'; }
     if (pass) { strncpy(vals.staPass, pass, sizeof(vals.staPass)-1); vals.staPass[sizeof(vals.staPass)-1]='\0'; }
-    EEPROM.put(wifiBase+1, vals.staSsid);
-    EEPROM.put(wifiBase+1+32, vals.staPass);
-    EEPROM.commit();
+    // SSID and password go in one commit so a power cut never pairs a new SSID with the old password
+    ConfigLog::Batch batch;
+    batch.stage(ConfigKey::StaSsid, vals.staSsid);
+    batch.stage(ConfigKey::StaPass, vals.staPass);
+    store->commit(batch);
 }
 
 void Config::resetWiFi() {
     vals.wifiEnabled = 0; vals.staSsid[0]='\0'; vals.staPass[0]='\0';
-    int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
-    EEPROM.put(wifiBase, vals.wifiEnabled);
-    EEPROM.put(wifiBase+1, vals.staSsid);
-    EEPROM.put(wifiBase+1+32, vals.staPass);
-    EEPROM.commit();
+    ConfigLog::Batch batch;
+    batch.stage(ConfigKey::WifiEnabled, vals.wifiEnabled);
+    batch.stageErase(ConfigKey::StaSsid);
+    batch.stageErase(ConfigKey::StaPass);
+    store->commit(batch);
     lastSavedWifiEnabled = vals.wifiEnabled;
 }
 
 void Config::forgetSta() {
     // Preserve wifiEnabled flag; only clear credentials
     vals.staSsid[0]='\0'; vals.staPass[0]='\0';
-    int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
-    EEPROM.put(wifiBase+1, vals.staSsid);
-    EEPROM.put(wifiBase+1+32, vals.staPass);
-    EEPROM.commit();
+    ConfigLog::Batch batch;
+    batch.stageErase(ConfigKey::StaSsid);
+    batch.stageErase(ConfigKey::StaPass);
+    store->commit(batch);
 }
 
 void Config::saveApAlwaysOn(uint8_t v) {
     if (v>1) v=1; if (vals.apAlwaysOn==v) return; vals.apAlwaysOn=v;
-    int wifiBase = EEPROM_ADDR_SAVER + sizeof(uint16_t);
-    EEPROM.put(wifiBase+1+32+32, vals.apAlwaysOn);
-    EEPROM.commit();
+    store->put(ConfigKey::ApAlwaysOn, vals.apAlwaysOn);
 }
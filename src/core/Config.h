@@ -1,13 +1,10 @@
 #pragma once
 #include <Arduino.h>
-#include <EEPROM.h>
 #include "Defaults.h"
+#include "ConfigLog.h"
 
-// Handles persistence of runtime configurable values.
-// Stored layout:
-// [0..3]  offTime (uint32_t, tenths)
-// [4..7]  onTime  (uint32_t, tenths)
-// [8..9]  screensaverDelaySec (uint16_t)
+// Handles persistence of runtime configurable values in the ConfigLog store
+// (keys in ConfigKeys.h). Missing or out-of-range entries fall back to the defaults below.
 
 class Config {
 public:
@@ -21,10 +18,7 @@ public:
     uint8_t apAlwaysOn = 0; // 1 = keep AP running continuously when wifiEnabled
   };
 
-  static constexpr int EEPROM_ADDR = 0;
-  static constexpr int EEPROM_ADDR_SAVER = EEPROM_ADDR + sizeof(uint32_t)*2; // after off/on
-
-  bool begin(size_t eepromSize = 32);
+  bool begin(ConfigLog::Store& configStore);
   void load();
   void saveTimersIfChanged(uint32_t off, uint32_t on, bool changed);
   void saveScreensaverIfChanged(uint16_t saver);
@@ -38,6 +32,7 @@ public:
   const Values& get() const { return vals; }
 
 private:
+  ConfigLog::Store* store = nullptr;
   Values vals;
   uint16_t lastSavedSaverDelay = 0xFFFF;
   uint8_t lastSavedWifiEnabled = 0xFF;
@@ -0,0 +1,13 @@
+// ConfigKeys.h
+// Keys of the standalone timer's settings in the ConfigLog store (lib/ConfigLog).
+#pragma once
+#include <Arduino.h>
+
+namespace ConfigKey {
+    static constexpr uint8_t Timers = 1;       // uint32_t offTime, onTime (tenths)
+    static constexpr uint8_t Saver = 2;        // uint16_t screensaverDelaySec
+    static constexpr uint8_t WifiEnabled = 3;  // uint8_t
+    static constexpr uint8_t StaSsid = 4;      // char[32]
+    static constexpr uint8_t StaPass = 5;      // char[32]
+    static constexpr uint8_t ApAlwaysOn = 6;   // uint8_t
+}
@@ -6,6 +6,7 @@
 #include <pgmspace.h>
 #include "DisplayManager.h"
 #include "RickRollQrBitmap.h"
+#include "PageBlit.h"
 // Simple 12x8 monochrome icons (packed 1 byte per row, 12 LSB used) rough symbolic representations
 const uint8_t DisplayManager::ICON_WIFI_AP[] PROGMEM         = { 0x3F,0x21,0x21,0x3F,0x04,0x0E,0x0E,0x04 }; // AP box + antenna
 const uint8_t DisplayManager::ICON_WIFI_STA[] PROGMEM        = { 0x00,0x0E,0x11,0x00,0x04,0x0E,0x1F,0x04 }; // WiFi arcs + dot
@@ -14,6 +15,14 @@ const uint8_t DisplayManager::ICON_WIFI_SUPPRESSED[] PROGMEM = { 0x0E,0x11,0x15,
 const uint8_t DisplayManager::ICON_WIFI_HOSTED[] PROGMEM     = { 0x3F,0x21,0x21,0x3F,0x1F,0x04,0x0E,0x04 }; // AP with host marker
 
 void DisplayManager::drawIcon(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h) {
+    PageBlit::Frame frame;
+    if (blitFrame(frame) && h <= 8) {
+        // Column writes into the page buffer; same pixels as the drawPixel loop below
+        uint8_t rows[8];
+        for (uint8_t row=0; row<h; ++row) rows[row] = pgm_read_byte(bitmap + row);
+        PageBlit::rowIcon(frame, x, y, rows, w, h, PageBlit::Mode::Set);
+        return;
+    }
     for (uint8_t row=0; row<h; ++row) {
         uint8_t bits = pgm_read_byte(bitmap + row);
         for (uint8_t col=0; col<w; ++col) {
@@ -232,11 +241,23 @@ void DisplayManager::splash() {
 void DisplayManager::printTimerValue(uint32_t value, int y, const char* label, int editDigit, bool editMode, bool blinkState, bool showDecimal, int startX) {
     char buf[8]; unsigned long integerPart = value/10; unsigned long frac = value%10; snprintf(buf,sizeof(buf),"%04lu%01lu", integerPart, frac);
     display.setTextSize(2); int digitWidth=11; int x=startX;
-    for (int i=0;i<Defaults::DIGITS;i++) {
-        bool inv = editMode && editDigit==i && blinkState; if (inv) { display.setTextColor(BLACK,WHITE); display.fillRect(x,y,digitWidth,16,WHITE);} else { display.setTextColor(WHITE,BLACK); display.fillRect(x,y,digitWidth,16,BLACK);} display.setCursor(x,y); display.print(buf[i]); if (i==Defaults::DIGITS-2) { display.print('.'); x+=digitWidth;} x+=digitWidth; }
+    PageBlit::Frame frame;
+    if (blitFrame(frame)) {
+        // Opaque glyph cells straight into the page buffer, in the GFX path's order: same pixels
+        PageBlit::timerDigits(frame, x, y, buf, Defaults::DIGITS, Defaults::DIGITS-2, digitWidth, (editMode && blinkState) ? editDigit : -1);
+    } else {
+        for (int i=0;i<Defaults::DIGITS;i++) {
+            bool inv = editMode && editDigit==i && blinkState; if (inv) { display.setTextColor(BLACK,WHITE); display.fillRect(x,y,digitWidth,16,WHITE);} else { display.setTextColor(WHITE,BLACK); display.fillRect(x,y,digitWidth,16,BLACK);} display.setCursor(x,y); display.print(buf[i]); if (i==Defaults::DIGITS-2) { display.print('.'); x+=digitWidth;} x+=digitWidth; }
+    }
     int labelX = startX + digitWidth*(Defaults::DIGITS+1)+10; display.setTextSize(1); display.setTextColor(WHITE,BLACK); display.setCursor(labelX,y+7); display.print(label); display.setTextSize(2);
 }
 
+bool DisplayManager::blitFrame(PageBlit::Frame& out) {
+    if (display.getRotation() != 0) return false;
+    out.buf = display.getBuffer(); out.width = display.width(); out.height = display.height();
+    return true;
+}
+
 void DisplayManager::drawProgress(const MenuSystem& menu) {
     unsigned long now = millis(); float prog = menu.progressFraction(now); bool full = menu.progressFull(now);
     if (prog > 0.0f || full) {
@@ -9,6 +9,7 @@
 #include "ConnectivityStatus.h"
 // Replaces previous placeholder QRCode with real (trimmed) generator
 #include "qrcodegen.h"
+#include "PageBlit.h"
 // Portal service forward declared below (avoid heavy dependency here)
 class AsyncPortalService;
 
@@ -39,6 +40,8 @@ private:
   static const uint8_t ICON_WIFI_SUPPRESSED[] PROGMEM;
   static const uint8_t ICON_WIFI_HOSTED[] PROGMEM; // AP always on
   void drawIcon(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
+  // Page-major buffer for PageBlit; false while rotated
+  bool blitFrame(PageBlit::Frame& out);
   Adafruit_SSD1306 display{128,64,&Wire,-1}; Screensaver* screensaver=nullptr; WiFiService* wifi=nullptr; // portal pointer removed
   // Helpers for WiFi QR
   void buildWifiQrString(char *out, size_t cap) const; // WIFI:T:WPA;S:...;P:...;;
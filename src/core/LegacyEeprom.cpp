@@ -0,0 +1,56 @@
+// LegacyEeprom.cpp
+// One-time move of settings from the old EEPROM image into the ConfigLog store.
+#include "LegacyEeprom.h"
+#include <EEPROM.h>
+#include "ConfigKeys.h"
+#include "Defaults.h"
+
+namespace {
+    // Old layout: [0] offTime [4] onTime [8] saver [10] wifiEnabled [11] ssid [43] pass [75] apAlwaysOn
+    constexpr size_t EEPROM_BYTES = 80;
+    constexpr int TIMERS_ADDR = 0;
+    constexpr int SAVER_ADDR = 8;
+    constexpr int WIFI_ADDR = 10;
+    constexpr int SSID_ADDR = 11;
+    constexpr int PASS_ADDR = 43;
+    constexpr int AP_ALWAYS_ADDR = 75;
+
+    bool timerValid(uint32_t tenths) {
+        return tenths >= Defaults::TIMER_MIN && tenths <= Defaults::TIMER_MAX;
+    }
+}
+
+bool importLegacyEeprom(ConfigLog::Store& store) {
+    if (!store.ready() || !store.empty()) return false;
+    EEPROM.begin(EEPROM_BYTES);
+    ConfigLog::Batch batch; // everything imported lands in one atomic commit
+    uint32_t timers[2] = {0, 0};
+    EEPROM.get(TIMERS_ADDR, timers);
+    if (timerValid(timers[0]) && timerValid(timers[1])) {
+        batch.stage(ConfigKey::Timers, timers);
+    }
+    uint16_t saver = 0;
+    EEPROM.get(SAVER_ADDR, saver);
+    if (saver <= 999) batch.stage(ConfigKey::Saver, saver);
+    const uint8_t wifiEnabled = EEPROM.read(WIFI_ADDR);
+    if (wifiEnabled <= 1) batch.stage(ConfigKey::WifiEnabled, wifiEnabled);
+    char ssid[32];
+    char pass[32];
+    EEPROM.get(SSID_ADDR, ssid);
+    EEPROM.get(PASS_ADDR, pass);
+    ssid[sizeof(ssid) - 1] = '\0';
+    pass[sizeof(pass) - 1] = '\0';
+    if (ssid[0] != '\0' && static_cast<uint8_t>(ssid[0]) != 0xFF) {
+        batch.stage(ConfigKey::StaSsid, ssid);
+        batch.stage(ConfigKey::StaPass, pass);
+    }
+    const uint8_t apAlwaysOn = EEPROM.read(AP_ALWAYS_ADDR);
+    if (apAlwaysOn <= 1) batch.stage(ConfigKey::ApAlwaysOn, apAlwaysOn);
+    const bool imported = !batch.empty() && store.commit(batch);
+    if (imported) {
+        for (size_t i = 0; i < EEPROM_BYTES; ++i) EEPROM.write(i, 0);
+        EEPROM.commit();
+    }
+    EEPROM.end();
+    return imported;
+}
@@ -0,0 +1,10 @@
+// LegacyEeprom.h
+// One-time move of settings from the old EEPROM image into the ConfigLog store.
+#pragma once
+#include <Arduino.h>
+#include "ConfigLog.h"
+
+// Runs only while the store is empty. The old image had no magic, so its values go through
+// the same range checks Config::load() applied and land in one atomic commit; the image is
+// zeroed afterwards. Returns true when something was imported.
+bool importLegacyEeprom(ConfigLog::Store& store);
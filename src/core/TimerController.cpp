@@ -3,29 +3,21 @@
 
 void TimerController::begin(Config::Values* cfgVals) {
     cfg = cfgVals;
-    relayState = false;
     timer = 0;
-    lastTickMs = millis();
+    cycle.begin(millis(), cfg->onTime * 100UL, cfg->offTime * 100UL);
 }
 
 void TimerController::tick(unsigned long now) {
     if (state != AppState::RUN) return;
-    unsigned long elapsed = now - lastTickMs;
-    if (elapsed >= 100) {
-        unsigned long steps = elapsed / 100;
-        lastTickMs += steps * 100;
-        while (steps--) {
-            if (relayState) {
-                if (timer < cfg->onTime) timer++; else { relayState = false; timer = 0; }
-            } else {
-                if (timer < cfg->offTime) timer++; else { relayState = true; timer = 0; }
-            }
-        }
-    }
+    // Durations are re-read each tick so edits in cfg apply to the running phase;
+    // advance() catches up in O(1) however long the caller stalled (e.g. in EDIT).
+    cycle.setDurations(cfg->onTime * 100UL, cfg->offTime * 100UL);
+    cycle.advance(now);
+    timer = cycle.elapsed(now) / 100;
 }
 
-void TimerController::resetCycle() { relayState = false; timer = 0; }
-void TimerController::toggleRelayManual() { relayState = !relayState; timer = 0; }
+void TimerController::resetCycle() { cycle.reset(millis()); timer = 0; }
+void TimerController::toggleRelayManual() { cycle.toggle(millis()); timer = 0; }
 
 void TimerController::enterEdit() { state = AppState::EDIT; editDigit = 0; digitsInit=false; cancelled=false; snapshotOff=cfg->offTime; snapshotOn=cfg->onTime; }
 
@@ -117,7 +109,7 @@ void TimerController::reloadFromConfig(const Config::Values& v) {
     // We assume 'v' is the same struct; just ensure timing logic restarts cleanly.
     (void)v; // values already in cfg memory region
     // Restart current phase to make change immediate and deterministic
-    relayState = false; // begin with OFF phase
+    cycle.setDurations(cfg->onTime * 100UL, cfg->offTime * 100UL);
+    cycle.reset(millis()); // begin with OFF phase
     timer = 0;
-    lastTickMs = millis();
 }
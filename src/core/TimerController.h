@@ -3,6 +3,7 @@
 #include "Defaults.h"
 #include "Config.h"
 #include "Buttons.h"
+#include "CycleEngine.h"
 
 class TimerController {
 public:
@@ -15,7 +16,7 @@ public:
   void reloadFromConfig(const Config::Values& v); // new helper to apply updated times
 
   uint32_t currentTimer() const { return timer; }
-  bool isRelayOn() const { return relayState; }
+  bool isRelayOn() const { return cycle.isOn(); }
 
   // Editing logic (digit-by-digit) reused from original code (simplified interface)
   void enterEdit();
@@ -38,7 +39,8 @@ public:
 
 private:
   Config::Values* cfg=nullptr; bool cancelled=false; uint32_t snapshotOff=0; uint32_t snapshotOn=0;
-  bool relayState=false; uint32_t timer=0; AppState state=AppState::RUN; uint8_t editDigit=0; bool digitsInit=false; uint8_t offDigits[Defaults::DIGITS]; uint8_t onDigits[Defaults::DIGITS];
-  unsigned long lastTickMs=0;
+  CycleEngine::Engine<uint32_t> cycle; // millis() ticks; main.cpp drives the relay from isRelayOn()
+  uint32_t timer=0; // tenths elapsed in the current phase (display)
+  AppState state=AppState::RUN; uint8_t editDigit=0; bool digitsInit=false; uint8_t offDigits[Defaults::DIGITS]; uint8_t onDigits[Defaults::DIGITS];
   unsigned long clampEventMs=0; bool clampDidApply=false;
 };
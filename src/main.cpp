@@ -3,6 +3,8 @@
 #include <Wire.h>
 #include "core/Defaults.h"
 #include "core/Config.h"
+#include "core/LegacyEeprom.h"
+#include "ConfigLog.h"
 #include "core/Buttons.h"
 #include "core/TimerController.h"
 #include "core/Screensaver.h"
@@ -13,6 +15,7 @@
 #include "core/ConnectivityStatus.h"
 #include <ESPmDNS.h>
 
+static ConfigLog::Store configStore;
 static Config config;
 static Buttons buttons;
 static TimerController timerCtl;
@@ -41,7 +44,15 @@ void setup() {
   while(!Serial && millis() < 1500) { }
   pinMode(Defaults::RELAY_PIN, OUTPUT);
   Wire.begin(Defaults::OLED_SDA, Defaults::OLED_SCL);
-  config.begin();
+  {
+    ConfigLog::FlashRegion region;
+    if (!ConfigLog::openPartition(region) || !configStore.begin(region)) {
+      Serial.println(F("[CFG] No config log partition, settings will not persist"));
+    } else if (importLegacyEeprom(configStore)) {
+      Serial.println(F("[CFG] Imported settings from legacy EEPROM"));
+    }
+  }
+  config.begin(configStore);
   buttons.begin();
   timerCtl.begin(&config.get());
   displayMgr.begin();
@@ -123,7 +134,7 @@ void setup() {
   asyncPortal.setTimerUpdateCallback([&](uint32_t offTenths, uint32_t onTenths, String &err){
     // Validate
     static unsigned long lastRemoteApply=0;
-    const unsigned long DEBOUNCE_MS = 2000; // 2s debounce for EEPROM wear protection
+    const unsigned long DEBOUNCE_MS = 2000; // 2s debounce for flash wear protection
     unsigned long nowMs = millis();
     if (nowMs - lastRemoteApply < DEBOUNCE_MS) { err = F("Too soon"); return false; }
     if (offTenths < Defaults::TIMER_MIN || offTenths > Defaults::TIMER_MAX) { err = F("Bad off"); return false; }
@@ -0,0 +1,365 @@
+// Host tests for lib/ConfigLog on RamFlash: pio test -e native -f test_config_log
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "ConfigLog.h"
+#include "RamFlash.h"
+
+using ConfigLog::RamFlash;
+using ConfigLog::Store;
+
+namespace {
+
+constexpr uint32_t SECTOR_BYTES = 512;
+constexpr uint8_t SECTORS = 4;
+
+uint32_t valueOf(const Store& store, uint8_t key) {
+    uint32_t v = 0;
+    return store.get(key, v) ? v : 0xFFFFFFFF;
+}
+
+unsigned dirtyCalls = 0;
+void countDirty(void*, bool) { ++dirtyCalls; }
+
+// RamFlash whose writes stall until released, to look at the store while a flush is on flash
+struct GatedFlash {
+    RamFlash flash{SECTOR_BYTES, SECTORS};
+    ConfigLog::FlashRegion inner = flash.region();
+    std::atomic<bool> hold{false};
+    std::atomic<bool> stalled{false};
+
+    ConfigLog::FlashRegion region() {
+        ConfigLog::FlashRegion r = inner;
+        r.ctx = this;
+        r.read = [](void* ctx, uint32_t offset, void* dst, size_t len) {
+            GatedFlash* self = static_cast<GatedFlash*>(ctx);
+            return self->inner.read(self->inner.ctx, offset, dst, len);
+        };
+        r.write = [](void* ctx, uint32_t offset, const void* src, size_t len) {
+            GatedFlash* self = static_cast<GatedFlash*>(ctx);
+            while (self->hold) {
+                self->stalled = true;
+                std::this_thread::yield();
+            }
+            return self->inner.write(self->inner.ctx, offset, src, len);
+        };
+        r.erase = [](void* ctx, uint32_t sector) {
+            GatedFlash* self = static_cast<GatedFlash*>(ctx);
+            return self->inner.erase(self->inner.ctx, sector);
+        };
+        return r;
+    }
+};
+
+// Stands in for ConfigLog::Flusher: flushes on a thread when the overlay is full
+struct ThreadFlusher {
+    Store* store = nullptr;
+    std::atomic<int> fullCalls{0};
+    std::thread worker;
+
+    static void onDirty(void* ctx, bool full) {
+        ThreadFlusher* self = static_cast<ThreadFlusher*>(ctx);
+        if (!full || self->worker.joinable()) return;
+        self->fullCalls++;
+        self->worker = std::thread([self] { self->store->flush(); });
+    }
+};
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_values_survive_remount() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    TEST_ASSERT_TRUE(store.empty());
+    TEST_ASSERT_TRUE(store.put(1, uint32_t{0x11}));
+    TEST_ASSERT_TRUE(store.put(2, uint32_t{0x22}));
+    TEST_ASSERT_TRUE(store.erase(1));
+
+    Store again;
+    TEST_ASSERT_TRUE(again.begin(flash.region()));
+    TEST_ASSERT_FALSE(again.contains(1));
+    TEST_ASSERT_EQUAL_UINT32(0x22, valueOf(again, 2));
+}
+
+// Power cut at every byte of a three-record group: the remounted log shows either the
+// whole group or none of it, and a commit appended afterwards is not glued onto the torn tail.
+void test_torn_group_commit_leaves_no_trace() {
+    const uint32_t groupBytes = 3 * (8 + sizeof(uint32_t));
+    for (uint32_t cut = 0; cut <= groupBytes; ++cut) {
+        RamFlash flash(SECTOR_BYTES, SECTORS);
+        Store store;
+        TEST_ASSERT_TRUE(store.begin(flash.region()));
+        TEST_ASSERT_TRUE(store.put(1, uint32_t{1}));
+        TEST_ASSERT_TRUE(store.put(2, uint32_t{1}));
+
+        ConfigLog::Batch batch;
+        TEST_ASSERT_TRUE(batch.stage(1, uint32_t{2}));
+        TEST_ASSERT_TRUE(batch.stage(2, uint32_t{2}));
+        TEST_ASSERT_TRUE(batch.stage(3, uint32_t{2}));
+        flash.cutPowerAfter(cut);
+        const bool committed = store.commit(batch);
+        flash.restorePower();
+        TEST_ASSERT_EQUAL(cut == groupBytes, committed);
+
+        Store after;
+        TEST_ASSERT_TRUE(after.begin(flash.region()));
+        const uint32_t expect = committed ? 2 : 1;
+        TEST_ASSERT_EQUAL_UINT32(expect, valueOf(after, 1));
+        TEST_ASSERT_EQUAL_UINT32(expect, valueOf(after, 2));
+        TEST_ASSERT_EQUAL(committed, after.contains(3));
+
+        // A lone record behind the torn group must not complete it on the next replay
+        TEST_ASSERT_TRUE(after.put(4, uint32_t{4}));
+        Store again;
+        TEST_ASSERT_TRUE(again.begin(flash.region()));
+        TEST_ASSERT_EQUAL_UINT32(expect, valueOf(again, 1));
+        TEST_ASSERT_EQUAL(committed, again.contains(3));
+        TEST_ASSERT_EQUAL_UINT32(4, valueOf(again, 4));
+    }
+}
+
+// Enough updates to lap the ring many times: live values are copied forward on each
+// compaction, and the erases spread over every sector.
+void test_compaction_rotates_through_the_ring() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    constexpr uint8_t KEYS = 10;
+    TEST_ASSERT_TRUE(store.put(KEYS, uint32_t{0xC0FFEE})); // written once, must survive every lap
+    for (uint32_t i = 0; i < 2000; ++i) {
+        TEST_ASSERT_TRUE(store.put(static_cast<uint8_t>(i % KEYS), i));
+    }
+    const ConfigLog::Stats stats = store.getStats();
+    TEST_ASSERT_TRUE(stats.erases >= 4u * SECTORS);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.failures);
+
+    uint32_t least = UINT32_MAX, most = 0;
+    for (uint8_t s = 0; s < SECTORS; ++s) {
+        const uint32_t n = flash.eraseCount(s);
+        if (n < least) least = n;
+        if (n > most) most = n;
+    }
+    TEST_ASSERT_TRUE(most - least <= 1);
+
+    Store after;
+    TEST_ASSERT_TRUE(after.begin(flash.region()));
+    for (uint8_t key = 0; key < KEYS; ++key) {
+        TEST_ASSERT_EQUAL_UINT32(2000 - KEYS + key, valueOf(after, key));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0xC0FFEE, valueOf(after, KEYS));
+}
+
+// A power cut anywhere in the put that opens a new sector and compacts the oldest one:
+// the next mount finishes the compaction instead of losing values still in the old sector.
+void test_compaction_resumes_after_power_cut() {
+    constexpr uint8_t KEYS = 4;
+    uint32_t trigger = 0; // the put that starts the first compaction
+    {
+        RamFlash dry(SECTOR_BYTES, SECTORS);
+        Store store;
+        TEST_ASSERT_TRUE(store.begin(dry.region()));
+        TEST_ASSERT_TRUE(store.put(50, uint32_t{50}));
+        for (; store.getStats().erases == 0; ++trigger) {
+            TEST_ASSERT_TRUE(store.put(static_cast<uint8_t>(trigger % KEYS), trigger));
+        }
+        --trigger;
+    }
+    // Sector header, copies of key 50 and the counters, then the new record itself
+    const uint32_t worstBytes = 12 + (KEYS + 2) * (8 + sizeof(uint32_t));
+    for (uint32_t cut = 0; cut <= worstBytes; ++cut) {
+        RamFlash flash(SECTOR_BYTES, SECTORS);
+        Store store;
+        TEST_ASSERT_TRUE(store.begin(flash.region()));
+        TEST_ASSERT_TRUE(store.put(50, uint32_t{50}));
+        uint32_t expect[KEYS] = {};
+        for (uint32_t i = 0; i < trigger; ++i) {
+            TEST_ASSERT_TRUE(store.put(static_cast<uint8_t>(i % KEYS), i));
+            expect[i % KEYS] = i;
+        }
+        flash.cutPowerAfter(cut);
+        if (store.put(static_cast<uint8_t>(trigger % KEYS), trigger)) expect[trigger % KEYS] = trigger;
+        flash.restorePower();
+
+        Store after;
+        TEST_ASSERT_TRUE(after.begin(flash.region()));
+        TEST_ASSERT_EQUAL_UINT32(50, valueOf(after, 50));
+        for (uint8_t key = 0; key < KEYS; ++key) TEST_ASSERT_EQUAL_UINT32(expect[key], valueOf(after, key));
+        TEST_ASSERT_TRUE(after.put(51, uint32_t{51}));
+
+        Store again;
+        TEST_ASSERT_TRUE(again.begin(flash.region()));
+        TEST_ASSERT_EQUAL_UINT32(50, valueOf(again, 50));
+        TEST_ASSERT_EQUAL_UINT32(51, valueOf(again, 51));
+    }
+}
+
+// Write-back: repeated commits to one key land in RAM and flush as a single record;
+// a key set back to its stored value before the flush writes nothing at all.
+void test_write_back_coalesces_commits() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    TEST_ASSERT_TRUE(store.put(7, uint32_t{100}));
+    dirtyCalls = 0;
+    store.setWriteBack(true, &countDirty, nullptr);
+    const uint32_t appends = store.getStats().appends;
+
+    for (uint32_t v = 1; v <= 10; ++v) TEST_ASSERT_TRUE(store.put(7, v));
+    TEST_ASSERT_EQUAL_UINT32(10, valueOf(store, 7)); // reads see the overlay
+    TEST_ASSERT_TRUE(store.hasDirty());
+    TEST_ASSERT_EQUAL_UINT32(appends, store.getStats().appends);
+    TEST_ASSERT_EQUAL_UINT32(10, store.getStats().deferred);
+    TEST_ASSERT_EQUAL(10u, dirtyCalls);
+    {
+        Store peek; // nothing reached flash yet
+        TEST_ASSERT_TRUE(peek.begin(flash.region()));
+        TEST_ASSERT_EQUAL_UINT32(100, valueOf(peek, 7));
+    }
+
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_FALSE(store.hasDirty());
+    TEST_ASSERT_EQUAL_UINT32(appends + 1, store.getStats().appends);
+
+    TEST_ASSERT_TRUE(store.put(7, uint32_t{11}));
+    TEST_ASSERT_TRUE(store.put(7, uint32_t{10})); // back to the flushed value
+    TEST_ASSERT_FALSE(store.hasDirty());
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_EQUAL_UINT32(appends + 1, store.getStats().appends);
+
+    Store after;
+    TEST_ASSERT_TRUE(after.begin(flash.region()));
+    TEST_ASSERT_EQUAL_UINT32(10, valueOf(after, 7));
+}
+
+// Each caller stages into its own batch; committing one never writes the other's records
+void test_batches_stay_with_their_caller() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    ConfigLog::Batch first, second;
+    TEST_ASSERT_TRUE(first.stage(1, uint32_t{1}));
+    TEST_ASSERT_TRUE(second.stage(2, uint32_t{2}));
+    TEST_ASSERT_TRUE(first.stage(1, uint32_t{11})); // same key again: last value wins
+    TEST_ASSERT_EQUAL(1, first.size());
+
+    TEST_ASSERT_TRUE(store.commit(first));
+    TEST_ASSERT_TRUE(first.empty());
+    TEST_ASSERT_EQUAL_UINT32(11, valueOf(store, 1));
+    TEST_ASSERT_FALSE(store.contains(2));
+    TEST_ASSERT_EQUAL_UINT32(1, store.getStats().appends);
+
+    // Restaging the stored value writes nothing
+    TEST_ASSERT_TRUE(second.stage(1, uint32_t{11}));
+    TEST_ASSERT_TRUE(store.commit(second));
+    TEST_ASSERT_EQUAL_UINT32(2, store.getStats().appends);
+    TEST_ASSERT_EQUAL_UINT32(2, valueOf(store, 2));
+
+    ConfigLog::Batch full;
+    for (uint8_t key = 0; key < ConfigLog::Batch::CAPACITY; ++key) TEST_ASSERT_TRUE(full.stageErase(key));
+    TEST_ASSERT_FALSE(full.stageErase(ConfigLog::Batch::CAPACITY));
+    TEST_ASSERT_FALSE(full.stage(0, nullptr, ConfigLog::Batch::MAX_VALUE_BYTES + 1));
+}
+
+// Reads and write-back commits go on while a flush is stuck in a flash write, and a key set
+// back to its flash value during the flush is not lost when the flush publishes the older one
+void test_flush_writes_without_blocking_commits() {
+    GatedFlash gated;
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(gated.region()));
+    TEST_ASSERT_TRUE(store.put(1, uint32_t{1}));
+    store.setWriteBack(true);
+    TEST_ASSERT_TRUE(store.put(1, uint32_t{2}));
+    TEST_ASSERT_TRUE(store.put(2, uint32_t{2}));
+
+    gated.hold = true;
+    std::atomic<bool> flushed{false};
+    std::thread flusher([&] { flushed = store.flush(); });
+    while (!gated.stalled) std::this_thread::yield();
+    TEST_ASSERT_EQUAL_UINT32(2, valueOf(store, 1));
+    TEST_ASSERT_TRUE(store.put(1, uint32_t{1})); // the value flash holds before the flush lands
+    TEST_ASSERT_TRUE(store.put(3, uint32_t{3}));
+    TEST_ASSERT_EQUAL_UINT32(1, valueOf(store, 1));
+    gated.hold = false;
+    flusher.join();
+    TEST_ASSERT_TRUE(flushed);
+
+    TEST_ASSERT_FALSE(store.hasDirty()); // the second round wrote the commits made meanwhile
+    TEST_ASSERT_EQUAL_UINT32(1, valueOf(store, 1));
+    Store after;
+    TEST_ASSERT_TRUE(after.begin(gated.flash.region()));
+    TEST_ASSERT_EQUAL_UINT32(1, valueOf(after, 1));
+    TEST_ASSERT_EQUAL_UINT32(2, valueOf(after, 2));
+    TEST_ASSERT_EQUAL_UINT32(3, valueOf(after, 3));
+}
+
+// A commit that does not fit the overlay asks the flusher to take it over instead of writing
+// flash itself; without a flusher it flushes in place
+void test_full_overlay_hands_over_to_the_flusher() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    ThreadFlusher flusher;
+    flusher.store = &store;
+    store.setWriteBack(true, &ThreadFlusher::onDirty, &flusher);
+    for (uint8_t key = 0; key < Store::MAX_BATCH; ++key) TEST_ASSERT_TRUE(store.put(key, uint32_t{key}));
+    TEST_ASSERT_EQUAL(0, flusher.fullCalls.load());
+    TEST_ASSERT_EQUAL_UINT32(0, store.getStats().appends);
+
+    TEST_ASSERT_TRUE(store.put(Store::MAX_BATCH, uint32_t{99}));
+    TEST_ASSERT_EQUAL(1, flusher.fullCalls.load());
+    TEST_ASSERT_EQUAL_UINT32(99, valueOf(store, Store::MAX_BATCH));
+    flusher.worker.join();
+    store.setWriteBack(false);
+    TEST_ASSERT_FALSE(store.hasDirty());
+
+    Store inPlace;
+    TEST_ASSERT_TRUE(inPlace.begin(flash.region()));
+    TEST_ASSERT_EQUAL_UINT32(99, valueOf(inPlace, Store::MAX_BATCH));
+    inPlace.setWriteBack(true);
+    for (uint8_t key = 0; key <= Store::MAX_BATCH; ++key) TEST_ASSERT_TRUE(inPlace.put(key, uint32_t{key + 100u}));
+    TEST_ASSERT_TRUE(inPlace.hasDirty()); // only the commit that did not fit
+    TEST_ASSERT_TRUE(inPlace.flush());
+    Store after;
+    TEST_ASSERT_TRUE(after.begin(flash.region()));
+    for (uint8_t key = 0; key <= Store::MAX_BATCH; ++key) TEST_ASSERT_EQUAL_UINT32(key + 100u, valueOf(after, key));
+}
+
+void test_format_drops_every_key() {
+    RamFlash flash(SECTOR_BYTES, SECTORS);
+    Store store;
+    TEST_ASSERT_TRUE(store.begin(flash.region()));
+    for (uint8_t key = 0; key < 8; ++key) TEST_ASSERT_TRUE(store.put(key, uint32_t{key}));
+    store.setWriteBack(true);
+    TEST_ASSERT_TRUE(store.put(9, uint32_t{9})); // unflushed, dropped as well
+    TEST_ASSERT_TRUE(store.format());
+    TEST_ASSERT_TRUE(store.empty());
+    TEST_ASSERT_FALSE(store.hasDirty());
+
+    Store after;
+    TEST_ASSERT_TRUE(after.begin(flash.region()));
+    TEST_ASSERT_TRUE(after.empty());
+    TEST_ASSERT_TRUE(after.put(3, uint32_t{33}));
+
+    Store again;
+    TEST_ASSERT_TRUE(again.begin(flash.region()));
+    TEST_ASSERT_EQUAL_UINT32(33, valueOf(again, 3));
+    TEST_ASSERT_FALSE(again.contains(0));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_values_survive_remount);
+    RUN_TEST(test_torn_group_commit_leaves_no_trace);
+    RUN_TEST(test_compaction_rotates_through_the_ring);
+    RUN_TEST(test_compaction_resumes_after_power_cut);
+    RUN_TEST(test_write_back_coalesces_commits);
+    RUN_TEST(test_batches_stay_with_their_caller);
+    RUN_TEST(test_flush_writes_without_blocking_commits);
+    RUN_TEST(test_full_overlay_hands_over_to_the_flusher);
+    RUN_TEST(test_format_drops_every_key);
+    return UNITY_END();
+}
@@ -0,0 +1,89 @@
+// Long-run drift checks for lib/CycleEngine on the FogMachineTimer timebase (uint64 microseconds):
+// pio test -e native -f test_cycle_drift
+#include <unity.h>
+#include "CycleEngine.h"
+
+namespace {
+
+using Engine = CycleEngine::Engine<uint64_t>;
+
+constexpr uint64_t ON_US = 100000;  // 0.1 s
+constexpr uint64_t OFF_US = 200000; // 0.2 s
+constexpr uint64_t PERIOD_US = ON_US + OFF_US;
+constexpr uint32_t CYCLES = 1000000;
+constexpr uint64_t START_US = 123456789;
+
+// Deterministic loop jitter, 0..2999 us
+struct Jitter {
+    uint32_t state = 12345;
+    uint64_t next() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % 3000;
+    }
+};
+
+// Scheduled tick of the k-th edge after START_US (edge 0 = first ON)
+uint64_t gridEdge(uint64_t k) {
+    return START_US + OFF_US + (k / 2) * PERIOD_US + (k % 2 ? ON_US : 0);
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+// Polled from a jittered 10 ms loop: every switch is booked on the grid, however late the call
+void test_polled_loop_has_zero_drift() {
+    Engine e;
+    e.begin(START_US, ON_US, OFF_US);
+    Jitter jitter;
+    uint64_t edges = 0;
+    uint64_t now = START_US;
+    while (edges < 2ULL * CYCLES) {
+        now += 10000 + jitter.next();
+        if (!e.advance(now)) continue;
+        TEST_ASSERT_EQUAL_UINT64_MESSAGE(gridEdge(edges), e.lastEdge(), "edge left the grid");
+        ++edges;
+    }
+    TEST_ASSERT_EQUAL_UINT64(gridEdge(2ULL * CYCLES - 1), e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT64(gridEdge(2ULL * CYCLES), e.nextEdge());
+}
+
+// Alarm-driven like TimerController: each edge fires late and is booked with markEdge()
+void test_alarm_marked_edges_have_zero_drift() {
+    Engine e;
+    e.begin(START_US, ON_US, OFF_US);
+    for (uint64_t k = 0; k < 2ULL * CYCLES; ++k) {
+        // However late the alarm ran, the edge is booked at the tick it was scheduled for
+        e.markEdge(e.nextEdge(), !e.cycleOn());
+    }
+    TEST_ASSERT_EQUAL_UINT64(START_US + CYCLES * PERIOD_US, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT64(START_US + CYCLES * PERIOD_US + OFF_US, e.nextEdge());
+    TEST_ASSERT_FALSE(e.cycleOn());
+}
+
+// A 5.5 s stall switches once and the following cycles stay on the original grid
+void test_stall_keeps_grid() {
+    Engine e;
+    e.begin(START_US, ON_US, OFF_US);
+    uint64_t now = START_US + 5500000;
+    e.advance(now);
+    TEST_ASSERT_EQUAL_UINT64(e.cycleOn() ? 0 : ON_US, (e.lastEdge() - START_US - OFF_US) % PERIOD_US);
+    Jitter jitter;
+    uint32_t edges = 0;
+    while (edges < 2000) {
+        now += 10000 + jitter.next();
+        if (!e.advance(now)) continue;
+        const uint64_t since = e.lastEdge() - START_US - OFF_US;
+        TEST_ASSERT_EQUAL_UINT64(e.cycleOn() ? 0 : ON_US, since % PERIOD_US);
+        ++edges;
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_polled_loop_has_zero_drift);
+    RUN_TEST(test_alarm_marked_edges_have_zero_drift);
+    RUN_TEST(test_stall_keeps_grid);
+    return UNITY_END();
+}
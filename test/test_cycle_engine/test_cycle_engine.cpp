@@ -0,0 +1,203 @@
+// Host tests for lib/CycleEngine: pio test -e native -f test_cycle_engine
+#include <unity.h>
+#include "CycleEngine.h"
+
+namespace {
+
+// Counts the level changes the engine hands to its output policy
+struct Recorder {
+    unsigned writes = 0;
+    bool level = false;
+    void write(bool on) {
+        ++writes;
+        level = on;
+    }
+};
+
+using Engine = CycleEngine::Engine<uint32_t, Recorder>;
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_begin_starts_off_and_writes_once() {
+    Engine e;
+    e.begin(1000, 100, 200);
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_FALSE(e.cycleOn());
+    TEST_ASSERT_FALSE(e.overridden());
+    TEST_ASSERT_EQUAL_UINT32(1000, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(1200, e.nextEdge());
+    TEST_ASSERT_EQUAL_UINT32(100, e.onTicks());
+    TEST_ASSERT_EQUAL_UINT32(200, e.offTicks());
+    // The first apply always drives the pin, even to LOW
+    TEST_ASSERT_EQUAL_UINT(1, e.output().writes);
+    TEST_ASSERT_FALSE(e.output().level);
+}
+
+void test_advance_switches_on_schedule() {
+    Engine e;
+    e.begin(1000, 100, 200);
+    TEST_ASSERT_FALSE(e.advance(1199));
+    TEST_ASSERT_TRUE(e.advance(1200));
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(1200, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(1300, e.nextEdge());
+    TEST_ASSERT_FALSE(e.advance(1299));
+    TEST_ASSERT_TRUE(e.advance(1305)); // late call: the edge stays at its scheduled tick
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(1300, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(1500, e.nextEdge());
+    TEST_ASSERT_EQUAL_UINT(3, e.output().writes);
+}
+
+void test_advance_after_stall_skips_whole_periods() {
+    Engine e;
+    e.begin(0, 100, 200);
+    // 1000 whole periods late, 50 ticks into an ON phase: one switch, on the original grid
+    TEST_ASSERT_TRUE(e.advance(200 + 300 * 1000 + 50));
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(200 + 300 * 1000, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT(2, e.output().writes);
+    // Stalled into the OFF phase of a later period: still OFF, no write
+    e.begin(0, 100, 200);
+    TEST_ASSERT_FALSE(e.advance(200 + 300 * 7 + 150));
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(200 + 300 * 7 + 100, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(200 + 300 * 8, e.nextEdge());
+}
+
+void test_advance_ignores_time_before_phase_start() {
+    Engine e;
+    e.begin(1000, 100, 200);
+    TEST_ASSERT_FALSE(e.advance(500));
+    TEST_ASSERT_EQUAL_UINT32(1000, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(0, e.elapsed(500));
+    TEST_ASSERT_EQUAL_UINT32(150, e.elapsed(1150));
+}
+
+void test_tick_wraparound() {
+    Engine e;
+    e.begin(0xFFFFFF00u, 0x80, 0x100);
+    TEST_ASSERT_EQUAL_UINT32(0, e.nextEdge());
+    TEST_ASSERT_FALSE(e.advance(0xFFFFFFFFu));
+    TEST_ASSERT_TRUE(e.advance(0));
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(0x80, e.nextEdge());
+    TEST_ASSERT_TRUE(e.advance(0x80));
+    TEST_ASSERT_FALSE(e.isOn());
+}
+
+void test_set_durations_keeps_phase_start() {
+    Engine e;
+    e.begin(0, 100, 200);
+    // Longer OFF: the running phase is extended from its original start
+    e.setDurations(100, 500);
+    TEST_ASSERT_FALSE(e.advance(300));
+    TEST_ASSERT_EQUAL_UINT32(500, e.nextEdge());
+    TEST_ASSERT_TRUE(e.advance(500));
+    TEST_ASSERT_EQUAL_UINT32(500, e.lastEdge());
+    // Shorter OFF, already overdue: caught up in closed form on the new grid
+    e.begin(0, 100, 1000);
+    e.setDurations(100, 200);
+    TEST_ASSERT_FALSE(e.advance(450)); // ON 200..300, OFF from 300: level unchanged
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(300, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(500, e.nextEdge());
+}
+
+void test_restart_toggle_and_reset() {
+    Engine e;
+    e.begin(0, 100, 200);
+    e.restart(50, true);
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(50, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(150, e.nextEdge());
+    e.toggle(80);
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(80, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(280, e.nextEdge());
+    e.toggle(90);
+    TEST_ASSERT_TRUE(e.isOn());
+    e.reset(95);
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(95, e.lastEdge());
+    TEST_ASSERT_EQUAL_UINT32(295, e.nextEdge());
+    // begin + four level changes
+    TEST_ASSERT_EQUAL_UINT(5, e.output().writes);
+    // Restarting into the current level does not touch the pin
+    e.restart(100, false);
+    TEST_ASSERT_EQUAL_UINT(5, e.output().writes);
+}
+
+void test_override_keeps_schedule_underneath() {
+    Engine e;
+    e.begin(0, 100, 200);
+    e.setOverride(true);
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_TRUE(e.overridden());
+    TEST_ASSERT_EQUAL_UINT(2, e.output().writes);
+    // The timeline runs on, but the forced level does not change
+    TEST_ASSERT_FALSE(e.advance(200));
+    TEST_ASSERT_TRUE(e.cycleOn());
+    TEST_ASSERT_FALSE(e.advance(300));
+    TEST_ASSERT_FALSE(e.cycleOn());
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT(2, e.output().writes);
+    // Releasing returns to what the timeline says (OFF here)
+    e.setOverride(false);
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_FALSE(e.output().level);
+    // toggle() starts from the effective level and clears the override
+    e.setOverride(true);
+    e.toggle(350);
+    TEST_ASSERT_FALSE(e.overridden());
+    TEST_ASSERT_FALSE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(550, e.nextEdge());
+}
+
+void test_mark_edge_moves_the_grid() {
+    Engine e;
+    e.begin(0, 100, 200);
+    TEST_ASSERT_TRUE(e.markEdge(205, true)); // switched elsewhere, booked at its scheduled tick
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT32(305, e.nextEdge());
+    TEST_ASSERT_FALSE(e.markEdge(205, true));
+    TEST_ASSERT_TRUE(e.advance(305));
+    TEST_ASSERT_EQUAL_UINT32(505, e.nextEdge());
+}
+
+void test_zero_period_flips_each_call() {
+    Engine e;
+    e.begin(0, 0, 0);
+    TEST_ASSERT_TRUE(e.advance(10));
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_TRUE(e.advance(10));
+    TEST_ASSERT_FALSE(e.isOn());
+}
+
+void test_null_output_and_64bit_ticks() {
+    CycleEngine::Engine<uint64_t> e;
+    const uint64_t start = 5000000000ULL; // past the 32-bit range
+    e.begin(start, 100000, 200000);
+    TEST_ASSERT_TRUE(e.advance(start + 200000));
+    TEST_ASSERT_TRUE(e.isOn());
+    TEST_ASSERT_EQUAL_UINT64(start + 300000, e.nextEdge());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_starts_off_and_writes_once);
+    RUN_TEST(test_advance_switches_on_schedule);
+    RUN_TEST(test_advance_after_stall_skips_whole_periods);
+    RUN_TEST(test_advance_ignores_time_before_phase_start);
+    RUN_TEST(test_tick_wraparound);
+    RUN_TEST(test_set_durations_keeps_phase_start);
+    RUN_TEST(test_restart_toggle_and_reset);
+    RUN_TEST(test_override_keeps_schedule_underneath);
+    RUN_TEST(test_mark_edge_moves_the_grid);
+    RUN_TEST(test_zero_period_flips_each_call);
+    RUN_TEST(test_null_output_and_64bit_ticks);
+    return UNITY_END();
+}
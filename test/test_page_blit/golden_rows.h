@@ -0,0 +1,124 @@
+// golden_rows.h
+// Expected timer rows for test_page_blit, 67 x 16 pixels from the row start; '#' is lit.
+// On a mismatch the test prints the actual band in this format.
+#pragma once
+
+struct GoldenRow {
+    const char* name;
+    int tenths;
+    int y;
+    int invertIndex; // -1 = none
+    bool segments;
+    const char* rows[16];
+};
+
+static const GoldenRow GOLDEN_ROWS[] = {
+    {"time_12345", 12345, 48, -1, false, {
+            "....##.......######...##########.......##..............##########..",
+            "....##.......######...##########.......##..............##########..",
+            "..####.....##......##.........##.....####..............##..........",
+            "..####.....##......##.........##.....####..............##..........",
+            "....##.............##.......##.....##..##..............########....",
+            "....##.............##.......##.....##..##..............########....",
+            "....##.......######.......####...##....##......................##..",
+            "....##.......######.......####...##....##......................##..",
+            "....##.....##.................##.##########....................##..",
+            "....##.....##.................##.##########....................##..",
+            "....##.....##.........##......##.......##......####....##......##..",
+            "....##.....##.........##......##.......##......####....##......##..",
+            "..######...##########...######.........##......####......######....",
+            "..######...##########...######.........##......####......######....",
+            "...................................................................",
+            "...................................................................",
+    }},
+    {"on_00015_edit2", 15, 24, 2, false, {
+            "..######.....######...##......###....##................##########..",
+            "..######.....######...##......###....##................##########..",
+            "##......##.##......##...######..#..####................##..........",
+            "##......##.##......##...######..#..####................##..........",
+            "##....####.##....####...####....#....##................########....",
+            "##....####.##....####...####....#....##................########....",
+            "##..##..##.##..##..##...##..##..#....##........................##..",
+            "##..##..##.##..##..##...##..##..#....##........................##..",
+            "####....##.####....##.....####..#....##........................##..",
+            "####....##.####....##.....####..#....##........................##..",
+            "##......##.##......##...######..#....##........####....##......##..",
+            "##......##.##......##...######..#....##........####....##......##..",
+            "..######.....######...##......###..######......####......######....",
+            "..######.....######...##......###..######......####......######....",
+            "......................###########..................................",
+            "......................###########..................................",
+    }},
+    {"off_36000_edit3", 36000, 0, 3, false, {
+            "##########.....######...######...##......##############..######....",
+            "##########.....######...######...##......##############..######....",
+            "........##...##.......##......##...######..##############......##..",
+            "........##...##.......##......##...######..##############......##..",
+            "......##...##.........##....####...####....##############....####..",
+            "......##...##.........##....####...####....##############....####..",
+            "....####...########...##..##..##...##..##..##############..##..##..",
+            "....####...########...##..##..##...##..##..##############..##..##..",
+            "........##.##......##.####....##.....####..################....##..",
+            "........##.##......##.####....##.....####..################....##..",
+            "##......##.##......##.##......##...######..####....######......##..",
+            "##......##.##......##.##......##...######..####....######......##..",
+            "..######.....######.....######...##......######....####..######....",
+            "..######.....######.....######...##......######....####..######....",
+            ".................................######################............",
+            ".................................######################............",
+    }},
+    {"unaligned_98765", 98765, 20, -1, false, {
+            "..######.....######...##########.....######............##########..",
+            "..######.....######...##########.....######............##########..",
+            "##......##.##......##.........##...##..................##..........",
+            "##......##.##......##.........##...##..................##..........",
+            "##......##.##......##.........##.##....................########....",
+            "##......##.##......##.........##.##....................########....",
+            "..########...######.........##...########......................##..",
+            "..########...######.........##...########......................##..",
+            "........##.##......##.....##.....##......##....................##..",
+            "........##.##......##.....##.....##......##....................##..",
+            "......##...##......##...##.......##......##....####....##......##..",
+            "......##...##......##...##.......##......##....####....##......##..",
+            "######.......######...##...........######......####......######....",
+            "######.......######...##...........######......####......######....",
+            "...................................................................",
+            "...................................................................",
+    }},
+    {"segments_12345", 12345, 48, -1, true, {
+            ".............######.....######...........................######....",
+            "........##...########...########.##......##............########....",
+            "........##.........##.........##.##......##............##..........",
+            "........##.........##.........##.##......##............##..........",
+            "........##.........##.........##.##......##............##..........",
+            "........##.........##.........##.##......##............##..........",
+            "........##.........##.........##.##......##............##..........",
+            "........##...########...########.##########............########....",
+            "........##.########.....########...########..............########..",
+            "........##.##.................##.........##....................##..",
+            "........##.##.................##.........##....................##..",
+            "........##.##.................##.........##....................##..",
+            "........##.##.................##.........##....................##..",
+            "........##.##.................##.........##....................##..",
+            "........##.########.....########.........##.....##.......########..",
+            ".............######.....######..................##.......######....",
+    }},
+    {"segments_09870_edit4", 987, 24, 4, true, {
+            "..######.....######.....######.....######..............##......##..",
+            "##########.##########.##########.##########............##..........",
+            "##......##.##......##.##......##.##......##............########....",
+            "##......##.##......##.##......##.##......##............########....",
+            "##......##.##......##.##......##.##......##............########....",
+            "##......##.##......##.##......##.##......##............########....",
+            "##......##.##......##.##......##.##......##............########....",
+            "##......##.##......##.##########.##########............########....",
+            "##......##.##......##...########.##########............########....",
+            "##......##.##......##.........##.##......##............########....",
+            "##......##.##......##.........##.##......##............########....",
+            "##......##.##......##.........##.##......##............########....",
+            "##......##.##......##.........##.##......##............########....",
+            "##......##.##......##.........##.##......##............########....",
+            "##########.##########...########.##########.....##.....########....",
+            "..######.....######.....######.....######.......##.....##########..",
+    }},
+};
@@ -0,0 +1,259 @@
+// Host render harness for lib/PageBlit: pio test -e native -f test_page_blit
+// The blitter is compared pixel for pixel with a per-pixel model of the Adafruit GFX calls the
+// firmwares fall back to (drawPixel, fillRect, the classic-font drawChar), timer rows are
+// compared with the golden rows in golden_rows.h, and a cost report is printed per row style.
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "PageBlit.h"
+#include "golden_rows.h"
+
+namespace {
+
+constexpr int W = 128;
+constexpr int H = 64;
+constexpr int FRAME_BYTES = W * H / 8;
+
+// Remote timer row layout (FogMachineRemoteControl Defaults: UI_TIMER_START_X, UI_DIGIT_WIDTH)
+constexpr int START_X = 26;
+constexpr int DIGIT_W = 11;
+constexpr int ROW_W = DIGIT_W * 6 + 1; // five digits and the point cell; the last cell is 12 wide
+constexpr int ROW_H = 16;
+
+// Adafruit glcdfont columns for the characters timer rows use
+struct FontChar {
+    char c;
+    uint8_t cols[5];
+};
+constexpr FontChar FONT[] = {
+    {' ', {0x00, 0x00, 0x00, 0x00, 0x00}}, {'-', {0x08, 0x08, 0x08, 0x08, 0x08}},
+    {'.', {0x00, 0x60, 0x60, 0x00, 0x00}}, {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}}, {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x72, 0x49, 0x49, 0x49, 0x46}}, {'3', {0x21, 0x41, 0x49, 0x4D, 0x33}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}}, {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x31}}, {'7', {0x41, 0x21, 0x11, 0x09, 0x07}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}}, {'9', {0x46, 0x49, 0x49, 0x29, 0x1E}},
+};
+constexpr char CHARSET[] = " -.:0123456789";
+
+// Per-pixel model of Adafruit_SSD1306 + Adafruit_GFX on a 128x64 page-major buffer
+struct RefGfx {
+    uint8_t* buf;
+
+    void drawPixel(int x, int y, bool white) {
+        if (x < 0 || x >= W || y < 0 || y >= H) return;
+        uint8_t& b = buf[x + (y / 8) * W];
+        if (white) b |= static_cast<uint8_t>(1u << (y & 7));
+        else b &= static_cast<uint8_t>(~(1u << (y & 7)));
+    }
+    void fillRect(int x, int y, int w, int h, bool white) {
+        for (int i = x; i < x + w; ++i) {
+            for (int j = y; j < y + h; ++j) drawPixel(i, j, white);
+        }
+    }
+    // GFX drawChar for the built-in font with a background colour
+    void drawChar(int x, int y, char c, bool white, int size) {
+        const uint8_t* cols = nullptr;
+        for (const auto& f : FONT) {
+            if (f.c == c) cols = f.cols;
+        }
+        if (!cols || x >= W || y >= H || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) return;
+        for (int i = 0; i < 5; ++i) {
+            uint8_t line = cols[i];
+            for (int j = 0; j < 8; ++j, line >>= 1) {
+                const bool on = (line & 1) ? white : !white;
+                if (size == 1) drawPixel(x + i, y + j, on);
+                else fillRect(x + i * size, y + j * size, size, size, on);
+            }
+        }
+        fillRect(x + 5 * size, y, size, 8 * size, !white);
+    }
+    // DisplayManager::drawTimerRow's GFX loop (without the label)
+    void timerRow(int x, int y, const char* digits, int invertIndex) {
+        for (int i = 0; i < 5; ++i) {
+            const bool inv = (i == invertIndex);
+            fillRect(x, y, DIGIT_W, 16, inv);
+            drawChar(x, y, digits[i], !inv, 2);
+            if (i == 3) {
+                drawChar(x + 12, y, '.', !inv, 2);
+                x += DIGIT_W;
+            }
+            x += DIGIT_W;
+        }
+    }
+};
+
+struct Frames {
+    uint8_t blit[FRAME_BYTES];
+    uint8_t gfx[FRAME_BYTES];
+    PageBlit::Frame frame{blit, W, H};
+    RefGfx ref{gfx};
+
+    void reset(uint8_t fillByte) {
+        memset(blit, fillByte, sizeof(blit));
+        memset(gfx, fillByte, sizeof(gfx));
+    }
+    bool same() const { return memcmp(blit, gfx, sizeof(blit)) == 0; }
+};
+
+constexpr size_t DIGITS_BUF = 16;
+
+void formatTenths(int tenths, char* out) {
+    snprintf(out, DIGITS_BUF, "%04d%01d", tenths / 10, tenths % 10);
+}
+
+bool pixel(const uint8_t* buf, int x, int y) {
+    return (buf[x + (y / 8) * W] >> (y & 7)) & 1;
+}
+
+void renderGolden(const GoldenRow& row, Frames& f) {
+    char digits[DIGITS_BUF];
+    formatTenths(row.tenths, digits);
+    if (row.segments) PageBlit::timerSegments(f.frame, START_X, row.y, digits, 5, 3, DIGIT_W, row.invertIndex);
+    else PageBlit::timerDigits(f.frame, START_X, row.y, digits, 5, 3, DIGIT_W, row.invertIndex);
+    f.ref.timerRow(START_X, row.y, digits, row.invertIndex);
+}
+
+// The golden's band, '#' for lit pixels; everything outside it must stay dark
+bool matchesGolden(const uint8_t* buf, const GoldenRow& row) {
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            const bool inBand = x >= START_X && x < START_X + ROW_W && y >= row.y && y < row.y + ROW_H;
+            const bool want = inBand && row.rows[y - row.y][x - START_X] == '#';
+            if (pixel(buf, x, y) != want) return false;
+        }
+    }
+    return true;
+}
+
+// Prints the band in golden_rows.h syntax so a deliberate change can be reviewed and pasted
+void printBand(const uint8_t* buf, const GoldenRow& row) {
+    printf("  actual %s:\n", row.name);
+    for (int y = row.y; y < row.y + ROW_H; ++y) {
+        std::string line;
+        for (int x = START_X; x < START_X + ROW_W; ++x) line += pixel(buf, x, y) ? '#' : '.';
+        printf("            \"%s\",\n", line.c_str());
+    }
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+// Random positions including every clipped edge, both sizes, inverted and not, on a frame that
+// already holds noise, so bits outside the cell must survive as well
+void test_glyph_matches_gfx() {
+    Frames f;
+    srand(1234);
+    for (int n = 0; n < 20000; ++n) {
+        f.reset(static_cast<uint8_t>(rand()));
+        memcpy(f.gfx, f.blit, FRAME_BYTES);
+        const char c = CHARSET[rand() % (sizeof(CHARSET) - 1)];
+        const int scale = 1 + rand() % 2;
+        const int x = rand() % (W + 24) - 12;
+        const int y = rand() % (H + 32) - 16;
+        const bool invert = rand() % 2;
+        TEST_ASSERT_TRUE(PageBlit::glyph(f.frame, x, y, c, static_cast<uint8_t>(scale), invert));
+        f.ref.drawChar(x, y, c, !invert, scale);
+        if (!f.same()) {
+            char msg[80];
+            snprintf(msg, sizeof(msg), "glyph '%c' size %d at (%d,%d)%s", c, scale, x, y, invert ? " inverted" : "");
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+    // Characters the blitter lacks are left to GFX, untouched
+    f.reset(0);
+    TEST_ASSERT_FALSE(PageBlit::glyph(f.frame, 0, 0, 'A', 2));
+    TEST_ASSERT_TRUE(f.same());
+}
+
+void test_fill_matches_gfx() {
+    Frames f;
+    srand(99);
+    for (int n = 0; n < 5000; ++n) {
+        f.reset(static_cast<uint8_t>(rand()));
+        memcpy(f.gfx, f.blit, FRAME_BYTES);
+        const int x = rand() % (W + 20) - 10, y = rand() % (H + 20) - 10;
+        const int w = rand() % 40, h = rand() % 70;
+        const bool white = rand() % 2;
+        PageBlit::fill(f.frame, x, y, w, h, white);
+        f.ref.fillRect(x, y, w, h, white);
+        TEST_ASSERT_TRUE_MESSAGE(f.same(), "fill differs from fillRect");
+    }
+}
+
+// What -DUI_BLIT_BENCHMARK used to check on the device: every timer value the UI can show, at
+// every edit position and a row start in each page phase, gives the GFX loop's pixels
+void test_timer_rows_match_gfx() {
+    Frames f;
+    char digits[DIGITS_BUF];
+    for (int tenths = 0; tenths <= 36000; tenths += 7) {
+        formatTenths(tenths, digits);
+        const int y = tenths % 49; // 0..48 covers every shift within a page
+        const int invertIndex = tenths % 6 - 1;
+        f.reset(0);
+        TEST_ASSERT_TRUE(PageBlit::timerDigits(f.frame, START_X, y, digits, 5, 3, DIGIT_W, invertIndex));
+        f.ref.timerRow(START_X, y, digits, invertIndex);
+        if (!f.same()) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "timer row %s at y %d, inverted %d", digits, y, invertIndex);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+void test_timer_rows_match_golden() {
+    Frames f;
+    const char* failed = nullptr;
+    for (const GoldenRow& row : GOLDEN_ROWS) {
+        f.reset(0);
+        renderGolden(row, f);
+        if (!matchesGolden(f.blit, row)) {
+            printBand(f.blit, row); // print every mismatch before failing
+            failed = row.name;
+        }
+        // The GFX model draws the same golden, so the glyph goldens are GFX output too
+        if (!row.segments && !matchesGolden(f.gfx, row)) failed = row.name;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(failed == nullptr, failed);
+}
+
+// Not a pass/fail check: per-row cost of each path on this host, to compare changes with
+void test_cost_report() {
+    Frames f;
+    constexpr int ROUNDS = 20000;
+    char digits[DIGITS_BUF];
+    using Clock = std::chrono::steady_clock;
+    const char* names[] = {"gfx model", "blit", "segment"};
+    volatile uint8_t sink = 0;
+    for (int style = 0; style < 3; ++style) {
+        f.reset(0);
+        const Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < ROUNDS; ++i) {
+            formatTenths(12345 + i % 1000, digits);
+            if (style == 0) f.ref.timerRow(START_X, 48, digits, i % 5);
+            else if (style == 1) PageBlit::timerDigits(f.frame, START_X, 48, digits, 5, 3, DIGIT_W, i % 5);
+            else PageBlit::timerSegments(f.frame, START_X, 48, digits, 5, 3, DIGIT_W, i % 5);
+            sink = static_cast<uint8_t>(sink + f.blit[6 * W + START_X] + f.gfx[6 * W + START_X]);
+        }
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        char msg[64];
+        snprintf(msg, sizeof(msg), "timer row %-9s %6lld ns/row", names[style], ns / ROUNDS);
+        TEST_MESSAGE(msg);
+    }
+    (void)sink;
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_glyph_matches_gfx);
+    RUN_TEST(test_fill_matches_gfx);
+    RUN_TEST(test_timer_rows_match_gfx);
+    RUN_TEST(test_timer_rows_match_golden);
+    RUN_TEST(test_cost_report);
+    return UNITY_END();
+}
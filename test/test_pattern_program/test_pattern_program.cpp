@@ -0,0 +1,113 @@
+// Host tests for lib/PatternProgram: pio test -e native -f test_pattern_program
+#include <unity.h>
+#include <cstdio>
+#include "PatternProgram.h"
+
+using PatternProgram::Runner;
+using PatternProgram::Segment;
+
+namespace {
+
+bool build(const char* source, Runner& runner) {
+    uint8_t code[PatternProgram::MAX_BYTES];
+    size_t len = 0;
+    return PatternProgram::compile(source, code, sizeof(code), &len) && runner.load(code, len);
+}
+
+// Timed segments until Done or Hold, capped so a runaway program fails instead of hanging
+uint32_t countTimed(Runner& runner, Segment::Kind& end, uint32_t cap = 100000) {
+    uint32_t n = 0;
+    for (;;) {
+        const Segment seg = runner.next();
+        if (seg.kind != Segment::Timed || n >= cap) {
+            end = seg.kind;
+            return n;
+        }
+        ++n;
+    }
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_ramp_runs_every_pulse_up_to_255() {
+    const unsigned counts[] = {1, 127, 128, 200, 255};
+    for (unsigned count : counts) {
+        char source[48];
+        snprintf(source, sizeof(source), "ramp 0.1 0.5 0.1 %u", count);
+        Runner runner;
+        TEST_ASSERT_TRUE(build(source, runner));
+        Segment::Kind end;
+        TEST_ASSERT_EQUAL_UINT32(2 * count, countTimed(runner, end));
+        TEST_ASSERT_EQUAL(Segment::Done, end);
+    }
+}
+
+void test_ramp_slides_gaps_linearly() {
+    Runner runner;
+    TEST_ASSERT_TRUE(build("ramp 0.1 0.5 0.1 3", runner));
+    const uint32_t expected[] = {100, 500, 100, 300, 100, 100};
+    for (uint32_t ms : expected) {
+        const Segment seg = runner.next();
+        TEST_ASSERT_EQUAL(Segment::Timed, seg.kind);
+        TEST_ASSERT_EQUAL_UINT32(ms, seg.ms);
+    }
+    TEST_ASSERT_EQUAL(Segment::Done, runner.next().kind);
+}
+
+void test_repeat_and_hold() {
+    Runner runner;
+    TEST_ASSERT_TRUE(build("repeat 3 on 0.2 off 0.3 next hold on off 1", runner));
+    Segment::Kind end;
+    TEST_ASSERT_EQUAL_UINT32(6, countTimed(runner, end));
+    TEST_ASSERT_EQUAL(Segment::Hold, end);
+    const Segment last = runner.next();
+    TEST_ASSERT_EQUAL(Segment::Timed, last.kind);
+    TEST_ASSERT_EQUAL_UINT32(1000, last.ms);
+    TEST_ASSERT_EQUAL(Segment::Done, runner.next().kind);
+}
+
+void test_validate_rejects_loops_without_time() {
+    Runner runner;
+    // Finite or endless, a body of zero-length steps would hit MAX_STEPS on the timer
+    TEST_ASSERT_FALSE(build("repeat 100 off 0 next on 1", runner));
+    TEST_ASSERT_FALSE(build("repeat 2 on 0 next", runner));
+    TEST_ASSERT_FALSE(build("repeat 0 off 0 next", runner));
+    TEST_ASSERT_FALSE(build("repeat 3 repeat 50 on 0 next on 1 next", runner));
+    TEST_ASSERT_FALSE(build("ramp 0 0 0 200", runner));
+    // Time spent anywhere in the body (or a HOLD) is enough
+    TEST_ASSERT_TRUE(build("repeat 0 on 0.5 off 0 next", runner));
+    TEST_ASSERT_TRUE(build("repeat 3 repeat 2 on 0.1 next off 0 next", runner));
+    TEST_ASSERT_TRUE(build("repeat 0 hold off next", runner));
+    TEST_ASSERT_TRUE(build("ramp 0.1 0 0 0", runner)); // no pulses: a no-op
+}
+
+void test_validate_rejects_malformed_code() {
+    const uint8_t truncated[] = {static_cast<uint8_t>(PatternProgram::Op::On), 0x0A};
+    const uint8_t unbalanced[] = {static_cast<uint8_t>(PatternProgram::Op::Next)};
+    const uint8_t unknown[] = {0x7F};
+    TEST_ASSERT_FALSE(PatternProgram::validate(truncated, sizeof(truncated)));
+    TEST_ASSERT_FALSE(PatternProgram::validate(unbalanced, sizeof(unbalanced)));
+    TEST_ASSERT_FALSE(PatternProgram::validate(unknown, sizeof(unknown)));
+    TEST_ASSERT_FALSE(PatternProgram::validate(unknown, 0));
+}
+
+void test_duration_encoding() {
+    TEST_ASSERT_EQUAL_UINT32(10, PatternProgram::decodeDuration(PatternProgram::encodeDuration(10)));
+    TEST_ASSERT_EQUAL_UINT32(327670, PatternProgram::decodeDuration(PatternProgram::encodeDuration(327670)));
+    // Past 10 ms resolution: whole seconds
+    TEST_ASSERT_EQUAL_UINT32(400000, PatternProgram::decodeDuration(PatternProgram::encodeDuration(400200)));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ramp_runs_every_pulse_up_to_255);
+    RUN_TEST(test_ramp_slides_gaps_linearly);
+    RUN_TEST(test_repeat_and_hold);
+    RUN_TEST(test_validate_rejects_loops_without_time);
+    RUN_TEST(test_validate_rejects_malformed_code);
+    RUN_TEST(test_duration_encoding);
+    return UNITY_END();
+}
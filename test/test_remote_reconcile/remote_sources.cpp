@@ -0,0 +1,4 @@
+// remote_sources.cpp
+// The remote's device list, built unchanged for the host against test_remote_ui's fakes.
+#include "../test_remote_ui/fakes/FakeArduino.cpp"
+#include "../../FogMachineRemoteControl/src/device/DeviceManager.cpp"
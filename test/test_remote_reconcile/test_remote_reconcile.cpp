@@ -0,0 +1,145 @@
+// Host tests for the remote's desired-state reconciler: pio test -e native -f test_remote_reconcile
+// CommManager::reconcileDesired() sends whatever DeviceManager::nextReconcileStep() asks for and
+// reports link results back; the loop below plays both the reconciler and the link layer, with
+// CONFIGURE's finite retry budget, so the give-up path runs against a timer that never answers.
+#include <unity.h>
+#include <string.h>
+#include "RamFlash.h"
+#include "device/DeviceManager.h"
+
+namespace {
+
+ConfigLog::RamFlash* flash = nullptr;
+ConfigLog::Store* store = nullptr;
+DeviceManager* devices = nullptr;
+
+const uint8_t MAC[6] = {0x24, 0x6F, 0x28, 0x10, 0x20, 0x01};
+constexpr unsigned long TICK_MS = 10; // remote loop cadence for the simulation
+constexpr unsigned long CONFIGURE_TIMEOUT_MS = Defaults::CONFIGURE_MAX_ATTEMPTS * Defaults::COMM_RETRY_INTERVAL_MS;
+
+int pairOne() {
+    SlaveDevice dev;
+    memcpy(dev.mac, MAC, sizeof(MAC));
+    strncpy(dev.name, "Stage", sizeof(dev.name) - 1);
+    devices->addDevice(dev);
+    const int idx = devices->findDeviceByMac(MAC);
+    SlaveLive* live = devices->live(idx);
+    live->ton = 1.0f;
+    live->toff = 10.0f;
+    return idx;
+}
+
+struct RunResult {
+    int sends = 0;
+    bool gaveUp = false;
+    unsigned long elapsedMs = 0;
+};
+
+// Runs the reconciler for up to limitMs. A timer that never answers means every CONFIGURE
+// ends in a link timeout (when timeouts is set) and no STATUS ever arrives.
+RunResult runSilent(int idx, unsigned long limitMs, bool timeouts) {
+    RunResult r;
+    unsigned long timeoutAt = 0;
+    bool inFlight = false;
+    const unsigned long start = millis();
+    while (millis() - start < limitMs) {
+        const unsigned long now = millis();
+        if (inFlight && timeouts && now >= timeoutAt) {
+            devices->markReconcileEnded(idx);
+            inFlight = false;
+        }
+        const ReconcileStep step = devices->nextReconcileStep(idx, now);
+        if (step == ReconcileStep::GiveUp) {
+            r.gaveUp = true;
+            break;
+        }
+        if (step == ReconcileStep::Send) {
+            devices->markReconcileSent(idx, now);
+            ++r.sends;
+            inFlight = true;
+            timeoutAt = now + CONFIGURE_TIMEOUT_MS;
+        }
+        FakeArduino::advanceMs(TICK_MS);
+    }
+    r.elapsedMs = millis() - start;
+    return r;
+}
+
+} // namespace
+
+void setUp() {
+    FakeArduino::reset();
+    FakeArduino::nowUs = 1000ull * 1000u;
+    flash = new ConfigLog::RamFlash(4096, 4);
+    store = new ConfigLog::Store();
+    store->begin(flash->region());
+    devices = new DeviceManager();
+    devices->begin(*store);
+}
+
+void tearDown() {
+    delete devices;
+    delete store;
+    delete flash;
+}
+
+void test_silent_timer_gives_up_after_max_attempts() {
+    const int idx = pairOne();
+    devices->setDesiredTimer(idx, 2.0f, 20.0f);
+    const RunResult r = runSilent(idx, 60000, true);
+    TEST_ASSERT_TRUE(r.gaveUp);
+    TEST_ASSERT_EQUAL_INT(Defaults::RECONCILE_MAX_ATTEMPTS, r.sends);
+    // Settle, then one retry period per send
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(Defaults::RECONCILE_SETTLE_MS + Defaults::RECONCILE_MAX_ATTEMPTS * Defaults::RECONCILE_RETRY_MS + TICK_MS,
+                                     r.elapsedMs);
+    // The intent is dropped; the device keeps what the timer last reported
+    TEST_ASSERT_FALSE(devices->hasPendingDesired(idx));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, devices->getDevice(idx).ton);
+    TEST_ASSERT_EQUAL(ReconcileStep::Idle, devices->nextReconcileStep(idx, millis()));
+}
+
+void test_exchange_without_an_end_never_gives_up() {
+    // What unlimited CONFIGURE retries did: the exchange never ends, so the give-up is unreachable
+    const int idx = pairOne();
+    devices->setDesiredTimer(idx, 2.0f, 20.0f);
+    const RunResult r = runSilent(idx, 60000, false);
+    TEST_ASSERT_FALSE(r.gaveUp);
+    TEST_ASSERT_EQUAL_INT(1, r.sends);
+    TEST_ASSERT_TRUE(devices->hasPendingDesired(idx));
+}
+
+void test_reported_status_clears_the_intent() {
+    const int idx = pairOne();
+    devices->setDesiredTimer(idx, 2.0f, 20.0f);
+    FakeArduino::advanceMs(Defaults::RECONCILE_SETTLE_MS);
+    TEST_ASSERT_EQUAL(ReconcileStep::Send, devices->nextReconcileStep(idx, millis()));
+    devices->markReconcileSent(idx, millis());
+    devices->markReconcileEnded(idx); // ACK
+    SlaveLive* live = devices->live(idx);
+    live->ton = 2.0f;
+    live->toff = 20.0f;
+    TEST_ASSERT_TRUE(devices->reconcileReported(idx));
+    TEST_ASSERT_EQUAL(ReconcileStep::Idle, devices->nextReconcileStep(idx, millis()));
+}
+
+void test_new_edit_restarts_the_attempt_budget() {
+    const int idx = pairOne();
+    devices->setDesiredTimer(idx, 2.0f, 20.0f);
+    const RunResult first = runSilent(idx, Defaults::RECONCILE_SETTLE_MS + Defaults::RECONCILE_RETRY_MS + TICK_MS, true);
+    TEST_ASSERT_EQUAL_INT(2, first.sends);
+    FakeArduino::advanceMs(CONFIGURE_TIMEOUT_MS);
+    devices->markReconcileEnded(idx);
+    devices->setDesiredTimer(idx, 3.0f, 30.0f);
+    const RunResult second = runSilent(idx, 60000, true);
+    TEST_ASSERT_TRUE(second.gaveUp);
+    TEST_ASSERT_EQUAL_INT(Defaults::RECONCILE_MAX_ATTEMPTS, second.sends);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_silent_timer_gives_up_after_max_attempts);
+    RUN_TEST(test_exchange_without_an_end_never_gives_up);
+    RUN_TEST(test_reported_status_clears_the_intent);
+    RUN_TEST(test_new_edit_restarts_the_attempt_budget);
+    return UNITY_END();
+}
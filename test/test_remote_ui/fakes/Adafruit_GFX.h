@@ -0,0 +1,62 @@
+// Adafruit_GFX.h
+// Host stand-in for Adafruit_GFX with the classic 5x7 font only. Text, lines and rectangles
+// follow the library's algorithms (write() wrapping, drawChar's background column, Bresenham
+// for sloped lines), so pixels match the device; every call is also counted in gfxCounts.
+#pragma once
+#include <Arduino.h>
+
+struct GfxCounts {
+    uint32_t fillRect = 0;
+    uint32_t drawLine = 0;
+    uint32_t drawRect = 0;
+    uint32_t drawTriangle = 0;
+    uint32_t chars = 0;       // glyphs drawn by write()
+    uint32_t clears = 0;
+    uint32_t pixelWrites = 0; // drawPixel calls the primitives above boil down to
+    uint32_t primitives() const { return fillRect + drawLine + drawRect + drawTriangle + chars; }
+};
+// Calls made by any display since the test last cleared it
+extern GfxCounts gfxCounts;
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    // One colour draws transparent text; with a background every glyph cell is painted
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextSize(uint8_t s) { textsize = s > 0 ? s : 1; }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool x = true) { _cp437 = x; }
+    void setRotation(uint8_t r);
+    uint8_t getRotation() const { return rotation; }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+protected:
+    void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    const int16_t WIDTH, HEIGHT;
+    int16_t _width, _height;
+    int16_t cursor_x = 0, cursor_y = 0;
+    uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+    uint8_t textsize = 1;
+    uint8_t rotation = 0;
+    bool wrap = true;
+    bool _cp437 = false;
+};
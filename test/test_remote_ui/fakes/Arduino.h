@@ -0,0 +1,110 @@
+// Arduino.h
+// Host stand-in for the Arduino-ESP32 core, enough to build the remote's ui/ and menu/ in
+// env:native: a settable clock, pin and ADC levels, Print, Serial and the FreeRTOS task calls
+// OledFlusher makes (task creation fails, so frames flush inline).
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define DEC 10
+#define HEX 16
+
+// Arduino-ESP32 pulls these into the global namespace
+using std::max;
+using std::min;
+
+namespace FakeArduino {
+// Clock read by millis()/micros(); tests move it explicitly
+extern uint64_t nowUs;
+inline void advanceMs(uint32_t ms) { nowUs += (uint64_t)ms * 1000u; }
+// digitalRead() level per GPIO (buttons are active low, so idle is HIGH)
+constexpr int PIN_COUNT = 32;
+extern int pinLevel[PIN_COUNT];
+// analogRead() result; analogReadMilliVolts() scales it like a 12-bit, 3.3 V ADC
+extern uint16_t adcRaw;
+void reset();
+} // namespace FakeArduino
+
+inline unsigned long millis() { return (unsigned long)(FakeArduino::nowUs / 1000u); }
+inline unsigned long micros() { return (unsigned long)FakeArduino::nowUs; }
+inline void delay(uint32_t ms) { FakeArduino::advanceMs(ms); }
+inline void delayMicroseconds(uint32_t us) { FakeArduino::nowUs += us; }
+inline void yield() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) { return pin < FakeArduino::PIN_COUNT ? FakeArduino::pinLevel[pin] : HIGH; }
+inline void digitalWrite(uint8_t pin, uint8_t level) { if (pin < FakeArduino::PIN_COUNT) FakeArduino::pinLevel[pin] = level; }
+inline uint16_t analogRead(uint8_t) { return FakeArduino::adcRaw; }
+inline uint32_t analogReadMilliVolts(uint8_t) { return (uint32_t)FakeArduino::adcRaw * 3300u / 4095u; }
+
+// Arduino's Print: the overload set decides how print(x) formats, so it is kept as is
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t n) {
+        size_t done = 0;
+        while (n--) done += write(*buf++);
+        return done;
+    }
+    size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) {
+        if (base == DEC && v < 0) return print('-') + print((unsigned long)(-v), base);
+        return print((unsigned long)v, base);
+    }
+    size_t print(unsigned long v, int base = DEC) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+        return write(buf);
+    }
+    size_t print(double v, int digits = 2) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.*f", digits, v);
+        return write(buf);
+    }
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T v) { return print(v) + println(); }
+    template <typename T>
+    size_t println(T v, int arg) { return print(v, arg) + println(); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// Serial output is discarded unless a test turns echo on
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    using Print::write;
+    bool echo = false;
+};
+extern HardwareSerial Serial;
+
+// FreeRTOS, as far as OledFlusher uses it
+using TaskHandle_t = void*;
+using UBaseType_t = unsigned;
+using BaseType_t = int;
+using TaskFunction_t = void (*)(void*);
+#define pdTRUE 1
+#define pdPASS 1
+#define pdFAIL 0
+#define tskIDLE_PRIORITY 0
+#define portMAX_DELAY 0xFFFFFFFFu
+inline BaseType_t xTaskCreate(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t*) { return pdFAIL; }
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, uint32_t) { return 0; }
@@ -0,0 +1,120 @@
+// FakeArduino.cpp
+// Clock, pins, Serial and the SSD1306 bus model behind the host Arduino.h and Wire.h.
+#include <Arduino.h>
+#include <Wire.h>
+#include <stdarg.h>
+
+namespace FakeArduino {
+
+uint64_t nowUs = 0;
+int pinLevel[PIN_COUNT];
+uint16_t adcRaw = 0;
+
+void reset() {
+    nowUs = 0;
+    for (int& level : pinLevel) level = HIGH;
+    adcRaw = 0;
+}
+
+} // namespace FakeArduino
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+size_t Print::printf(const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n <= 0) return 0;
+    return write((const uint8_t*)buf, std::min((size_t)n, sizeof(buf) - 1));
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (echo) putchar(c);
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+    (void)stop;
+    if (addr == 0x3C) panel.transmission(tx, len);
+    len = 0;
+    return 0;
+}
+
+void FakePanel::reset() {
+    memset(ram, 0, sizeof(ram));
+    on = false;
+    contrast = 0x7F;
+    pageStart = page = 0;
+    pageEnd = PAGES - 1;
+    colStart = col = 0;
+    colEnd = WIDTH - 1;
+    argsLeft = 0;
+    clearCounts();
+}
+
+void FakePanel::transmission(const uint8_t* bytes, size_t len) {
+    if (len == 0) return;
+    ++transactions;
+    busBytes += (uint32_t)len + 1;
+    const uint8_t control = bytes[0];
+    if (control == 0x00) {
+        commandBytes += (uint32_t)(len - 1);
+        for (size_t i = 1; i < len; ++i) command(bytes[i]);
+        return;
+    }
+    if (control != 0x40) return;
+    dataBytes += (uint32_t)(len - 1);
+    for (size_t i = 1; i < len; ++i) {
+        ram[page * WIDTH + col] = bytes[i];
+        if (col < colEnd) {
+            ++col;
+            continue;
+        }
+        col = colStart;
+        page = page < pageEnd ? page + 1 : pageStart;
+    }
+}
+
+void FakePanel::command(uint8_t b) {
+    if (argsLeft) {
+        args[argCount++] = b;
+        if (--argsLeft) return;
+        switch (pendingCmd) {
+        case 0x21: // COLUMNADDR
+            colStart = col = args[0] & 0x7F;
+            colEnd = args[1] & 0x7F;
+            break;
+        case 0x22: // PAGEADDR
+            pageStart = page = args[0] & 0x07;
+            pageEnd = args[1] > 7 ? 7 : args[1];
+            break;
+        case 0x81: // SETCONTRAST
+            contrast = args[0];
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+    pendingCmd = b;
+    argCount = 0;
+    switch (b) {
+    case 0x21: case 0x22:
+        argsLeft = 2;
+        break;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        argsLeft = 1;
+        break;
+    case 0xAE:
+        on = false;
+        break;
+    case 0xAF:
+        on = true;
+        break;
+    default:
+        break;
+    }
+}
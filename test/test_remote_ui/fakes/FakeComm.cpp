@@ -0,0 +1,75 @@
+// FakeComm.cpp
+// The CommManager methods ui/ and menu/ call, without ESP-NOW behind them.
+#include "FakeComm.h"
+
+namespace FakeComm {
+
+std::vector<CommManager::DiscoveredDevice> discovered;
+std::vector<std::string> calls;
+
+void reset() {
+    discovered.clear();
+    calls.clear();
+}
+
+} // namespace FakeComm
+
+CommManager* CommManager::instance = nullptr;
+
+CommManager::CommManager(DeviceManager& deviceMgr, RemoteChannelManager& channelMgr)
+    : deviceManager(deviceMgr), channelManager(channelMgr) {}
+
+void CommManager::begin() {
+    instance = this;
+    discovering = false;
+    discovered.clear();
+    phaseGroupActive = false;
+    sweepActive = false;
+}
+
+void CommManager::startDiscovery(uint32_t durationMs) {
+    FakeComm::calls.push_back("startDiscovery");
+    discovering = true;
+    discoveryEnd = durationMs ? millis() + durationMs : 0;
+    discovered = FakeComm::discovered;
+}
+
+void CommManager::stopDiscovery() {
+    FakeComm::calls.push_back("stopDiscovery");
+    discovering = false;
+}
+
+void CommManager::pairWithIndex(int idx) {
+    FakeComm::calls.push_back("pairWithIndex");
+    if (idx < 0 || idx >= (int)discovered.size()) return;
+    SlaveDevice dev;
+    memcpy(dev.mac, discovered[idx].mac, sizeof(dev.mac));
+    memcpy(dev.name, discovered[idx].name, sizeof(dev.name));
+    deviceManager.addDevice(dev);
+}
+
+void CommManager::requestStatus(const SlaveDevice&) { FakeComm::calls.push_back("requestStatus"); }
+void CommManager::requestStatusActive() { FakeComm::calls.push_back("requestStatusActive"); }
+void CommManager::setActiveName(const char*) { FakeComm::calls.push_back("setActiveName"); }
+void CommManager::setActiveTimer(float, float) { FakeComm::calls.push_back("setActiveTimer"); }
+void CommManager::factoryResetActive() { FakeComm::calls.push_back("factoryResetActive"); }
+
+void CommManager::startPhaseGroup(uint32_t) {
+    FakeComm::calls.push_back("startPhaseGroup");
+    phaseGroupActive = true;
+}
+
+void CommManager::stopPhaseGroup() {
+    FakeComm::calls.push_back("stopPhaseGroup");
+    phaseGroupActive = false;
+}
+
+void CommManager::startStatusSweep() {
+    FakeComm::calls.push_back("startStatusSweep");
+    sweepActive = true;
+}
+
+void CommManager::removeDeviceByIndex(int idx) {
+    FakeComm::calls.push_back("removeDeviceByIndex");
+    deviceManager.removeDevice(idx);
+}
@@ -0,0 +1,14 @@
+// FakeComm.h
+// CommManager for the host UI build: the real header and inline helpers, with the radio-facing
+// methods replaced by a call log. Discovery "finds" whatever the test puts in discovered.
+#pragma once
+#include <string>
+#include <vector>
+#include "comm/CommManager.h"
+
+namespace FakeComm {
+extern std::vector<CommManager::DiscoveredDevice> discovered;
+// Radio-facing calls the UI made, by method name, oldest first
+extern std::vector<std::string> calls;
+void reset();
+} // namespace FakeComm
@@ -0,0 +1,62 @@
+// Wire.h
+// Host stand-in for the Arduino TwoWire: transmissions go to a model of the SSD1306 panel, which
+// keeps its own GDDRAM, so a test sees what the flusher actually put on the screen.
+#pragma once
+#include <Arduino.h>
+
+// Arduino-ESP32's TwoWire buffer; OledFlusher sizes its data chunks from it
+#define I2C_BUFFER_LENGTH 128
+
+// SSD1306 as seen from the bus: control byte 0x00 starts a command stream, 0x40 a data stream.
+// Data lands in the PAGEADDR/COLUMNADDR window in horizontal addressing mode.
+struct FakePanel {
+    static constexpr int WIDTH = 128;
+    static constexpr int PAGES = 8;
+    uint8_t ram[WIDTH * PAGES] = {};
+    bool on = false;
+    uint8_t contrast = 0x7F;
+    // Since the last clearCounts(): payload after the control byte, transmissions, and every
+    // byte on the bus (address and control bytes included)
+    uint32_t dataBytes = 0;
+    uint32_t commandBytes = 0;
+    uint32_t transactions = 0;
+    uint32_t busBytes = 0;
+
+    void reset();
+    void clearCounts() { dataBytes = commandBytes = transactions = busBytes = 0; }
+    void transmission(const uint8_t* bytes, size_t len);
+    bool pixel(int x, int y) const { return (ram[x + (y / 8) * WIDTH] >> (y & 7)) & 1; }
+
+private:
+    void command(uint8_t b);
+    uint8_t pageStart = 0, pageEnd = PAGES - 1, colStart = 0, colEnd = WIDTH - 1;
+    uint8_t page = 0, col = 0;
+    // Multi-byte command in progress (commands may span transmissions)
+    uint8_t pendingCmd = 0, argsLeft = 0, args[2] = {}, argCount = 0;
+};
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t hz = 0) { (void)sda; (void)scl; (void)hz; return true; }
+    void setClock(uint32_t hz) { clockHz = hz; }
+    void beginTransmission(uint8_t address) { addr = address; len = 0; }
+    size_t write(uint8_t b) {
+        if (len >= sizeof(tx)) return 0;
+        tx[len++] = b;
+        return 1;
+    }
+    size_t write(const uint8_t* data, size_t n) {
+        size_t done = 0;
+        while (done < n && write(data[done])) ++done;
+        return done;
+    }
+    uint8_t endTransmission(bool stop = true);
+    uint32_t clockHz = 0;
+    FakePanel panel;
+
+private:
+    uint8_t addr = 0;
+    uint8_t tx[256] = {};
+    size_t len = 0;
+};
+extern TwoWire Wire;
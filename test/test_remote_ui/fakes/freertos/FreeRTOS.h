@@ -0,0 +1,4 @@
+// FreeRTOS.h
+// The task calls the remote makes live in the fake Arduino.h, as the core pulls them in there.
+#pragma once
+#include <Arduino.h>
@@ -0,0 +1,6 @@
+// queue.h
+// Queue handle for headers that hold one; the harness never creates a queue.
+#pragma once
+#include "FreeRTOS.h"
+
+using QueueHandle_t = void*;
@@ -0,0 +1,18 @@
+// remote_sources.cpp
+// The remote's display, menu and input code, built unchanged for the host against the fakes.
+#include "../../FogMachineRemoteControl/src/ui/DisplayManager.cpp"
+#include "../../FogMachineRemoteControl/src/ui/OledFlusher.cpp"
+#include "../../FogMachineRemoteControl/src/ui/ButtonInput.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawOthers/DrawBatteryIndicator.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawOthers/DrawBootStatus.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawOthers/DrawProgressBar.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawOthers/DrawTimerRow.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawScreens/DrawErrorScreen.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawScreens/DrawMainScreen.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawScreens/DrawMenu.cpp"
+#include "../../FogMachineRemoteControl/src/ui/drawScreens/DrawUpdateCountdown.cpp"
+#include "../../FogMachineRemoteControl/src/menu/MenuSystem.cpp"
+#include "../../FogMachineRemoteControl/src/device/DeviceManager.cpp"
+#include "../../FogMachineRemoteControl/src/battery/BatteryMonitor.cpp"
+#include "../../FogMachineRemoteControl/src/calibration/CalibrationManager.cpp"
+#include "../../FogMachineRemoteControl/src/debug/DebugMetrics.cpp"
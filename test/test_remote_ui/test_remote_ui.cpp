@@ -0,0 +1,353 @@
+// Host render harness for the remote's ui/ and menu/: pio test -e native -f test_remote_ui
+// DisplayManager, MenuSystem and the draw code are built unchanged against fakes of
+// Adafruit_SSD1306/GFX, Wire and millis() (fakes/). Each screen is reached the way the user
+// gets there, rendered, and what the flusher put on the panel model is compared with
+// golden/<screen>.pbm; one screen per MenuSystem::Mode. A cost report per screen follows.
+// UPDATE_GOLDENS=1 rewrites the goldens; a mismatch leaves <screen>.actual.pbm next to them.
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Pins.h"
+#include "RamFlash.h"
+#include "FakeComm.h"
+#include "battery/BatteryMonitor.h"
+#include "calibration/CalibrationManager.h"
+#include "channel/RemoteChannelManager.h"
+#include "device/DeviceManager.h"
+#include "menu/MenuSystem.h"
+#include "ui/ButtonInput.h"
+#include "ui/DisplayManager.h"
+
+namespace {
+
+constexpr int W = 128;
+constexpr int H = 64;
+using Mode = MenuSystem::Mode;
+
+// The remote as main.cpp wires it, minus the radio
+struct Remote {
+    ConfigLog::RamFlash flash{4096, 4};
+    ConfigLog::Store store;
+    DeviceManager devices;
+    CalibrationManager calibration;
+    BatteryMonitor battery{BAT_ADC_PIN, calibration};
+    MenuSystem menu;
+    ButtonInput buttons{BUTTON_UP_GPIO, BUTTON_DOWN_GPIO, BUTTON_HASH_GPIO, BUTTON_STAR_GPIO};
+    RemoteChannelManager channels;
+    CommManager comm{devices, channels};
+    DisplayManager display;
+
+    Remote() {
+        FakeArduino::reset();
+        FakeArduino::nowUs = 5000ull * 1000u;
+        FakeArduino::pinLevel[CHARGER_CHG_GPIO] = LOW; // on battery, not charging
+        FakeArduino::pinLevel[CHARGER_PWR_GPIO] = LOW;
+        FakeArduino::adcRaw = 2900;                    // 75 % on the default calibration
+        FakeComm::reset();
+        Wire.panel.reset();
+        Adafruit_SSD1306::failBegin = false;
+        store.begin(flash.region());
+        devices.begin(store);
+        calibration.begin(store);
+        battery.begin();
+        menu.begin();
+        buttons.begin();
+        comm.begin();
+        display.setSkipSplash(true);
+        display.begin();
+    }
+
+    void pair(uint8_t tail, const char* name, float ton, float toff, float elapsed, bool on, int8_t rssi) {
+        SlaveDevice dev;
+        const uint8_t mac[6] = {0x24, 0x6F, 0x28, 0x10, 0x20, tail};
+        memcpy(dev.mac, mac, sizeof(mac));
+        strncpy(dev.name, name, sizeof(dev.name) - 1);
+        devices.addDevice(dev);
+        const int idx = devices.findDeviceByMac(mac);
+        SlaveLive* live = devices.live(idx);
+        live->ton = ton;
+        live->toff = toff;
+        live->elapsed = elapsed;
+        live->outputState = on;
+        live->rssiSlave = rssi;
+        live->lastStatusMs = millis();
+        devices.noteRssi(idx, (int8_t)(rssi - 3));
+    }
+
+    // Three timers, the first active and running
+    void pairFleet() {
+        pair(0x01, "Stage L", 2.5f, 30.0f, 1.2f, true, -58);
+        pair(0x02, "Stage R", 3.0f, 45.5f, 12.0f, false, -71);
+        pair(0x03, "Bar", 1.0f, 120.0f, 0.0f, false, -90);
+        devices.setActiveIndex(0);
+    }
+
+    // One button press as the main loop passes it to the menu, then time for animations to end
+    enum Key { Up, Down, Hash, Star };
+    void press(Key k) {
+        menu.update(k == Up, k == Down, k == Hash, false, k == Star, false, false);
+        FakeArduino::advanceMs(300);
+    }
+
+    // From the main screen: open the menu, walk down to the item and select it
+    void open(const char* item) {
+        menu.enterMenu();
+        FakeArduino::advanceMs(300);
+        for (int i = 0; i < menu.getItemCount() && strcmp(menu.getCurrentMenuName(), item) != 0; ++i) press(Down);
+        TEST_ASSERT_EQUAL_STRING(item, menu.getCurrentMenuName());
+        press(Hash);
+    }
+
+    // Draws one frame now, as the loop would once the screen is due
+    void render() {
+        FakeArduino::advanceMs(50);
+        display.invalidate();
+        display.render(devices, battery, menu, buttons);
+    }
+};
+
+struct Screen {
+    const char* name;
+    Mode mode;
+    bool inMenu;
+    void (*setup)(Remote&);
+};
+
+// Timers report status right before the frame, so elapsed counters and stale marks are stable
+void freshStatus(Remote& r) {
+    for (int i = 0; i < r.devices.getDeviceCount(); ++i) r.devices.live(i)->lastStatusMs = millis() + 50;
+}
+
+const Screen SCREENS[] = {
+    {"main", Mode::ROOT, false, [](Remote& r) { r.pairFleet(); }},
+    {"main_unpaired", Mode::ROOT, false, [](Remote&) {}},
+    {"menu", Mode::ROOT, true, [](Remote& r) {
+        r.menu.enterMenu();
+        for (int i = 0; i < 6; ++i) r.press(Remote::Down);
+    }},
+    {"edit_blanking", Mode::EDIT_BLANKING, true, [](Remote& r) { r.open("Auto Off"); r.press(Remote::Up); }},
+    {"edit_txpower", Mode::EDIT_TXPOWER, true, [](Remote& r) { r.open("WiFi TX Power"); r.press(Remote::Down); }},
+    {"edit_brightness", Mode::EDIT_BRIGHTNESS, true, [](Remote& r) { r.open("OLED Brightness"); r.press(Remote::Down); }},
+    {"pairing", Mode::PAIRING, true, [](Remote& r) {
+        r.pair(0x02, "Stage R", 3.0f, 45.5f, 0.0f, false, -71);
+        FakeComm::discovered = {
+            {{0x24, 0x6F, 0x28, 0x10, 0x20, 0x02}, "Stage R", -60, 3.0f, 45.5f, 0, 1},
+            {{0x24, 0x6F, 0x28, 0x10, 0x20, 0x07}, "Lobby", -75, 1.0f, 10.0f, 0, 1},
+            {{0x24, 0x6F, 0x28, 0x10, 0x20, 0x09}, "", -82, 1.0f, 10.0f, 0, 1},
+        };
+        r.open("Pair Timer");
+        r.press(Remote::Down);
+    }},
+    {"manage_devices", Mode::MANAGE_DEVICES, true, [](Remote& r) {
+        r.pairFleet();
+        r.menu.enterManageDevices();
+        r.menu.setManageSelection(1);
+    }},
+    {"rename_device", Mode::RENAME_DEVICE, true, [](Remote& r) {
+        r.pairFleet();
+        r.menu.enterMenu();
+        r.menu.enterRename();
+        r.menu.renameInEdit = true;
+        strcpy(r.menu.renameBuf, "Stage L");
+        r.menu.renamePos = 2;
+    }},
+    {"select_active", Mode::SELECT_ACTIVE, true, [](Remote& r) { r.pairFleet(); r.open("Active Timer"); r.press(Remote::Down); }},
+    {"show_rssi", Mode::SHOW_RSSI, true, [](Remote& r) { r.pairFleet(); r.open("Show RSSI"); }},
+    {"battery_calib", Mode::BATTERY_CALIB, true, [](Remote& r) {
+        r.menu.initBatteryCal(1900, 2600, 3200);
+        r.open("Battery Calibration");
+        r.press(Remote::Hash); // start
+        r.press(Remote::Hash); // on to the 50 % point
+        r.press(Remote::Up);
+    }},
+    {"edit_rssi_calib", Mode::EDIT_RSSI_CALIB, true, [](Remote& r) { r.pairFleet(); r.open("RSSI Calibration"); }},
+    {"edit_timers", Mode::EDIT_TIMERS, true, [](Remote& r) { r.pairFleet(); r.open("Edit Timers"); r.press(Remote::Hash); r.press(Remote::Up); }},
+    {"edit_name", Mode::EDIT_NAME, true, [](Remote& r) { r.pairFleet(); r.open("Rename Device"); r.press(Remote::Hash); }},
+    {"confirm", Mode::CONFIRM, true, [](Remote& r) { r.open("Reset Timer"); }},
+    {"channel_settings", Mode::CHANNEL_SETTINGS, true, [](Remote& r) {
+        r.open("Channel Settings");
+        r.menu.setChannelScanResult({{1, 6, 420}, {6, 3, 230}, {11, 9, 610}, {3, 0, 0}, {13, 1, 88}}, 11);
+    }},
+    {"dashboard", Mode::DASHBOARD, true, [](Remote& r) { r.pairFleet(); r.open("Dashboard"); }},
+};
+
+std::string goldenDir() {
+    std::string dir = __FILE__;
+    const size_t slash = dir.find_last_of("/\\");
+    dir = slash == std::string::npos ? std::string(".") : dir.substr(0, slash);
+    return dir + "/golden/";
+}
+
+// Plain PBM (P1), one text row per pixel row
+std::string toPbm(const FakePanel& panel, const char* name) {
+    std::string out = "P1\n# test_remote_ui ";
+    out += name;
+    out += "\n128 64\n";
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) out += panel.pixel(x, y) ? '1' : '0';
+        out += '\n';
+    }
+    return out;
+}
+
+bool readPbm(const std::string& path, std::vector<bool>& bits) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream text;
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line[0] == '#') continue;
+        text << line << '\n';
+    }
+    std::string magic;
+    int w = 0, h = 0;
+    text >> magic >> w >> h;
+    if (magic != "P1" || w != W || h != H) return false;
+    bits.clear();
+    for (char c; bits.size() < (size_t)(W * H) && text.get(c);) {
+        if (c == '0' || c == '1') bits.push_back(c == '1');
+    }
+    return bits.size() == (size_t)(W * H);
+}
+
+bool writeFile(const std::string& path, const std::string& data) {
+    std::ofstream out(path, std::ios::binary);
+    out << data;
+    return (bool)out;
+}
+
+// Gets the remote to the screen from the menu list, so the counts cover one screen change
+void showScreen(Remote& r, const Screen& s) {
+    r.menu.enterMenu();
+    r.render();
+    r.menu.exitMenu();
+    FakeArduino::advanceMs(300);
+    Wire.panel.clearCounts();
+    s.setup(r);
+    freshStatus(r);
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+// Each MenuSystem::Mode has a screen here, and the keys in its setup really lead to it
+void test_every_mode_has_a_screen() {
+    bool covered[(int)Mode::DASHBOARD + 1] = {};
+    for (const Screen& s : SCREENS) {
+        Remote r;
+        showScreen(r, s);
+        TEST_ASSERT_EQUAL_MESSAGE((int)s.mode, (int)r.menu.getMode(), s.name);
+        TEST_ASSERT_EQUAL_MESSAGE(s.inMenu, r.menu.isInMenu(), s.name);
+        covered[(int)s.mode] = true;
+    }
+    for (int m = 0; m <= (int)Mode::DASHBOARD; ++m) {
+        char msg[32];
+        snprintf(msg, sizeof(msg), "no screen for mode %d", m);
+        TEST_ASSERT_TRUE_MESSAGE(covered[m], msg);
+    }
+}
+
+void test_screens_match_golden() {
+    const bool update = getenv("UPDATE_GOLDENS") != nullptr;
+    const std::string dir = goldenDir();
+    std::string failed;
+    for (const Screen& s : SCREENS) {
+        Remote r;
+        showScreen(r, s);
+        r.render();
+        const std::string path = dir + s.name + ".pbm";
+        const std::string actual = toPbm(Wire.panel, s.name);
+        if (update) {
+            TEST_ASSERT_TRUE_MESSAGE(writeFile(path, actual), path.c_str());
+            continue;
+        }
+        std::vector<bool> want;
+        bool same = readPbm(path, want);
+        for (int i = 0; same && i < W * H; ++i) same = want[i] == Wire.panel.pixel(i % W, i / W);
+        if (!same) {
+            // Every mismatch is written out before failing, for review or to accept as golden
+            writeFile(dir + s.name + ".actual.pbm", actual);
+            printf("  %s differs from %s (see %s.actual.pbm)\n", s.name, path.c_str(), s.name);
+            failed += failed.empty() ? s.name : std::string(", ") + s.name;
+        }
+    }
+    TEST_ASSERT_TRUE_MESSAGE(failed.empty(), failed.c_str());
+}
+
+// A frame that draws the same pixels as the last one puts nothing on the bus
+void test_unchanged_frame_sends_nothing() {
+    Remote r;
+    showScreen(r, SCREENS[0]);
+    r.render();
+    Wire.panel.clearCounts();
+    r.devices.live(0)->outputState = false; // stop the TIME row counting
+    r.devices.live(0)->elapsed = 30.0f;
+    r.render();
+    Wire.panel.clearCounts();
+    r.render();
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.panel.dataBytes);
+}
+
+// Auto Off blanks the panel after the applied timeout, and a key press brings it back
+void test_auto_off_blanks_and_wakes() {
+    Remote r;
+    r.menu.setAppliedBlankingSeconds(15);
+    r.render();
+    TEST_ASSERT_TRUE(Wire.panel.on);
+    FakeArduino::advanceMs(16000);
+    r.render();
+    TEST_ASSERT_FALSE(Wire.panel.on);
+    FakeArduino::pinLevel[BUTTON_STAR_GPIO] = LOW;
+    for (int i = 0; i < 10; ++i) {
+        r.buttons.update();
+        FakeArduino::advanceMs(5);
+    }
+    r.render();
+    TEST_ASSERT_TRUE(Wire.panel.on);
+}
+
+// Not a pass/fail check: per screen, the draw calls it makes, the pixels they touch, the I2C
+// payload of switching to it from the menu list, and the host time of a frame (draw + flush)
+void test_cost_report() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ROUNDS = 200;
+    TEST_MESSAGE("screen            prims  fill  line  rect  tri  chars  pixels  i2c B   ns/frame");
+    for (const Screen& s : SCREENS) {
+        Remote r;
+        showScreen(r, s);
+        gfxCounts = GfxCounts{};
+        r.render();
+        const GfxCounts frame = gfxCounts;
+        const uint32_t i2c = Wire.panel.busBytes;
+        const Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < ROUNDS; ++i) {
+            FakeArduino::advanceMs(20);
+            r.display.invalidate();
+            r.display.render(r.devices, r.battery, r.menu, r.buttons);
+        }
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%-16s %6lu %5lu %5lu %5lu %4lu %6lu %7lu %6lu %10lld", s.name,
+                 (unsigned long)frame.primitives(), (unsigned long)frame.fillRect, (unsigned long)frame.drawLine,
+                 (unsigned long)frame.drawRect, (unsigned long)frame.drawTriangle, (unsigned long)frame.chars,
+                 (unsigned long)frame.pixelWrites, (unsigned long)i2c, ns / ROUNDS);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_mode_has_a_screen);
+    RUN_TEST(test_screens_match_golden);
+    RUN_TEST(test_unchanged_frame_sends_nothing);
+    RUN_TEST(test_auto_off_blanks_and_wakes);
+    RUN_TEST(test_cost_report);
+    return UNITY_END();
+}